@@ -0,0 +1,124 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "allocation_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+	std::atomic<uint64_t> g_allocations{ 0 };
+
+	std::atomic<uint64_t> g_bytes{ 0 };
+
+	thread_local bool t_ignored = false;
+
+	void* allocate(size_t size)
+	{
+		if (!t_ignored) {
+			g_allocations.fetch_add(1, std::memory_order_relaxed);
+			g_bytes.fetch_add(size, std::memory_order_relaxed);
+		}
+		void* p = std::malloc(size > 0 ? size : 1);
+		if (!p) {
+			// built without exceptions, there is no std::bad_alloc to throw
+			std::abort();
+		}
+		return p;
+	}
+
+	void* allocate(size_t size, const std::nothrow_t&) noexcept
+	{
+		if (!t_ignored) {
+			g_allocations.fetch_add(1, std::memory_order_relaxed);
+			g_bytes.fetch_add(size, std::memory_order_relaxed);
+		}
+		return std::malloc(size > 0 ? size : 1);
+	}
+}
+
+void* operator new(size_t size)
+{
+	return allocate(size);
+}
+
+void* operator new[](size_t size)
+{
+	return allocate(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t& tag) noexcept
+{
+	return allocate(size, tag);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept
+{
+	return allocate(size, tag);
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+	std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+	std::free(p);
+}
+
+namespace vi {
+	uint64_t AllocationCounter::allocations()
+	{
+		return g_allocations.load(std::memory_order_relaxed);
+	}
+
+	uint64_t AllocationCounter::bytes()
+	{
+		return g_bytes.load(std::memory_order_relaxed);
+	}
+
+	void AllocationCounter::ignoreCurrentThread()
+	{
+		t_ignored = true;
+	}
+
+	AllocationScope::AllocationScope()
+		: _allocations(AllocationCounter::allocations())
+		, _bytes(AllocationCounter::bytes())
+	{
+	}
+
+	uint64_t AllocationScope::allocations() const
+	{
+		return AllocationCounter::allocations() - _allocations;
+	}
+
+	uint64_t AllocationScope::bytes() const
+	{
+		return AllocationCounter::bytes() - _bytes;
+	}
+}
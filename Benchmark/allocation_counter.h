@@ -0,0 +1,40 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace vi {
+	// Counts the calls to the global operator new of the process, replaced in allocation_counter.cpp.
+	// Threads that only drive the benchmark (the fake Janus server) opt out, so that the numbers are
+	// the allocations of the client alone.
+	class AllocationCounter {
+	public:
+		static uint64_t allocations();
+
+		static uint64_t bytes();
+
+		// Allocations of the calling thread are not counted from now on
+		static void ignoreCurrentThread();
+	};
+
+	// Allocations made between construction and the calls to allocations()/bytes()
+	class AllocationScope {
+	public:
+		AllocationScope();
+
+		uint64_t allocations() const;
+
+		uint64_t bytes() const;
+
+	private:
+		const uint64_t _allocations;
+
+		const uint64_t _bytes;
+	};
+}
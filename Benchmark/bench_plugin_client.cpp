@@ -0,0 +1,87 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "bench_plugin_client.h"
+#include "janus_message.h"
+#include "message_models.h"
+
+namespace vi {
+	BenchPluginClient::BenchPluginClient(std::shared_ptr<SignalingClientInterface> sc, std::shared_ptr<std::atomic<uint64_t>> events)
+		: PluginClient(sc, nullptr)
+		, _events(events)
+	{
+		_pluginContext->plugin = "janus.plugin.videoroom";
+		_pluginContext->opaqueId = "videoroom-benchmark";
+	}
+
+	bool BenchPluginClient::answered() const
+	{
+		return _answered.load(std::memory_order_acquire);
+	}
+
+	bool BenchPluginClient::attached() const
+	{
+		return _attached.load(std::memory_order_acquire);
+	}
+
+	void BenchPluginClient::onAttached(bool success)
+	{
+		_attached.store(success, std::memory_order_release);
+		_answered.store(true, std::memory_order_release);
+	}
+
+	void BenchPluginClient::onMediaStatus(const std::string& media, bool on, const std::string& mid)
+	{
+		count();
+	}
+
+	void BenchPluginClient::onWebrtcStatus(bool isActive, const std::string& desc)
+	{
+		count();
+	}
+
+	void BenchPluginClient::onSlowLink(bool uplink, bool lost, const std::string& mid)
+	{
+		count();
+	}
+
+	void BenchPluginClient::onMessage(std::shared_ptr<JanusMessage> message, std::shared_ptr<Jsep> jsep)
+	{
+		count();
+	}
+
+	void BenchPluginClient::onTimeout()
+	{
+		count();
+	}
+
+	void BenchPluginClient::onError(const std::string& desc)
+	{
+		count();
+	}
+
+	void BenchPluginClient::onHangup()
+	{
+	}
+
+	void BenchPluginClient::onDetached()
+	{
+		count();
+	}
+
+	void BenchPluginClient::onTrickle(std::shared_ptr<JanusMessage> message)
+	{
+		// decoded as PluginClient does, but there is no peer connection to add the candidate to
+		std::string err;
+		std::shared_ptr<TrickleResponse> model = message->to<TrickleResponse>(err);
+		count();
+	}
+
+	void BenchPluginClient::count()
+	{
+		_events->fetch_add(1, std::memory_order_release);
+	}
+}
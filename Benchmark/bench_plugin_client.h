@@ -0,0 +1,57 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include "plugin_client.h"
+
+namespace vi {
+	// A handle that takes every event without acting on it, so that the benchmarks measure the way there.
+	// Each routed event bumps |events| once, a hangup counts through its onWebrtcStatus(false).
+	class BenchPluginClient : public PluginClient {
+	public:
+		BenchPluginClient(std::shared_ptr<SignalingClientInterface> sc, std::shared_ptr<std::atomic<uint64_t>> events);
+
+		// Janus answered the attach, successfully or not
+		bool answered() const;
+
+		bool attached() const;
+
+	protected:
+		void onAttached(bool success) override;
+
+		void onMediaStatus(const std::string& media, bool on, const std::string& mid) override;
+
+		void onWebrtcStatus(bool isActive, const std::string& desc) override;
+
+		void onSlowLink(bool uplink, bool lost, const std::string& mid) override;
+
+		void onMessage(std::shared_ptr<JanusMessage> message, std::shared_ptr<Jsep> jsep) override;
+
+		void onTimeout() override;
+
+		void onError(const std::string& desc) override;
+
+		void onHangup() override;
+
+		void onDetached() override;
+
+	public:
+		void onTrickle(std::shared_ptr<JanusMessage> message) override;
+
+	private:
+		void count();
+
+	private:
+		std::shared_ptr<std::atomic<uint64_t>> _events;
+
+		std::atomic<bool> _answered{ false };
+
+		std::atomic<bool> _attached{ false };
+	};
+}
@@ -0,0 +1,145 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "benchmark.h"
+#include "bench_plugin_client.h"
+#include "signaling_client_interface.h"
+#include "service/rtc_engine.h"
+#include "logger/logger.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+
+namespace {
+	// the main thread handles the engine observers, it is serviced in slices of this
+	constexpr int kPumpIntervalMs = 1;
+}
+
+namespace vi {
+	BenchmarkContext::BenchmarkContext(const BenchmarkOptions& options)
+		: _options(options)
+		, _events(std::make_shared<std::atomic<uint64_t>>(0))
+	{
+	}
+
+	BenchmarkContext::~BenchmarkContext()
+	{
+		tearDown();
+	}
+
+	bool BenchmarkContext::setUp()
+	{
+		if (!_options.trafficPath.empty() && !_traffic.load(_options.trafficPath)) {
+			ELOG("> Can not load the traffic of {}", _options.trafficPath);
+			return false;
+		}
+
+		const std::string url = _server.start();
+		if (url.empty()) {
+			ELOG("> The fake Janus did not start");
+			return false;
+		}
+
+		_sc = uFactory->getSignalingClient();
+		_sc->connect(url);
+
+		auto sc = _sc;
+		if (!waitFor([sc]() { return sc->sessionStatus() == SessionStatus::CONNECTED; }, _options.timeoutMs)) {
+			ELOG("> No session on {}", url);
+			return false;
+		}
+		return true;
+	}
+
+	void BenchmarkContext::tearDown()
+	{
+		if (_sc) {
+			_sc->cleanup();
+			auto& server = _server;
+			waitFor([&server]() { return server.requests("destroy") > 0; }, _options.timeoutMs);
+			_sc = nullptr;
+		}
+		_clients.clear();
+		_server.stop();
+	}
+
+	bool BenchmarkContext::ensureHandles(size_t count)
+	{
+		while (_clients.size() < count) {
+			auto client = std::make_shared<BenchPluginClient>(_sc, _events);
+			client->init();
+			client->attach();
+			if (!waitFor([client]() { return client->answered(); }, _options.timeoutMs) || !client->attached()) {
+				ELOG("> Attaching handle {} failed", _clients.size());
+				return false;
+			}
+			_clients.emplace_back(client);
+		}
+		return true;
+	}
+
+	std::vector<int64_t> BenchmarkContext::handleIds(size_t count) const
+	{
+		std::vector<int64_t> ids;
+		for (size_t i = 0; i < count && i < _clients.size(); ++i) {
+			ids.emplace_back(_clients[i]->pluginContext()->handleId);
+		}
+		return ids;
+	}
+
+	void BenchmarkContext::forgetHandles()
+	{
+		_clients.clear();
+	}
+
+	bool waitFor(const std::function<bool()>& done, int64_t timeoutMs)
+	{
+		const int64_t deadline = rtc::TimeMillis() + timeoutMs;
+		rtc::Thread* current = rtc::Thread::Current();
+		while (!done()) {
+			if (rtc::TimeMillis() > deadline) {
+				return false;
+			}
+			if (current) {
+				current->ProcessMessages(kPumpIntervalMs);
+			}
+			else {
+				rtc::Thread::SleepMs(kPumpIntervalMs);
+			}
+		}
+		return true;
+	}
+
+	std::vector<DispatchStats> dispatchDelta(const std::vector<DispatchStats>& before, const std::vector<DispatchStats>& after)
+	{
+		std::vector<DispatchStats> delta = after;
+		for (auto& stats : delta) {
+			for (const auto& earlier : before) {
+				if (earlier.type != stats.type) {
+					continue;
+				}
+				stats.dispatched -= earlier.dispatched;
+				stats.dropped -= earlier.dropped;
+				for (size_t i = 0; i < DispatchStats::kBuckets; ++i) {
+					stats.buckets[i] -= earlier.buckets[i];
+				}
+			}
+		}
+		return delta;
+	}
+
+	DispatchStats mergeDispatchStats(const std::vector<DispatchStats>& stats)
+	{
+		DispatchStats merged;
+		for (const auto& s : stats) {
+			merged.dispatched += s.dispatched;
+			merged.dropped += s.dropped;
+			for (size_t i = 0; i < DispatchStats::kBuckets; ++i) {
+				merged.buckets[i] += s.buckets[i];
+			}
+		}
+		return merged;
+	}
+}
@@ -0,0 +1,146 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <stdint.h>
+#include "dispatch_stats.h"
+#include "fake_janus_server.h"
+#include "janus_traffic.h"
+
+namespace vi {
+	class SignalingClientInterface;
+	class BenchPluginClient;
+
+	struct BenchmarkOptions {
+		// plugin handles the events are spread over
+		size_t handles = 50;
+
+		// times the recording is replayed to every handle
+		size_t rounds = 200;
+
+		// frames to replay instead of the built-in recording, see JanusTraffic::load()
+		std::string trafficPath;
+
+		// runs the scenarios whose name contains it, all of them when empty
+		std::string filter;
+
+		bool verbose = false;
+
+		// a scenario fails above this many allocations per event (per request when sending), no budget when
+		// negative, the send-path scenario then applies a default one
+		double maxAllocationsPerEvent = -1;
+
+		int64_t timeoutMs = 30000;
+	};
+
+	// What the scenarios share: one fake Janus, and the signaling client of the engine connected to it.
+	// The engine is a singleton, so is the session: it is set up once for the whole run.
+	class BenchmarkContext {
+	public:
+		explicit BenchmarkContext(const BenchmarkOptions& options);
+
+		~BenchmarkContext();
+
+		// Starts the fake Janus and waits for the session to be created on it
+		bool setUp();
+
+		// Destroys the session and stops the fake Janus
+		void tearDown();
+
+		// Attaches handles until |count| of them are attached
+		bool ensureHandles(size_t count);
+
+		// The ids Janus gave to the first |count| handles
+		std::vector<int64_t> handleIds(size_t count) const;
+
+		// The session was replaced and its handles went with it, ensureHandles() attaches new ones
+		void forgetHandles();
+
+		const BenchmarkOptions& options() const { return _options; }
+
+		FakeJanusServer& server() { return _server; }
+
+		const JanusTraffic& traffic() const { return _traffic; }
+
+		std::shared_ptr<SignalingClientInterface> signalingClient() const { return _sc; }
+
+		// events routed to the handles so far, bumped on the plugin-client thread
+		uint64_t events() const { return _events->load(std::memory_order_acquire); }
+
+	private:
+		const BenchmarkOptions& _options;
+
+		FakeJanusServer _server;
+
+		JanusTraffic _traffic;
+
+		std::shared_ptr<SignalingClientInterface> _sc;
+
+		std::shared_ptr<std::atomic<uint64_t>> _events;
+
+		std::vector<std::shared_ptr<BenchPluginClient>> _clients;
+	};
+
+	// Processes the messages of the calling thread until |done| returns true or |timeoutMs| passed
+	bool waitFor(const std::function<bool()>& done, int64_t timeoutMs);
+
+	// Per event type |after| - |before|, two snapshots of SignalingClientInterface::dispatchStats()
+	std::vector<DispatchStats> dispatchDelta(const std::vector<DispatchStats>& before, const std::vector<DispatchStats>& after);
+
+	// All event types in one histogram
+	DispatchStats mergeDispatchStats(const std::vector<DispatchStats>& stats);
+
+	struct BenchmarkScenario {
+		const char* name;
+
+		const char* description;
+
+		bool (*run)(BenchmarkContext& context);
+	};
+
+	// Replays the recording to the attached handles and reports the events per second, the receive-to-handler
+	// latency and the allocations per event of the client
+	bool runSignalingBenchmark(BenchmarkContext& context);
+
+	// Decodes videoroom list replies of growing size into the std::string models and into the views over
+	// the received message, and reports the time and the allocations per reply of both
+	bool runListDecodeBenchmark(BenchmarkContext& context);
+
+	// Fans events out to growing numbers of observers on the engine threads: posted after a lookup of the thread by
+	// name per delivery as it used to be, through UniversalObservable and through NotificationCenter, and reports the
+	// events/s of each
+	bool runFanOutBenchmark(BenchmarkContext& context);
+
+	// Schedules 10k one shot timers on the TimerService, cancels half of them and waits for the others, and reports
+	// the cost per timer, the cpu time of the process and its thread count. Fails when a cancelled timer fires or
+	// the timers start threads
+	bool runTimerBenchmark(BenchmarkContext& context);
+
+	// Makes transaction ids with the clock seeded randomString() they used to come from and with TransactionId,
+	// and reports the time, the allocations and the repeats in a burst of both. Fails when TransactionId allocates
+	// or repeats
+	bool runTransactionIdBenchmark(BenchmarkContext& context);
+
+	// Writes a videoroom configure with its offer and a trickle straight from their models, once into a reused
+	// payload and once through the signaling client to the fake Janus, and reports the time and the allocations
+	// per request of both. Fails when the write allocates, or the client goes over its budget
+	bool runSendPathBenchmark(BenchmarkContext& context);
+
+	// Opens, writes and closes many connections of one multi-threaded WebsocketEndpoint from several threads at
+	// once against the fake Janus, and checks that every write is answered and the connection table drains.
+	// Meant to be run under ThreadSanitizer as well.
+	bool runEndpointStressBenchmark(BenchmarkContext& context);
+
+	// Drops the connection under an attached session and reports the time until the session is usable again:
+	// claimed back with its handles, through a claim lost to a second drop, then recreated once Janus expired it
+	bool runReconnectBenchmark(BenchmarkContext& context);
+}
@@ -0,0 +1,172 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "endpoint_stress.h"
+#include <stdio.h>
+#include <inttypes.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <functional>
+#include "websocket/websocket_endpoint.h"
+#include "websocket/i_connection_listener.h"
+
+namespace {
+	// more loop threads than cores on most machines, so that connections move between them
+	constexpr size_t kIoThreads = 4;
+
+	constexpr size_t kWorkers = 8;
+
+	constexpr size_t kConnectionsPerWorker = 16;
+
+	// per worker and connection, every worker sends to every connection
+	constexpr size_t kMessages = 20;
+
+	const char* kSubprotocol = "janus-protocol";
+
+	const char* kKeepAlive = "{\"janus\":\"keepalive\",\"transaction\":\"stress\"}";
+
+	// Shared by all connections, called on the loop threads
+	class StressListener : public vi::IConnectionListener {
+	public:
+		void onOpen() override { ++opened; }
+
+		void onFail(int errorCode, const std::string& reason) override { ++failed; }
+
+		void onClose(int closeCode, const std::string& reason) override { ++closed; }
+
+		bool onValidate() override { return true; }
+
+		void onTextMessage(std::string&& text) override { ++messages; }
+
+		void onBinaryMessage(const std::vector<uint8_t>& data) override {}
+
+		bool onPing(const std::string& text) override { return true; }
+
+		void onPong(const std::string& text) override {}
+
+		void onPongTimeout(const std::string& text) override {}
+
+		std::atomic<uint64_t> opened{ 0 };
+
+		std::atomic<uint64_t> failed{ 0 };
+
+		std::atomic<uint64_t> closed{ 0 };
+
+		std::atomic<uint64_t> messages{ 0 };
+	};
+
+	int64_t nowUs()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// Polls |condition| until it holds or |timeoutMs| passed, the endpoint needs no thread of the caller to run
+	bool waitUntil(const std::function<bool()>& condition, int64_t timeoutMs)
+	{
+		const int64_t deadlineUs = nowUs() + timeoutMs * 1000;
+		while (!condition()) {
+			if (nowUs() >= deadlineUs) {
+				return false;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		return true;
+	}
+
+	// Runs |work| with the index of each worker on its own thread and waits for all of them
+	void runWorkers(const std::function<void(size_t worker)>& work)
+	{
+		std::vector<std::thread> workers;
+		for (size_t i = 0; i < kWorkers; ++i) {
+			workers.emplace_back(work, i);
+		}
+		for (auto& worker : workers) {
+			worker.join();
+		}
+	}
+}
+
+namespace vi {
+	bool runEndpointStress(const std::string& url, int64_t timeoutMs)
+	{
+		auto listener = std::make_shared<StressListener>();
+		WebsocketEndpoint endpoint(kIoThreads);
+
+		const int64_t startUs = nowUs();
+
+		// connections are added to the table from all workers at once
+		std::vector<std::vector<int>> ids(kWorkers);
+		runWorkers([&](size_t worker) {
+			for (size_t i = 0; i < kConnectionsPerWorker; ++i) {
+				const int id = endpoint.connect(url, listener, kSubprotocol);
+				if (id >= 0) {
+					ids[worker].emplace_back(id);
+				}
+			}
+		});
+
+		std::vector<int> all;
+		for (const auto& own : ids) {
+			all.insert(all.end(), own.begin(), own.end());
+		}
+		const uint64_t total = kWorkers * kConnectionsPerWorker;
+		const bool opened = waitUntil([&listener, total]() { return listener->opened + listener->failed >= total; }, timeoutMs);
+		if (!opened || all.size() != total || listener->failed > 0) {
+			printf("  %" PRIu64 " of %" PRIu64 " connections opened, %" PRIu64 " failed\n", listener->opened.load(), total, listener->failed.load());
+			return false;
+		}
+
+		// every connection is written from all workers at once, through both sendText() flavours and pings,
+		// the fake Janus acks each keepalive
+		runWorkers([&](size_t worker) {
+			for (size_t n = 0; n < kMessages; ++n) {
+				for (size_t i = 0; i < all.size(); ++i) {
+					const int id = all[(i + worker) % all.size()];
+					if ((n + worker) % 2 == 0) {
+						endpoint.sendText(id, kKeepAlive);
+					}
+					else {
+						endpoint.sendText(id, [](std::string& payload) {
+							payload.assign(kKeepAlive);
+						});
+					}
+					if (n == 0) {
+						endpoint.sendPing(id, "");
+					}
+				}
+			}
+		});
+
+		const uint64_t expected = total * kWorkers * kMessages;
+		const bool acked = waitUntil([&listener, expected]() { return listener->messages >= expected; }, timeoutMs);
+		if (!acked) {
+			printf("  %" PRIu64 " of %" PRIu64 " keepalives acked\n", listener->messages.load(), expected);
+			return false;
+		}
+
+		// closes from the workers race with the removals on the loop threads
+		runWorkers([&](size_t worker) {
+			for (int id : ids[worker]) {
+				endpoint.close(id, websocketpp::close::status::normal, "");
+			}
+		});
+
+		const bool drained = waitUntil([&listener, &endpoint, total]() {
+			return listener->closed >= total && endpoint.connections() == 0;
+		}, timeoutMs);
+		const int64_t elapsedUs = nowUs() - startUs;
+		if (!drained) {
+			printf("  %" PRIu64 " of %" PRIu64 " connections closed, %zu left in the table\n", listener->closed.load(), total, endpoint.connections());
+			return false;
+		}
+
+		printf("  %" PRIu64 " connections on %zu loop threads, %zu writers: %" PRIu64 " keepalives acked in %.3f s\n",
+			total, kIoThreads, kWorkers, expected, elapsedUs / 1e6);
+		return true;
+	}
+}
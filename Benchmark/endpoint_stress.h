@@ -0,0 +1,17 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <string>
+#include <stdint.h>
+
+namespace vi {
+	// Opens, writes and closes connections of one multi-threaded WebsocketEndpoint from several threads at once
+	// against the Janus at |url|, waiting at most |timeoutMs| per step. Needs nothing but the endpoint, so that
+	// it also builds on its own with -fsanitize=thread (see tsan/CMakeLists.txt).
+	bool runEndpointStress(const std::string& url, int64_t timeoutMs);
+}
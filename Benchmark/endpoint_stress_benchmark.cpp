@@ -0,0 +1,15 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "benchmark.h"
+#include "endpoint_stress.h"
+
+namespace vi {
+	bool runEndpointStressBenchmark(BenchmarkContext& context)
+	{
+		return runEndpointStress(context.server().url(), context.options().timeoutMs);
+	}
+}
@@ -0,0 +1,298 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "fake_janus_server.h"
+#include "rapidjson/document.h"
+#include "rapidjson/writer.h"
+#include "rapidjson/stringbuffer.h"
+#include "allocation_counter.h"
+#include "logger/logger.h"
+
+namespace {
+	// Janus hands out random 53 bit ids, any positive value will do here
+	constexpr int64_t kFirstId = 1000000;
+
+	const char* kSubprotocol = "janus-protocol";
+
+	int64_t int64Of(const rapidjson::Document& doc, const char* name)
+	{
+		auto it = doc.FindMember(name);
+		return it != doc.MemberEnd() && it->value.IsInt64() ? it->value.GetInt64() : 0;
+	}
+
+	std::string stringOf(const rapidjson::Document& doc, const char* name)
+	{
+		auto it = doc.FindMember(name);
+		return it != doc.MemberEnd() && it->value.IsString() ? std::string(it->value.GetString(), it->value.GetStringLength()) : std::string();
+	}
+
+	// {"janus": |janus|, "session_id": |sessionId|, "transaction": |transaction|, "data": {"id": |id|}}, zero ids are left out
+	std::string reply(const char* janus, const std::string& transaction, int64_t sessionId, int64_t id = 0)
+	{
+		rapidjson::StringBuffer buffer;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+		writer.StartObject();
+		writer.Key("janus");
+		writer.String(janus);
+		if (sessionId > 0) {
+			writer.Key("session_id");
+			writer.Int64(sessionId);
+		}
+		writer.Key("transaction");
+		writer.String(transaction.c_str(), static_cast<rapidjson::SizeType>(transaction.size()));
+		if (id > 0) {
+			writer.Key("data");
+			writer.StartObject();
+			writer.Key("id");
+			writer.Int64(id);
+			writer.EndObject();
+		}
+		writer.EndObject();
+		return std::string(buffer.GetString(), buffer.GetSize());
+	}
+
+	std::string errorReply(const std::string& transaction, int64_t sessionId, int code, const char* reason)
+	{
+		rapidjson::StringBuffer buffer;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+		writer.StartObject();
+		writer.Key("janus");
+		writer.String("error");
+		if (sessionId > 0) {
+			writer.Key("session_id");
+			writer.Int64(sessionId);
+		}
+		writer.Key("transaction");
+		writer.String(transaction.c_str(), static_cast<rapidjson::SizeType>(transaction.size()));
+		writer.Key("error");
+		writer.StartObject();
+		writer.Key("code");
+		writer.Int(code);
+		writer.Key("reason");
+		writer.String(reason);
+		writer.EndObject();
+		writer.EndObject();
+		return std::string(buffer.GetString(), buffer.GetSize());
+	}
+}
+
+namespace vi {
+	FakeJanusServer::FakeJanusServer()
+		: _nextId(kFirstId)
+	{
+		_server.clear_access_channels(websocketpp::log::alevel::all);
+		_server.clear_error_channels(websocketpp::log::elevel::all);
+
+		_server.init_asio();
+		_server.set_reuse_addr(true);
+
+		_server.set_validate_handler(websocketpp::lib::bind(&FakeJanusServer::onValidate, this, websocketpp::lib::placeholders::_1));
+		_server.set_open_handler(websocketpp::lib::bind(&FakeJanusServer::onOpen, this, websocketpp::lib::placeholders::_1));
+		_server.set_close_handler(websocketpp::lib::bind(&FakeJanusServer::onClose, this, websocketpp::lib::placeholders::_1));
+		_server.set_fail_handler(websocketpp::lib::bind(&FakeJanusServer::onClose, this, websocketpp::lib::placeholders::_1));
+		_server.set_message_handler(websocketpp::lib::bind(&FakeJanusServer::onMessage, this, websocketpp::lib::placeholders::_1, websocketpp::lib::placeholders::_2));
+	}
+
+	FakeJanusServer::~FakeJanusServer()
+	{
+		stop();
+	}
+
+	std::string FakeJanusServer::start()
+	{
+		websocketpp::lib::error_code ec;
+		_server.listen(websocketpp::lib::asio::ip::tcp::endpoint(websocketpp::lib::asio::ip::address_v4::loopback(), 0), ec);
+		if (ec) {
+			ELOG("fake janus: listen failed: {}", ec.message());
+			return "";
+		}
+
+		_server.start_accept(ec);
+		if (ec) {
+			ELOG("fake janus: accept failed: {}", ec.message());
+			return "";
+		}
+
+		websocketpp::lib::asio::error_code aec;
+		const auto local = _server.get_local_endpoint(aec);
+		if (aec) {
+			ELOG("fake janus: no local endpoint: {}", aec.message());
+			return "";
+		}
+
+		_thread = std::thread([this]() {
+			AllocationCounter::ignoreCurrentThread();
+			_server.run();
+		});
+
+		_url = "ws://127.0.0.1:" + std::to_string(local.port());
+		return _url;
+	}
+
+	void FakeJanusServer::stop()
+	{
+		if (!_thread.joinable()) {
+			return;
+		}
+
+		_server.get_io_service().post([this]() {
+			websocketpp::lib::error_code ec;
+			_server.stop_listening(ec);
+			for (const auto& hdl : _connections) {
+				_server.close(hdl, websocketpp::close::status::going_away, "server stopped", ec);
+			}
+		});
+
+		// run() returns once the closing handshakes are done
+		_thread.join();
+	}
+
+	void FakeJanusServer::replay(std::shared_ptr<const std::vector<std::string>> frames)
+	{
+		_server.get_io_service().post([this, frames]() {
+			for (const auto& hdl : _connections) {
+				for (const auto& frame : *frames) {
+					send(hdl, frame);
+				}
+			}
+		});
+	}
+
+	void FakeJanusServer::dropConnections(uint32_t claims)
+	{
+		_server.get_io_service().post([this, claims]() {
+			_claimsToDrop = claims;
+			websocketpp::lib::error_code ec;
+			for (const auto& hdl : _connections) {
+				_server.close(hdl, websocketpp::close::status::going_away, "connection dropped", ec);
+			}
+		});
+	}
+
+	void FakeJanusServer::expireSession()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_sessionId = 0;
+		_handles.clear();
+	}
+
+	int64_t FakeJanusServer::sessionId() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _sessionId;
+	}
+
+	std::vector<int64_t> FakeJanusServer::handles() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _handles;
+	}
+
+	uint64_t FakeJanusServer::requests(const std::string& janus) const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _requests.find(janus);
+		return it != _requests.end() ? it->second : 0;
+	}
+
+	bool FakeJanusServer::onValidate(websocketpp::connection_hdl hdl)
+	{
+		server::connection_ptr con = _server.get_con_from_hdl(hdl);
+		for (const auto& subprotocol : con->get_requested_subprotocols()) {
+			if (subprotocol == kSubprotocol) {
+				con->select_subprotocol(subprotocol);
+				return true;
+			}
+		}
+		// Janus turns down clients that do not ask for its protocol
+		return false;
+	}
+
+	void FakeJanusServer::onOpen(websocketpp::connection_hdl hdl)
+	{
+		_connections.insert(hdl);
+	}
+
+	void FakeJanusServer::onClose(websocketpp::connection_hdl hdl)
+	{
+		_connections.erase(hdl);
+	}
+
+	void FakeJanusServer::onMessage(websocketpp::connection_hdl hdl, server::message_ptr msg)
+	{
+		rapidjson::Document request;
+		const std::string& payload = msg->get_payload();
+		request.Parse(payload.c_str(), payload.size());
+		if (request.HasParseError() || !request.IsObject()) {
+			return;
+		}
+
+		const std::string janus = stringOf(request, "janus");
+		const std::string transaction = stringOf(request, "transaction");
+		const int64_t sessionId = int64Of(request, "session_id");
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			++_requests[janus];
+		}
+
+		if (janus == "create") {
+			const int64_t id = _nextId++;
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_sessionId = id;
+				_handles.clear();
+			}
+			send(hdl, reply("success", transaction, 0, id));
+		}
+		else if (janus == "claim") {
+			if (_claimsToDrop > 0) {
+				--_claimsToDrop;
+				websocketpp::lib::error_code ec;
+				_server.close(hdl, websocketpp::close::status::going_away, "connection dropped", ec);
+				return;
+			}
+			bool known = false;
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				known = sessionId > 0 && sessionId == _sessionId;
+			}
+			if (known) {
+				send(hdl, reply("success", transaction, sessionId));
+			}
+			else {
+				send(hdl, errorReply(transaction, sessionId, 458, "No such session"));
+			}
+		}
+		else if (janus == "attach") {
+			const int64_t id = _nextId++;
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_handles.emplace_back(id);
+			}
+			send(hdl, reply("success", transaction, sessionId, id));
+		}
+		else if (janus == "keepalive" || janus == "message" || janus == "trickle") {
+			// plugins answer messages asynchronously, with an event replayed separately
+			send(hdl, reply("ack", transaction, sessionId));
+		}
+		else if (janus == "hangup" || janus == "detach" || janus == "destroy") {
+			send(hdl, reply("success", transaction, sessionId));
+		}
+		else {
+			send(hdl, errorReply(transaction, sessionId, 453, "Unknown request"));
+		}
+	}
+
+	void FakeJanusServer::send(websocketpp::connection_hdl hdl, const std::string& payload)
+	{
+		websocketpp::lib::error_code ec;
+		_server.send(hdl, payload, websocketpp::frame::opcode::text, ec);
+		if (ec) {
+			ELOG("fake janus: send failed: {}", ec.message());
+		}
+	}
+}
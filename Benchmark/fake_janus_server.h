@@ -0,0 +1,97 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <websocketpp/config/asio_no_tls.hpp>
+#include <websocketpp/server.hpp>
+#include <map>
+#include <set>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+namespace vi {
+	// An in-process Janus speaking the websocket api ("janus-protocol") on 127.0.0.1. It answers the core
+	// requests the way Janus does (create, claim, attach, keepalive, message, trickle, hangup, detach, destroy) and
+	// replays recorded events to its clients. Requests and replays are served on the io thread of the server,
+	// which is left out of the allocation counts.
+	class FakeJanusServer {
+	public:
+		using server = websocketpp::server<websocketpp::config::asio>;
+
+		FakeJanusServer();
+
+		~FakeJanusServer();
+
+		// Listens on a free port of 127.0.0.1, the url to connect to or an empty string on failure
+		std::string start();
+
+		void stop();
+
+		// The url start() returned
+		const std::string& url() const { return _url; }
+
+		// Sends |frames| in order to every open connection
+		void replay(std::shared_ptr<const std::vector<std::string>> frames);
+
+		// Closes every open connection, the session stays. The next |claims| claims close their connection
+		// instead of being answered, as if it dropped again before the reply.
+		void dropConnections(uint32_t claims = 0);
+
+		// Forgets the session and its handles, as Janus does once a session timed out: claiming it fails with 458
+		void expireSession();
+
+		// The session of the last "create", 0 before
+		int64_t sessionId() const;
+
+		// Handles attached to the current session, in attach order
+		std::vector<int64_t> handles() const;
+
+		// Requests received so far with this "janus" type
+		uint64_t requests(const std::string& janus) const;
+
+	private:
+		bool onValidate(websocketpp::connection_hdl hdl);
+
+		void onOpen(websocketpp::connection_hdl hdl);
+
+		void onClose(websocketpp::connection_hdl hdl);
+
+		void onMessage(websocketpp::connection_hdl hdl, server::message_ptr msg);
+
+		void send(websocketpp::connection_hdl hdl, const std::string& payload);
+
+		FakeJanusServer(const FakeJanusServer&) = delete;
+
+		FakeJanusServer& operator=(const FakeJanusServer&) = delete;
+
+	private:
+		server _server;
+
+		std::thread _thread;
+
+		std::string _url;
+
+		// io thread only
+		std::set<websocketpp::connection_hdl, std::owner_less<websocketpp::connection_hdl>> _connections;
+
+		int64_t _nextId = 0;
+
+		uint32_t _claimsToDrop = 0;
+
+		mutable std::mutex _mutex;
+
+		int64_t _sessionId = 0;
+
+		std::vector<int64_t> _handles;
+
+		std::map<std::string, uint64_t> _requests;
+	};
+}
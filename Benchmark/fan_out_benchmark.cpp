@@ -0,0 +1,140 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "benchmark.h"
+#include <stdio.h>
+#include <algorithm>
+#include "utils/universal_observable.hpp"
+#include "utils/notification_center.hpp"
+#include "utils/i_notification.h"
+#include "utils/observer.hpp"
+#include "utils/thread_provider.h"
+#include "rtc_base/time_utils.h"
+
+namespace {
+	// observers per run, spread over the threads below
+	const size_t kObservers[] = { 1, 16, 128 };
+
+	// deliveries per run, the events are as many as it takes to reach them with the observers of the run
+	constexpr size_t kDeliveries = 200000;
+
+	// threads of the engine with nothing to do while the benchmark runs
+	const char* kThreads[] = { "plugin-client", "stats-collector", "capture-session" };
+
+	constexpr size_t kThreadCount = sizeof(kThreads) / sizeof(kThreads[0]);
+
+	class FanOutNotification : public vi::INotification {};
+
+	class IFanOutObserver {
+	public:
+		virtual ~IFanOutObserver() {}
+
+		virtual void onEvent() = 0;
+	};
+
+	class FanOutObserver : public IFanOutObserver {
+	public:
+		explicit FanOutObserver(std::shared_ptr<std::atomic<uint64_t>> delivered) : _delivered(std::move(delivered)) {}
+
+		void onEvent() override { ++*_delivered; }
+
+		void onNotification(const std::shared_ptr<FanOutNotification>& notification) { ++*_delivered; }
+
+	private:
+		std::shared_ptr<std::atomic<uint64_t>> _delivered;
+	};
+
+	class FanOutObservable : public vi::UniversalObservable<IFanOutObserver> {
+	public:
+		void publish() {
+			notifyObservers([](const auto& observer) {
+				observer->onEvent();
+			});
+		}
+	};
+
+	struct FanOutResult {
+		bool ok = true;
+
+		double eventsPerSecond = 0;
+
+		double deliveriesPerSecond = 0;
+	};
+
+	// Calls |publish| |events| times and waits for every observer to get every event
+	FanOutResult measure(vi::BenchmarkContext& context, size_t events, size_t observers,
+		const std::shared_ptr<std::atomic<uint64_t>>& delivered, const std::function<void()>& publish)
+	{
+		FanOutResult result;
+		const uint64_t expected = delivered->load() + events * observers;
+		const int64_t startUs = rtc::TimeMicros();
+		for (size_t i = 0; i < events; ++i) {
+			publish();
+		}
+		result.ok = vi::waitFor([delivered, expected]() { return delivered->load() >= expected; }, context.options().timeoutMs);
+		const double seconds = (rtc::TimeMicros() - startUs) / 1e6;
+		result.eventsPerSecond = events / seconds;
+		result.deliveriesPerSecond = events * observers / seconds;
+		return result;
+	}
+
+	bool print(const char* name, const FanOutResult& result)
+	{
+		if (!result.ok) {
+			printf("    %-20s timed out\n", name);
+			return false;
+		}
+		printf("    %-20s %10.0f events/s, %10.0f deliveries/s\n", name, result.eventsPerSecond, result.deliveriesPerSecond);
+		return true;
+	}
+}
+
+namespace vi {
+	bool runFanOutBenchmark(BenchmarkContext& context)
+	{
+		bool ok = true;
+		for (size_t count : kObservers) {
+			const size_t events = std::max<size_t>(kDeliveries / count, 1);
+			auto delivered = std::make_shared<std::atomic<uint64_t>>(0);
+			std::vector<std::shared_ptr<FanOutObserver>> observers;
+			FanOutObservable observable;
+			auto center = std::make_shared<NotificationCenter>();
+			for (size_t i = 0; i < count; ++i) {
+				auto observer = std::make_shared<FanOutObserver>(delivered);
+				observable.addWeakObserver(observer, std::string(kThreads[i % kThreadCount]));
+				center->addObserver(Observer<FanOutObserver, FanOutNotification>(observer, &FanOutObserver::onNotification, std::string(kThreads[i % kThreadCount])));
+				observers.emplace_back(observer);
+			}
+			printf("  %zu observer(s) on %zu threads, %zu events\n", count, std::min(count, kThreadCount), events);
+
+			// the way every event went before the threads were resolved once: a lookup by name per delivery
+			const auto byName = measure(context, events, count, delivered, [&observers]() {
+				for (size_t i = 0; i < observers.size(); ++i) {
+					if (rtc::Thread* thread = TMgr->thread(std::string(kThreads[i % kThreadCount]))) {
+						thread->PostTask(RTC_FROM_HERE, [wobs = std::weak_ptr<FanOutObserver>(observers[i])]() {
+							if (auto observer = wobs.lock()) {
+								observer->onEvent();
+							}
+						});
+					}
+				}
+			});
+			ok = print("thread by name:", byName) && ok;
+
+			const auto universal = measure(context, events, count, delivered, [&observable]() {
+				observable.publish();
+			});
+			ok = print("UniversalObservable:", universal) && ok;
+
+			auto notification = std::make_shared<FanOutNotification>();
+			const auto notified = measure(context, events, count, delivered, [&center, &notification]() {
+				center->postNotification(notification);
+			});
+			ok = print("NotificationCenter:", notified) && ok;
+		}
+		return ok;
+	}
+}
@@ -0,0 +1,90 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "janus_traffic.h"
+#include <fstream>
+
+namespace {
+	const char* kRecording[] = {
+		R"({"janus":"trickle","session_id":$SESSION,"sender":$HANDLE,"candidate":{"sdpMid":"0","sdpMLineIndex":0,"candidate":"candidate:1 1 udp 2013266431 192.168.1.10 45678 typ host"}})",
+		R"({"janus":"trickle","session_id":$SESSION,"sender":$HANDLE,"candidate":{"sdpMid":"0","sdpMLineIndex":0,"candidate":"candidate:2 1 udp 1677729535 203.0.113.7 45678 typ srflx raddr 192.168.1.10 rport 45678"}})",
+		R"({"janus":"trickle","session_id":$SESSION,"sender":$HANDLE,"candidate":{"completed":true}})",
+		R"({"janus":"webrtcup","session_id":$SESSION,"sender":$HANDLE})",
+		R"({"janus":"media","session_id":$SESSION,"sender":$HANDLE,"mid":"0","type":"audio","receiving":true})",
+		R"({"janus":"media","session_id":$SESSION,"sender":$HANDLE,"mid":"1","type":"video","receiving":true})",
+		R"({"janus":"slowlink","session_id":$SESSION,"sender":$HANDLE,"mid":"1","media":"video","uplink":false,"lost":true})",
+		R"({"janus":"event","session_id":$SESSION,"sender":$HANDLE,"plugindata":{"plugin":"janus.plugin.videoroom","data":{"videoroom":"event","room":1234,"configured":"ok","audio_codec":"opus","video_codec":"vp8"}}})",
+		R"({"janus":"event","session_id":$SESSION,"sender":$HANDLE,"plugindata":{"plugin":"janus.plugin.videoroom","data":{"videoroom":"event","room":1234,"publishers":[{"id":4021,"display":"alice","streams":[{"type":"audio","mindex":0,"mid":"0","codec":"opus"},{"type":"video","mindex":1,"mid":"1","codec":"vp8","simulcast":true}]}]}}})",
+		R"({"janus":"event","session_id":$SESSION,"sender":$HANDLE,"plugindata":{"plugin":"janus.plugin.videoroom","data":{"videoroom":"event","room":1234,"substream":1,"temporal":2}}})",
+	};
+
+	void replaceAll(std::string& text, const std::string& token, const std::string& value)
+	{
+		for (size_t pos = text.find(token); pos != std::string::npos; pos = text.find(token, pos + value.size())) {
+			text.replace(pos, token.size(), value);
+		}
+	}
+}
+
+namespace vi {
+	JanusTraffic::JanusTraffic()
+		: _frames(std::begin(kRecording), std::end(kRecording))
+	{
+	}
+
+	bool JanusTraffic::load(const std::string& path)
+	{
+		std::ifstream file(path);
+		if (!file) {
+			return false;
+		}
+
+		std::vector<std::string> frames;
+		std::string line;
+		while (std::getline(file, line)) {
+			if (!line.empty() && line.back() == '\r') {
+				line.pop_back();
+			}
+			if (line.empty() || line[0] == '#') {
+				continue;
+			}
+			frames.emplace_back(line);
+		}
+		if (frames.empty()) {
+			return false;
+		}
+
+		_frames.swap(frames);
+		return true;
+	}
+
+	size_t JanusTraffic::size() const
+	{
+		return _frames.size();
+	}
+
+	std::shared_ptr<const std::vector<std::string>> JanusTraffic::render(int64_t sessionId, const std::vector<int64_t>& handles, size_t rounds) const
+	{
+		// one copy of every frame per handle, the rounds repeat them
+		std::vector<std::string> round;
+		round.reserve(_frames.size() * handles.size());
+		for (const auto& frame : _frames) {
+			for (int64_t handle : handles) {
+				std::string text = frame;
+				replaceAll(text, "$SESSION", std::to_string(sessionId));
+				replaceAll(text, "$HANDLE", std::to_string(handle));
+				round.emplace_back(std::move(text));
+			}
+		}
+
+		auto frames = std::make_shared<std::vector<std::string>>();
+		frames->reserve(round.size() * rounds);
+		for (size_t i = 0; i < rounds; ++i) {
+			frames->insert(frames->end(), round.begin(), round.end());
+		}
+		return frames;
+	}
+}
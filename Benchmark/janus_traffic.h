@@ -0,0 +1,35 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace vi {
+	// Janus events as recorded from a videoroom session, one frame per event. $SESSION and $HANDLE stand
+	// for the ids of the session and of the handle a frame is replayed to. Every frame is expected to
+	// reach a plugin handle once, i.e. trickle, webrtcup, media, slowlink, event, timeout or error.
+	class JanusTraffic {
+	public:
+		// The built-in recording: what a publisher and a subscriber handle get while a call is set up
+		JanusTraffic();
+
+		// Replaces the recording with the frames of |path|, one per line, empty lines and lines starting with # are skipped
+		bool load(const std::string& path);
+
+		// Frames per handle and round
+		size_t size() const;
+
+		// |rounds| times the recording for every handle, the handles interleaved the way Janus multiplexes them
+		std::shared_ptr<const std::vector<std::string>> render(int64_t sessionId, const std::vector<int64_t>& handles, size_t rounds) const;
+
+	private:
+		std::vector<std::string> _frames;
+	};
+}
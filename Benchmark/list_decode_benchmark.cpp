@@ -0,0 +1,121 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "benchmark.h"
+#include <stdio.h>
+#include <inttypes.h>
+#include <algorithm>
+#include <vector>
+#include "allocation_counter.h"
+#include "janus_message.h"
+#include "video_room_models.h"
+#include "rtc_base/time_utils.h"
+
+namespace {
+	// replies of these many entries are decoded
+	const size_t kEntries[] = { 10, 100, 1000 };
+
+	// total number of entries decoded per size and mode, so that the small replies get enough iterations
+	constexpr size_t kEntriesPerRun = 200000;
+
+	std::string participantsReply(size_t count)
+	{
+		std::string json = R"({"janus":"success","session_id":1000000,"transaction":"bench","sender":1000001,)"
+			R"("plugindata":{"plugin":"janus.plugin.videoroom","data":{"videoroom":"participants","room":1234,"participants":[)";
+		for (size_t i = 0; i < count; ++i) {
+			json += i == 0 ? "" : ",";
+			json += R"({"id":)" + std::to_string(2000000 + i) + R"(,"display":"participant )" + std::to_string(i) +
+				R"(","publisher":)" + (i % 3 ? "true" : "false") + R"(,"talking":false})";
+		}
+		json += "]}}}";
+		return json;
+	}
+
+	std::string roomsReply(size_t count)
+	{
+		std::string json = R"({"janus":"success","session_id":1000000,"transaction":"bench","sender":1000001,)"
+			R"("plugindata":{"plugin":"janus.plugin.videoroom","data":{"videoroom":"success","list":[)";
+		for (size_t i = 0; i < count; ++i) {
+			json += i == 0 ? "" : ",";
+			json += R"({"room":)" + std::to_string(1000 + i) + R"(,"description":"Room )" + std::to_string(i) +
+				R"(","max_publishers":6,"bitrate":512000,"bitrate_cap":false,"fir_freq":10,"audiocodec":"opus",)"
+				R"("videocodec":"vp8","record":false,"record_dir":"/var/lib/janus/recordings","lock_record":false,"num_participants":)" +
+				std::to_string(i % 7) + "}";
+		}
+		json += "]}}}";
+		return json;
+	}
+
+	struct DecodeResult {
+		bool ok = true;
+
+		double usPerReply = 0;
+
+		double allocationsPerReply = 0;
+
+		double bytesPerReply = 0;
+	};
+
+	// Parses every payload off a copy of its own, the way frames arrive, then decodes it with |decode|
+	template<typename Decode>
+	DecodeResult measure(const std::string& payload, size_t iterations, Decode decode)
+	{
+		// the copies stand for the socket reads, they are not part of what is measured
+		std::vector<std::string> frames(iterations, payload);
+
+		DecodeResult result;
+		const int64_t startUs = rtc::TimeMicros();
+		vi::AllocationScope allocations;
+		for (auto& frame : frames) {
+			std::string err;
+			auto message = vi::JanusMessage::parse(std::move(frame), err);
+			if (!message || !decode(*message, err)) {
+				printf("    decoding failed: %s\n", err.c_str());
+				result.ok = false;
+				return result;
+			}
+		}
+		result.allocationsPerReply = double(allocations.allocations()) / iterations;
+		result.bytesPerReply = double(allocations.bytes()) / iterations;
+		result.usPerReply = double(rtc::TimeMicros() - startUs) / iterations;
+		return result;
+	}
+
+	template<typename Model, typename View>
+	bool compare(const char* name, std::string (*reply)(size_t))
+	{
+		bool ok = true;
+		for (size_t entries : kEntries) {
+			const std::string payload = reply(entries);
+			const size_t iterations = std::max<size_t>(kEntriesPerRun / entries, 1);
+
+			const auto model = measure(payload, iterations, [](const vi::JanusMessage& message, std::string& err) {
+				auto model = message.to<Model>(err);
+				return model && err.empty();
+			});
+			const auto view = measure(payload, iterations, [](const vi::JanusMessage& message, std::string& err) {
+				View v;
+				return message.decode(v, err);
+			});
+			ok = ok && model.ok && view.ok;
+
+			printf("  %s x %zu (%zu bytes)\n", name, entries, payload.size());
+			printf("    model: %9.1f us, %8.1f allocations, %10.0f bytes per reply\n", model.usPerReply, model.allocationsPerReply, model.bytesPerReply);
+			printf("    view:  %9.1f us, %8.1f allocations, %10.0f bytes per reply\n", view.usPerReply, view.allocationsPerReply, view.bytesPerReply);
+		}
+		return ok;
+	}
+}
+
+namespace vi {
+	bool runListDecodeBenchmark(BenchmarkContext& context)
+	{
+		// the parse is part of both modes, the difference is what the models copy out of the DOM
+		const bool participants = compare<vr::FetchParticipantsResponse, vr::FetchParticipantsResponseView>("listparticipants", &participantsReply);
+		const bool rooms = compare<vr::FetchRoomsListResponse, vr::FetchRoomsListResponseView>("list", &roomsReply);
+		return participants && rooms;
+	}
+}
@@ -0,0 +1,129 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "benchmark.h"
+#include "logger/logger.h"
+#include "rtc_engine_factory.h"
+#include "service/i_rtc_engine.h"
+#include "rtc_base/thread.h"
+#if defined(WEBRTC_WIN)
+#include "rtc_base/win32_socket_init.h"
+#endif
+
+namespace {
+	const vi::BenchmarkScenario kScenarios[] = {
+		{ "signaling", "recorded videoroom events routed to plugin handles", &vi::runSignalingBenchmark },
+		{ "list-decode", "videoroom list replies decoded into models and into views", &vi::runListDecodeBenchmark },
+		{ "fan-out", "events delivered to observers on named threads", &vi::runFanOutBenchmark },
+		{ "transaction-id", "transaction ids from the seeded random string and from TransactionId", &vi::runTransactionIdBenchmark },
+		{ "timers", "10k concurrent timers on the timer wheel", &vi::runTimerBenchmark },
+		{ "send-path", "videoroom messages written from their models and sent through the client", &vi::runSendPathBenchmark },
+		{ "endpoint-stress", "connections of a multi-threaded websocket endpoint used from many threads", &vi::runEndpointStressBenchmark },
+		// last, the session it leaves behind has no handles
+		{ "reconnect", "session recovery after the connection to Janus dropped", &vi::runReconnectBenchmark },
+	};
+
+	void usage(const char* program)
+	{
+		printf("usage: %s [options]\n"
+			"  --handles <n>          plugin handles to spread the events over (50)\n"
+			"  --rounds <n>           times the recording is replayed to every handle (200)\n"
+			"  --traffic <file>       frames to replay, one json per line, $SESSION and $HANDLE substituted\n"
+			"  --filter <name>        only the scenarios whose name contains it\n"
+			"  --max-allocs <n>       fail above this many allocations per event or request\n"
+			"  --timeout <ms>         per step (30000)\n"
+			"  --verbose              log the client at debug level\n", program);
+	}
+
+	bool parse(int argc, char* argv[], vi::BenchmarkOptions& options)
+	{
+		for (int i = 1; i < argc; ++i) {
+			const char* arg = argv[i];
+			const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+			if (strcmp(arg, "--verbose") == 0) {
+				options.verbose = true;
+				continue;
+			}
+			if (!value) {
+				return false;
+			}
+			if (strcmp(arg, "--handles") == 0) {
+				options.handles = strtoul(value, nullptr, 10);
+			}
+			else if (strcmp(arg, "--rounds") == 0) {
+				options.rounds = strtoul(value, nullptr, 10);
+			}
+			else if (strcmp(arg, "--traffic") == 0) {
+				options.trafficPath = value;
+			}
+			else if (strcmp(arg, "--filter") == 0) {
+				options.filter = value;
+			}
+			else if (strcmp(arg, "--max-allocs") == 0) {
+				options.maxAllocationsPerEvent = strtod(value, nullptr);
+			}
+			else if (strcmp(arg, "--timeout") == 0) {
+				options.timeoutMs = strtoll(value, nullptr, 10);
+			}
+			else {
+				return false;
+			}
+			++i;
+		}
+		return options.handles > 0 && options.rounds > 0 && options.timeoutMs > 0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	vi::BenchmarkOptions options;
+	if (!parse(argc, argv, options)) {
+		usage(argv[0]);
+		return 2;
+	}
+
+	vi::Logger::init();
+	vi::Logger::appLogger()->set_level(options.verbose ? spdlog::level::debug : spdlog::level::warn);
+
+#if defined(WEBRTC_WIN)
+	rtc::WinsockInitializer winsockInit;
+#endif
+	// the engine observers are called on the main thread, serviced by waitFor()
+	rtc::ThreadManager::Instance()->WrapCurrentThread();
+
+	auto engine = vi::RTCEngineFactory::createEngine();
+	engine->init();
+
+	int failures = 0;
+	{
+		vi::BenchmarkContext context(options);
+		if (!context.setUp()) {
+			printf("setting up the session on the fake Janus failed\n");
+			++failures;
+		}
+		else {
+			for (const auto& scenario : kScenarios) {
+				if (!options.filter.empty() && std::string(scenario.name).find(options.filter) == std::string::npos) {
+					continue;
+				}
+				printf("%s: %s\n", scenario.name, scenario.description);
+				const bool passed = scenario.run(context);
+				printf("%s: %s\n\n", scenario.name, passed ? "ok" : "FAILED");
+				failures += passed ? 0 : 1;
+			}
+		}
+	}
+
+	engine->destroy();
+	rtc::ThreadManager::Instance()->UnwrapCurrentThread();
+	vi::Logger::destroy();
+
+	return failures == 0 ? 0 : 1;
+}
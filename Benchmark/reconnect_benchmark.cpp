@@ -0,0 +1,107 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "benchmark.h"
+#include <stdio.h>
+#include <inttypes.h>
+#include "signaling_client_interface.h"
+#include "connection_policy.h"
+#include "rtc_base/time_utils.h"
+
+namespace {
+	// reconnects right away, the time measured is the one of the client and not of its backoff
+	constexpr uint32_t kInitialBackoffMs = 10;
+
+	struct Recovery {
+		bool done = false;
+
+		int64_t elapsedMs = 0;
+	};
+
+	// Waits for |recovered| to hold with the session connected, timed from |startMs|
+	Recovery waitForRecovery(vi::BenchmarkContext& context, int64_t startMs, const std::function<bool()>& recovered)
+	{
+		auto sc = context.signalingClient();
+		Recovery recovery;
+		recovery.done = vi::waitFor([sc, &recovered]() {
+			return recovered() && sc->sessionStatus() == vi::SessionStatus::CONNECTED;
+		}, context.options().timeoutMs);
+		recovery.elapsedMs = rtc::TimeMillis() - startMs;
+		return recovery;
+	}
+
+	// Every handle still gets its events: the client kept them through the reconnect
+	bool handlesAlive(vi::BenchmarkContext& context, const std::vector<int64_t>& handles)
+	{
+		auto frames = context.traffic().render(context.server().sessionId(), handles, 1);
+		const uint64_t expected = context.events() + frames->size();
+		context.server().replay(frames);
+		return vi::waitFor([&context, expected]() { return context.events() >= expected; }, context.options().timeoutMs);
+	}
+}
+
+namespace vi {
+	bool runReconnectBenchmark(BenchmarkContext& context)
+	{
+		const auto& options = context.options();
+		if (!context.ensureHandles(options.handles)) {
+			return false;
+		}
+		const auto handles = context.handleIds(options.handles);
+		auto sc = context.signalingClient();
+		auto& server = context.server();
+
+		ConnectionPolicy policy;
+		policy.initialBackoffMs = kInitialBackoffMs;
+		sc->setConnectionPolicy(policy);
+
+		// claimed back on the first new connection
+		const int64_t sessionId = server.sessionId();
+		const uint64_t creates = server.requests("create");
+		uint64_t claims = server.requests("claim");
+		int64_t startMs = rtc::TimeMillis();
+		server.dropConnections();
+		Recovery claimed = waitForRecovery(context, startMs, [&server, claims]() { return server.requests("claim") >= claims + 1; });
+		if (!claimed.done || server.requests("create") != creates || server.sessionId() != sessionId) {
+			printf("  the session was not claimed back after a drop\n");
+			return false;
+		}
+		if (!handlesAlive(context, handles)) {
+			printf("  the handles did not survive the drop\n");
+			return false;
+		}
+		printf("  claimed:          %" PRId64 " ms, %zu handles kept\n", claimed.elapsedMs, handles.size());
+
+		// the claim is lost to a second drop, it is made again on the next connection and not given up
+		claims = server.requests("claim");
+		startMs = rtc::TimeMillis();
+		server.dropConnections(1);
+		Recovery reclaimed = waitForRecovery(context, startMs, [&server, claims]() { return server.requests("claim") >= claims + 2; });
+		if (!reclaimed.done || server.requests("create") != creates || server.sessionId() != sessionId) {
+			printf("  the session was given up after its claim was lost\n");
+			return false;
+		}
+		if (!handlesAlive(context, handles)) {
+			printf("  the handles did not survive the second drop\n");
+			return false;
+		}
+		printf("  claimed twice:    %" PRId64 " ms, %zu handles kept\n", reclaimed.elapsedMs, handles.size());
+
+		// Janus answers the claim with 458, a new session is created
+		startMs = rtc::TimeMillis();
+		server.expireSession();
+		server.dropConnections();
+		Recovery recreated = waitForRecovery(context, startMs, [&server, creates]() { return server.requests("create") > creates && server.sessionId() > 0; });
+		context.forgetHandles();
+		if (!recreated.done) {
+			printf("  no new session after the old one expired\n");
+			return false;
+		}
+		printf("  recreated:        %" PRId64 " ms\n", recreated.elapsedMs);
+
+		return true;
+	}
+}
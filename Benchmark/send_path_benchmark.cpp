@@ -0,0 +1,237 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "benchmark.h"
+#include <stdio.h>
+#include <inttypes.h>
+#include "allocation_counter.h"
+#include "signaling_client_interface.h"
+#include "signaling_events.h"
+#include "message_models.h"
+#include "video_room_models.h"
+#include "json/serialization_json.hpp"
+#include "rtc_base/time_utils.h"
+
+namespace {
+	// requests written or sent per measurement
+	constexpr size_t kRequests = 10000;
+
+	// sent before measuring, so that the pooled buffers and the scratch arena are grown to their working size
+	constexpr size_t kWarmUpRequests = 100;
+
+	// about the size of an offer with one audio and one simulcast video section
+	constexpr size_t kSdpSize = 4 * 1024;
+
+	// Allocations per request through the client when --max-allocs is not given. Writing the frame takes none,
+	// what is left is the proxy call onto the signaling thread, the handler and its callbacks, the model kept by
+	// a replayable request, the ack read into a buffer of its own, its DOM, and the two posts that bring it back
+	constexpr double kClientAllocationBudget = 32;
+
+	std::shared_ptr<const vi::vr::PublisherConfigureRequest> configureRequest()
+	{
+		auto request = std::make_shared<vi::vr::PublisherConfigureRequest>();
+		request->bitrate = 512000;
+		request->display = "bench";
+		vi::vr::PublisherConfigureRequest::Description description;
+		description.mid = "1";
+		description.description = "camera";
+		request->descriptions = std::vector<vi::vr::PublisherConfigureRequest::Description>{ description };
+		return request;
+	}
+
+	std::shared_ptr<const vi::Jsep> offer()
+	{
+		auto jsep = std::make_shared<vi::Jsep>();
+		jsep->type = "offer";
+		std::string sdp = "v=0\r\no=- 4611731400430051336 2 IN IP4 127.0.0.1\r\ns=-\r\nt=0 0\r\n";
+		while (sdp.size() < kSdpSize) {
+			sdp += "a=candidate:842163049 1 udp 1677729535 192.168.1.2 58001 typ srflx raddr 0.0.0.0 rport 0\r\n";
+		}
+		jsep->sdp = std::move(sdp);
+		return jsep;
+	}
+
+	vi::CandidateData candidate()
+	{
+		vi::CandidateData candidate;
+		candidate.candidate = "candidate:842163049 1 udp 1677729535 192.168.1.2 58001 typ srflx raddr 0.0.0.0 rport 0 generation 0";
+		candidate.sdpMid = "0";
+		candidate.sdpMLineIndex = 0;
+		return candidate;
+	}
+
+	struct SendResult {
+		bool ok = true;
+
+		double usPerRequest = 0;
+
+		double allocationsPerRequest = 0;
+
+		double bytesPerRequest = 0;
+	};
+
+	// Writes |request| into one reused payload, the way the transport fills a pooled buffer
+	template<typename Request>
+	SendResult measureWrite(const Request& request)
+	{
+		std::string payload;
+		for (size_t i = 0; i < kWarmUpRequests; ++i) {
+			payload.clear();
+			writeJson(request, payload);
+		}
+
+		SendResult result;
+		const int64_t startUs = rtc::TimeMicros();
+		vi::AllocationScope allocations;
+		for (size_t i = 0; i < kRequests; ++i) {
+			payload.clear();
+			writeJson(request, payload);
+		}
+		result.allocationsPerRequest = double(allocations.allocations()) / kRequests;
+		result.bytesPerRequest = double(allocations.bytes()) / kRequests;
+		result.usPerRequest = double(rtc::TimeMicros() - startUs) / kRequests;
+		return result;
+	}
+
+	// Sends the requests |first| to |first| + |count| with |send| and waits for Janus to ack them all
+	bool sendAll(vi::BenchmarkContext& context, size_t first, size_t count, const std::function<void(size_t)>& send,
+		const std::shared_ptr<std::atomic<uint64_t>>& acked)
+	{
+		const uint64_t expected = acked->load() + count;
+		for (size_t i = first; i < first + count; ++i) {
+			send(i);
+		}
+		return vi::waitFor([acked, expected]() { return acked->load() >= expected; }, context.options().timeoutMs);
+	}
+
+	// From the signaling client to the socket and back: |send| hands request |i| to the client, the events it
+	// sends are made ahead and are not part of what is measured
+	SendResult measureClient(vi::BenchmarkContext& context, const char* janus, const std::function<void(size_t)>& send,
+		const std::shared_ptr<std::atomic<uint64_t>>& acked)
+	{
+		SendResult result;
+		if (!sendAll(context, 0, kWarmUpRequests, send, acked)) {
+			printf("  warm up timed out, %" PRIu64 " requests acked\n", acked->load());
+			result.ok = false;
+			return result;
+		}
+
+		const uint64_t sent = context.server().requests(janus);
+		const int64_t startUs = rtc::TimeMicros();
+		vi::AllocationScope allocations;
+		result.ok = sendAll(context, kWarmUpRequests, kRequests, send, acked);
+		result.allocationsPerRequest = double(allocations.allocations()) / kRequests;
+		result.bytesPerRequest = double(allocations.bytes()) / kRequests;
+		result.usPerRequest = double(rtc::TimeMicros() - startUs) / kRequests;
+		if (!result.ok || context.server().requests(janus) < sent + kRequests) {
+			printf("  timed out, %" PRIu64 " of %zu requests acked\n", acked->load() - kWarmUpRequests, kRequests);
+			result.ok = false;
+		}
+		return result;
+	}
+
+	// The write path takes no allocation at all, the client path stays within |budget|
+	bool report(const char* name, const SendResult& write, const SendResult& client, double budget)
+	{
+		printf("  %s\n", name);
+		printf("    write:  %8.2f us, %6.2f allocations, %8.0f bytes per request\n", write.usPerRequest, write.allocationsPerRequest, write.bytesPerRequest);
+		printf("    client: %8.2f us, %6.2f allocations, %8.0f bytes per request, acks included\n", client.usPerRequest, client.allocationsPerRequest, client.bytesPerRequest);
+
+		bool ok = true;
+		if (write.allocationsPerRequest > 0) {
+			printf("    the write path allocated\n");
+			ok = false;
+		}
+		if (client.allocationsPerRequest > budget) {
+			printf("    over the budget of %.2f allocations per request\n", budget);
+			ok = false;
+		}
+		return ok;
+	}
+}
+
+namespace vi {
+	bool runSendPathBenchmark(BenchmarkContext& context)
+	{
+		const auto& options = context.options();
+		if (!context.ensureHandles(options.handles)) {
+			return false;
+		}
+		const auto handles = context.handleIds(options.handles);
+		auto sc = context.signalingClient();
+		const double budget = options.maxAllocationsPerEvent >= 0 ? options.maxAllocationsPerEvent : kClientAllocationBudget;
+
+		// a configure with its offer, the body and the jsep are shared by every request, as a plugin hands over
+		// one model per request and does not touch it again
+		const JsonBody body = JsonBody::of(configureRequest());
+		const JsonBody jsep = JsonBody::of(offer());
+
+		MessageRequest message;
+		message.janus = "message";
+		message.transaction = "bench";
+		message.session_id = 1000000;
+		message.handle_id = 1000001;
+		message.body = body;
+		message.jsep = jsep;
+		const auto messageWrite = measureWrite(message);
+
+		auto messagesAcked = std::make_shared<std::atomic<uint64_t>>(0);
+		auto reply = std::make_shared<ReplyCallback>([messagesAcked](bool success, std::shared_ptr<JanusMessage> ack) {
+			if (success) {
+				++*messagesAcked;
+			}
+		});
+		std::vector<std::shared_ptr<MessageEvent>> messages;
+		messages.reserve(kWarmUpRequests + kRequests);
+		for (size_t i = 0; i < kWarmUpRequests + kRequests; ++i) {
+			auto event = std::make_shared<MessageEvent>();
+			event->body = body;
+			event->jsep = jsep;
+			event->reply = reply;
+			messages.emplace_back(std::move(event));
+		}
+		const auto messageClient = measureClient(context, "message", [sc, &messages, &handles](size_t i) {
+			sc->sendMessage(handles[i % handles.size()], messages[i]);
+		}, messagesAcked);
+		if (!messageClient.ok) {
+			return false;
+		}
+
+		// a single trickled candidate, the request sent most often
+		TrickleRequest trickle;
+		trickle.janus = "trickle";
+		trickle.transaction = "bench";
+		trickle.session_id = 1000000;
+		trickle.handle_id = 1000001;
+		trickle.candidate = candidate();
+		const auto trickleWrite = measureWrite(trickle);
+
+		auto tricklesAcked = std::make_shared<std::atomic<uint64_t>>(0);
+		auto callback = std::make_shared<EventCallback>([tricklesAcked](bool success, const std::string& janus) {
+			if (janus == "ack") {
+				++*tricklesAcked;
+			}
+		});
+		std::vector<std::shared_ptr<TrickleCandidateEvent>> trickles;
+		trickles.reserve(kWarmUpRequests + kRequests);
+		for (size_t i = 0; i < kWarmUpRequests + kRequests; ++i) {
+			auto event = std::make_shared<TrickleCandidateEvent>();
+			event->candidates.emplace_back(candidate());
+			event->callback = callback;
+			trickles.emplace_back(std::move(event));
+		}
+		const auto trickleClient = measureClient(context, "trickle", [sc, &trickles, &handles](size_t i) {
+			sc->sendTrickleCandidate(handles[i % handles.size()], trickles[i]);
+		}, tricklesAcked);
+		if (!trickleClient.ok) {
+			return false;
+		}
+
+		const bool configureOk = report("configure with offer", messageWrite, messageClient, budget);
+		const bool trickleOk = report("trickle", trickleWrite, trickleClient, budget);
+		return configureOk && trickleOk;
+	}
+}
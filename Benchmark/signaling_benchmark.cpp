@@ -0,0 +1,86 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "benchmark.h"
+#include <stdio.h>
+#include <inttypes.h>
+#include "allocation_counter.h"
+#include "signaling_client_interface.h"
+#include "rtc_base/time_utils.h"
+
+namespace {
+	// one round before measuring, so that pools and maps are grown to their working size
+	constexpr size_t kWarmUpRounds = 1;
+
+	bool replay(vi::BenchmarkContext& context, const std::vector<int64_t>& handles, size_t rounds)
+	{
+		auto frames = context.traffic().render(context.server().sessionId(), handles, rounds);
+		const uint64_t expected = context.events() + frames->size();
+		context.server().replay(frames);
+		return vi::waitFor([&context, expected]() { return context.events() >= expected; }, context.options().timeoutMs);
+	}
+}
+
+namespace vi {
+	bool runSignalingBenchmark(BenchmarkContext& context)
+	{
+		const auto& options = context.options();
+		if (!context.ensureHandles(options.handles)) {
+			return false;
+		}
+		const auto handles = context.handleIds(options.handles);
+		auto sc = context.signalingClient();
+
+		if (!replay(context, handles, kWarmUpRounds)) {
+			printf("  warm up timed out, %" PRIu64 " events routed\n", context.events());
+			return false;
+		}
+
+		// rendered ahead, the frames are not part of what is measured
+		auto frames = context.traffic().render(context.server().sessionId(), handles, options.rounds);
+		const uint64_t first = context.events();
+		const uint64_t expected = first + frames->size();
+		const auto before = sc->dispatchStats();
+
+		const int64_t startUs = rtc::TimeMicros();
+		AllocationScope allocations;
+		context.server().replay(frames);
+		const bool done = waitFor([&context, expected]() { return context.events() >= expected; }, options.timeoutMs);
+		const uint64_t allocated = allocations.allocations();
+		const uint64_t bytes = allocations.bytes();
+		const int64_t elapsedUs = rtc::TimeMicros() - startUs;
+
+		const uint64_t events = context.events() - first;
+		if (!done) {
+			printf("  timed out, %" PRIu64 " of %zu events routed\n", events, frames->size());
+			return false;
+		}
+
+		const auto delta = dispatchDelta(before, sc->dispatchStats());
+		const auto total = mergeDispatchStats(delta);
+
+		const double seconds = elapsedUs / 1e6;
+		const double allocationsPerEvent = double(allocated) / events;
+		printf("  %zu handles x %zu rounds: %" PRIu64 " events in %.3f s, %.0f events/s\n",
+			handles.size(), options.rounds, events, seconds, events / seconds);
+		printf("  dispatch latency: p50 <= %" PRId64 " us, p99 <= %" PRId64 " us, %" PRIu64 " dropped\n",
+			total.percentile(0.5), total.percentile(0.99), total.dropped);
+		for (const auto& stats : delta) {
+			if (stats.dispatched == 0) {
+				continue;
+			}
+			printf("    %-10s %8" PRIu64 " events, p50 <= %" PRId64 " us, p99 <= %" PRId64 " us\n",
+				signalingEventName(stats.type), stats.dispatched, stats.percentile(0.5), stats.percentile(0.99));
+		}
+		printf("  allocations: %.2f per event, %.0f bytes per event\n", allocationsPerEvent, double(bytes) / events);
+
+		if (options.maxAllocationsPerEvent >= 0 && allocationsPerEvent > options.maxAllocationsPerEvent) {
+			printf("  over the budget of %.2f allocations per event\n", options.maxAllocationsPerEvent);
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,161 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "benchmark.h"
+#include <stdio.h>
+#include <inttypes.h>
+#include <algorithm>
+#include "utils/timer_service.h"
+#include "utils/thread_provider.h"
+#include "rtc_base/time_utils.h"
+#if defined(WEBRTC_WIN)
+#include <windows.h>
+#include <tlhelp32.h>
+#else
+#include <dirent.h>
+#include <sys/resource.h>
+#endif
+
+namespace {
+	constexpr size_t kTimers = 10000;
+
+	// delays are spread over several seconds, so that the timers go through the upper levels of the wheel
+	constexpr int64_t kMinDelayMs = 100;
+
+	constexpr int64_t kDelaySpreadMs = 5000;
+
+	// every other timer is cancelled before it is due
+	constexpr size_t kCancelEvery = 2;
+
+	// Threads of the process, -1 where they can not be counted
+	int64_t threadCount()
+	{
+#if defined(WEBRTC_WIN)
+		HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+		if (snapshot == INVALID_HANDLE_VALUE) {
+			return -1;
+		}
+		int64_t count = 0;
+		THREADENTRY32 entry;
+		entry.dwSize = sizeof(entry);
+		for (BOOL more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry)) {
+			count += entry.th32OwnerProcessID == GetCurrentProcessId() ? 1 : 0;
+		}
+		CloseHandle(snapshot);
+		return count;
+#else
+		DIR* tasks = opendir("/proc/self/task");
+		if (!tasks) {
+			return -1;
+		}
+		int64_t count = 0;
+		while (struct dirent* entry = readdir(tasks)) {
+			count += entry->d_name[0] != '.' ? 1 : 0;
+		}
+		closedir(tasks);
+		return count;
+#endif
+	}
+
+	// User and kernel time of the whole process
+	int64_t cpuTimeUs()
+	{
+#if defined(WEBRTC_WIN)
+		FILETIME creation, exited, kernel, user;
+		if (!GetProcessTimes(GetCurrentProcess(), &creation, &exited, &kernel, &user)) {
+			return 0;
+		}
+		auto us = [](const FILETIME& time) {
+			return static_cast<int64_t>((uint64_t(time.dwHighDateTime) << 32 | time.dwLowDateTime) / 10);
+		};
+		return us(kernel) + us(user);
+#else
+		struct rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) != 0) {
+			return 0;
+		}
+		auto us = [](const timeval& time) {
+			return static_cast<int64_t>(time.tv_sec) * 1000000 + time.tv_usec;
+		};
+		return us(usage.ru_utime) + us(usage.ru_stime);
+#endif
+	}
+}
+
+namespace vi {
+	bool runTimerBenchmark(BenchmarkContext& context)
+	{
+		const auto& options = context.options();
+		auto timers = Timers;
+		rtc::Thread* executor = TMgr->thread(NamedThread::STATS_COLLECTOR);
+		if (!timers || !executor) {
+			printf("  no timer service\n");
+			return false;
+		}
+
+		const size_t pendingBefore = timers->size();
+		const int64_t threadsBefore = threadCount();
+		const int64_t cpuStartUs = cpuTimeUs();
+		const int64_t startUs = rtc::TimeMicros();
+
+		auto fired = std::make_shared<std::atomic<uint64_t>>(0);
+		auto firedCancelled = std::make_shared<std::atomic<uint64_t>>(0);
+		std::vector<TimerId> ids;
+		ids.reserve(kTimers);
+		for (size_t i = 0; i < kTimers; ++i) {
+			const bool cancelled = i % kCancelEvery == 0;
+			auto counter = cancelled ? firedCancelled : fired;
+			// a prime stride, the delays do not line up with the buckets
+			const int64_t delayMs = kMinDelayMs + static_cast<int64_t>(i * 7919) % kDelaySpreadMs;
+			ids.emplace_back(timers->schedule(executor, [counter]() { ++*counter; }, delayMs));
+		}
+		const int64_t scheduledUs = rtc::TimeMicros();
+		const int64_t threadsScheduled = threadCount();
+
+		size_t cancelled = 0;
+		for (size_t i = 0; i < kTimers; i += kCancelEvery) {
+			cancelled += timers->cancel(ids[i]) ? 1 : 0;
+		}
+		const int64_t cancelledUs = rtc::TimeMicros();
+
+		const uint64_t expected = kTimers - cancelled;
+		const bool done = waitFor([fired, expected]() { return fired->load() >= expected; }, options.timeoutMs);
+		// two more ticks, a cancelled timer that would still fire does so by then
+		waitFor([]() { return false; }, 2 * TimerService::kTickMs);
+
+		const int64_t elapsedUs = rtc::TimeMicros() - startUs;
+		const int64_t cpuUs = cpuTimeUs() - cpuStartUs;
+		const int64_t threadsAfter = threadCount();
+		const size_t pendingAfter = timers->size();
+
+		printf("  %zu timers over %" PRId64 " ms: scheduled in %.2f us, %zu cancelled in %.2f us per timer\n",
+			kTimers, kDelaySpreadMs, double(scheduledUs - startUs) / kTimers, cancelled, double(cancelledUs - scheduledUs) / std::max<size_t>(cancelled, 1));
+		printf("  %" PRIu64 " fired in %.3f s, %.1f ms of cpu for the process (%.2f%%)\n",
+			fired->load(), elapsedUs / 1e6, cpuUs / 1e3, 100.0 * cpuUs / elapsedUs);
+		printf("  threads: %" PRId64 " before, %" PRId64 " with the timers pending, %" PRId64 " after\n",
+			threadsBefore, threadsScheduled, threadsAfter);
+
+		bool ok = true;
+		if (!done || cancelled != kTimers / kCancelEvery) {
+			printf("  %" PRIu64 " of %" PRIu64 " timers fired, %zu cancelled\n", fired->load(), expected, cancelled);
+			ok = false;
+		}
+		if (firedCancelled->load() > 0) {
+			printf("  %" PRIu64 " cancelled timers fired\n", firedCancelled->load());
+			ok = false;
+		}
+		// the timers share the thread of the service, a thread per timer or per owner would show here
+		if (threadsBefore >= 0 && threadsScheduled > threadsBefore) {
+			printf("  the timers started %" PRId64 " thread(s)\n", threadsScheduled - threadsBefore);
+			ok = false;
+		}
+		if (pendingAfter != pendingBefore) {
+			printf("  %zu timers left pending, %zu before\n", pendingAfter, pendingBefore);
+			ok = false;
+		}
+		return ok;
+	}
+}
@@ -0,0 +1,101 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "benchmark.h"
+#include <stdio.h>
+#include <random>
+#include <chrono>
+#include <unordered_set>
+#include "allocation_counter.h"
+#include "utils/transaction_id.h"
+#include "rtc_base/time_utils.h"
+
+namespace {
+	// ids made per generator and measurement
+	constexpr size_t kIds = 1000000;
+
+	// ids made back to back and checked for repeats, as a burst of requests would get them
+	constexpr size_t kBurst = 100000;
+
+	constexpr int32_t kLegacyLength = 12;
+
+	// StringUtils::randomString() as transactions were made before TransactionId: a new engine seeded
+	// from the clock on every call, one substr() per character
+	std::string legacyTransaction(int32_t len)
+	{
+		std::string charSet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+		std::string randomString;
+
+		std::default_random_engine engine((int64_t)std::chrono::steady_clock::now().time_since_epoch().count());
+		std::uniform_int_distribution<int> dist(0, charSet.length() - 1);
+
+		for (int32_t i = 0; i < len; ++i) {
+			int32_t randomPoz = dist(engine);
+			randomString += charSet.substr(randomPoz, 1);
+		}
+		return randomString;
+	}
+
+	struct IdResult {
+		double nsPerId = 0;
+
+		double allocationsPerId = 0;
+
+		double length = 0;
+
+		size_t repeats = 0;
+	};
+
+	// |next| returns the text of a new id, the way a request stores it
+	template<typename Next>
+	IdResult measure(Next next)
+	{
+		IdResult result;
+		size_t length = 0;
+		const int64_t startNs = rtc::TimeNanos();
+		vi::AllocationScope allocations;
+		for (size_t i = 0; i < kIds; ++i) {
+			length += next().size();
+		}
+		result.allocationsPerId = double(allocations.allocations()) / kIds;
+		result.nsPerId = double(rtc::TimeNanos() - startNs) / kIds;
+		result.length = double(length) / kIds;
+
+		std::vector<std::string> burst;
+		burst.reserve(kBurst);
+		for (size_t i = 0; i < kBurst; ++i) {
+			burst.emplace_back(next());
+		}
+		std::unordered_set<std::string> unique(burst.begin(), burst.end());
+		result.repeats = burst.size() - unique.size();
+		return result;
+	}
+}
+
+namespace vi {
+	bool runTransactionIdBenchmark(BenchmarkContext& context)
+	{
+		const auto legacy = measure([]() { return legacyTransaction(kLegacyLength); });
+		const auto counter = measure([]() { return TransactionId::next().str(); });
+
+		printf("  randomString(%d): %8.1f ns, %5.2f allocations per id, %4.1f chars, %zu repeats in a burst of %zu\n",
+			kLegacyLength, legacy.nsPerId, legacy.allocationsPerId, legacy.length, legacy.repeats, kBurst);
+		printf("  TransactionId:    %8.1f ns, %5.2f allocations per id, %4.1f chars, %zu repeats in a burst of %zu\n",
+			counter.nsPerId, counter.allocationsPerId, counter.length, counter.repeats, kBurst);
+
+		// the text fits the small string buffer and the counter never repeats
+		bool ok = true;
+		if (counter.allocationsPerId > 0) {
+			printf("  TransactionId allocated\n");
+			ok = false;
+		}
+		if (counter.repeats > 0) {
+			printf("  TransactionId repeated\n");
+			ok = false;
+		}
+		return ok;
+	}
+}
@@ -0,0 +1,76 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "endpoint_stress.h"
+#include "fake_janus_server.h"
+#include "logger/logger.h"
+
+// The endpoint-stress scenario of the Benchmark on its own, for the ThreadSanitizer build. Takes the options of
+// the Benchmark that apply to it, --filter only to be run the same way.
+namespace {
+	const char* kScenario = "endpoint-stress";
+
+	const char* kDescription = "connections of a multi-threaded websocket endpoint used from many threads";
+
+	void usage(const char* program)
+	{
+		printf("usage: %s [options]\n"
+			"  --filter <name>        runs the scenario when its name contains it (%s)\n"
+			"  --timeout <ms>         per step (30000)\n", program, kScenario);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::string filter;
+	int64_t timeoutMs = 30000;
+	for (int i = 1; i < argc; ++i) {
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		if (value && strcmp(argv[i], "--filter") == 0) {
+			filter = value;
+		}
+		else if (value && strcmp(argv[i], "--timeout") == 0) {
+			timeoutMs = strtoll(value, nullptr, 10);
+		}
+		else {
+			usage(argv[0]);
+			return 2;
+		}
+		++i;
+	}
+	if (timeoutMs <= 0) {
+		usage(argv[0]);
+		return 2;
+	}
+	if (std::string(kScenario).find(filter) == std::string::npos) {
+		printf("no scenario matches '%s'\n", filter.c_str());
+		return 1;
+	}
+
+	vi::Logger::init();
+
+	bool ok = false;
+	{
+		vi::FakeJanusServer server;
+		const std::string url = server.start();
+		if (url.empty()) {
+			printf("starting the fake Janus failed\n");
+		}
+		else {
+			printf("%s: %s\n", kScenario, kDescription);
+			ok = vi::runEndpointStress(url, timeoutMs);
+			printf("%s: %s\n\n", kScenario, ok ? "ok" : "FAILED");
+		}
+		server.stop();
+	}
+
+	vi::Logger::destroy();
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "logger/logger.h"
+#include "spdlog/sinks/stdout_sinks.h"
+
+// Stands in for RTCSDK/logger/logger.cpp in the ThreadSanitizer build, which has no webrtc to forward its log
+// to and no debugger sink off Windows: both loggers write to stderr
+namespace vi {
+
+	std::shared_ptr<spdlog::logger> Logger::_appLogger;
+
+	std::shared_ptr<spdlog::logger> Logger::_rtcLogger;
+
+	Logger::Logger()
+	{
+
+	}
+
+	Logger::~Logger()
+	{
+		destroy();
+	}
+
+	void Logger::init()
+	{
+		_appLogger = spdlog::stderr_logger_mt("app");
+		_appLogger->set_level(spdlog::level::warn);
+
+		_rtcLogger = spdlog::stderr_logger_mt("rtc");
+		_rtcLogger->set_level(spdlog::level::warn);
+	}
+
+	void Logger::destroy()
+	{
+		spdlog::drop_all();
+	}
+
+	std::shared_ptr<spdlog::logger>& Logger::rtcLogger()
+	{
+		return _rtcLogger;
+	}
+
+	std::shared_ptr<spdlog::logger>& Logger::appLogger()
+	{
+		return _appLogger;
+	}
+
+}
@@ -0,0 +1,31 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <stdint.h>
+
+namespace vi {
+	// Liveness check, reconnect schedule and i/o threads of the signaling transport
+	struct ConnectionPolicy {
+		// websocket ping period, 0 disables the liveness check
+		uint32_t pingIntervalMs = 2000;
+
+		// a ping left without pong that long declares the connection dead
+		uint32_t pongTimeoutMs = 3000;
+
+		// delay before the first reconnect attempt, doubled on every failed attempt up to |maxBackoffMs|
+		uint32_t initialBackoffMs = 250;
+
+		uint32_t maxBackoffMs = 8000;
+
+		// attempts before the session is given up, 0 retries forever
+		uint32_t maxAttempts = 0;
+
+		// threads running the websocket i/o of the transport, read when its endpoint is created
+		uint32_t ioThreads = 1;
+	};
+}
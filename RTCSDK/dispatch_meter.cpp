@@ -0,0 +1,57 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "dispatch_meter.h"
+
+namespace {
+	size_t bucketOf(int64_t elapsed)
+	{
+		size_t bucket = 0;
+		while (elapsed > 0 && bucket < vi::DispatchStats::kBuckets - 1) {
+			elapsed >>= 1;
+			++bucket;
+		}
+		return bucket;
+	}
+}
+
+namespace vi {
+	void DispatchMeter::record(SignalingEvent type, int64_t elapsedUs)
+	{
+		const size_t index = static_cast<size_t>(type);
+		if (index >= _histograms.size()) {
+			return;
+		}
+		Histogram& histogram = _histograms[index];
+		histogram.buckets[bucketOf(elapsedUs)].fetch_add(1, std::memory_order_relaxed);
+		histogram.dispatched.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void DispatchMeter::drop(SignalingEvent type)
+	{
+		const size_t index = static_cast<size_t>(type);
+		if (index >= _histograms.size()) {
+			return;
+		}
+		_histograms[index].dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	std::vector<DispatchStats> DispatchMeter::stats() const
+	{
+		std::vector<DispatchStats> result(_histograms.size());
+		for (size_t i = 0; i < _histograms.size(); ++i) {
+			const Histogram& histogram = _histograms[i];
+			DispatchStats& stats = result[i];
+			stats.type = static_cast<SignalingEvent>(i);
+			stats.dispatched = histogram.dispatched.load(std::memory_order_relaxed);
+			stats.dropped = histogram.dropped.load(std::memory_order_relaxed);
+			for (size_t b = 0; b < DispatchStats::kBuckets; ++b) {
+				stats.buckets[b] = histogram.buckets[b].load(std::memory_order_relaxed);
+			}
+		}
+		return result;
+	}
+}
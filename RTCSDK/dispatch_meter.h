@@ -0,0 +1,40 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include "dispatch_stats.h"
+
+namespace vi {
+	// Lock free accumulator behind SignalingClient::dispatchStats(), recorded from the event handler thread
+	// and read from any thread
+	class DispatchMeter {
+	public:
+		DispatchMeter() = default;
+
+		void record(SignalingEvent type, int64_t elapsedUs);
+
+		void drop(SignalingEvent type);
+
+		std::vector<DispatchStats> stats() const;
+
+	private:
+		struct Histogram {
+			std::atomic<uint64_t> dispatched{ 0 };
+			std::atomic<uint64_t> dropped{ 0 };
+			std::array<std::atomic<uint64_t>, DispatchStats::kBuckets> buckets{};
+		};
+
+		DispatchMeter(const DispatchMeter&) = delete;
+
+		DispatchMeter& operator=(const DispatchMeter&) = delete;
+
+	private:
+		std::array<Histogram, static_cast<size_t>(SignalingEvent::COUNT)> _histograms;
+	};
+}
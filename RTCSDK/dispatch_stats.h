@@ -0,0 +1,80 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+
+namespace vi {
+	// Asynchronous Janus messages routed by SignalingClient to a plugin handle.
+	// JANUS_ERROR avoids the ERROR macro of the windows headers
+	enum class SignalingEvent : uint32_t {
+		TRICKLE = 0,
+		WEBRTCUP,
+		HANGUP,
+		DETACHED,
+		MEDIA,
+		SLOWLINK,
+		PLUGIN_EVENT,
+		TIMEOUT,
+		JANUS_ERROR,
+		COUNT
+	};
+
+	inline const char* signalingEventName(SignalingEvent type)
+	{
+		switch (type) {
+		case SignalingEvent::TRICKLE: return "trickle";
+		case SignalingEvent::WEBRTCUP: return "webrtcup";
+		case SignalingEvent::HANGUP: return "hangup";
+		case SignalingEvent::DETACHED: return "detached";
+		case SignalingEvent::MEDIA: return "media";
+		case SignalingEvent::SLOWLINK: return "slowlink";
+		case SignalingEvent::PLUGIN_EVENT: return "event";
+		case SignalingEvent::TIMEOUT: return "timeout";
+		case SignalingEvent::JANUS_ERROR: return "error";
+		default: return "unknown";
+		}
+	}
+
+	// Dispatch latency of one event type, measured from the websocket frame being parsed to the plugin
+	// handler being invoked. buckets[0] counts events within 1us, buckets[i] those within [2^(i-1), 2^i) us,
+	// the last bucket is open ended. Two snapshots taken |dt| apart give the event rate as delta(dispatched) / dt
+	struct DispatchStats {
+		static constexpr size_t kBuckets = 24;
+
+		SignalingEvent type = SignalingEvent::TRICKLE;
+
+		uint64_t dispatched = 0;
+
+		// events whose handle was gone by the time they were routed
+		uint64_t dropped = 0;
+
+		std::array<uint64_t, kBuckets> buckets{};
+
+		// Upper bound in us of the bucket holding the |p|-th percentile (0.0 ~ 1.0), -1 if nothing was dispatched yet
+		int64_t percentile(double p) const
+		{
+			if (dispatched == 0) {
+				return -1;
+			}
+			uint64_t rank = static_cast<uint64_t>(p * dispatched);
+			if (rank == 0) {
+				rank = 1;
+			}
+			uint64_t seen = 0;
+			for (size_t i = 0; i < kBuckets; ++i) {
+				seen += buckets[i];
+				if (seen >= rank) {
+					return int64_t(1) << i;
+				}
+			}
+			return int64_t(1) << (kBuckets - 1);
+		}
+	};
+}
@@ -7,7 +7,8 @@ namespace vi {
 
 	enum class EngineStatus {
 		CONNECTED = 0,
-		DISCONNECTED
+		DISCONNECTED,
+		RECONNECTING
 	};
 
 	class IEngineEventHandler
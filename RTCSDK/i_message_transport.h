@@ -8,26 +8,54 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include <functional>
+#include "transaction_stats.h"
+#include "connection_policy.h"
+#include "json/serialization_json.hpp"
 
 namespace vi {
-	using JCCallback = std::function<void(const std::string& json)>;
+	class JanusMessage;
+
+	using JCCallback = std::function<void(std::shared_ptr<JanusMessage> message)>;
+
+	// Serializes a request straight into the (recycled) output buffer of the connection
+	using PayloadWriter = std::function<void(std::string& payload)>;
 	
 	class IMessageTransportListener;
 
+	// A request that got no reply within |timeout| ms is failed with a synthesized 'error'
+	constexpr uint32_t kDefaultTransactionTimeout = 10000;
+
 	struct JCHandler {
-		JCHandler(std::string trans, std::shared_ptr<JCCallback> cb)
-		: transaction(trans)
+		JCHandler(uint64_t tid, std::string trans, RequestType rt, std::shared_ptr<JCCallback> cb, uint32_t ms = kDefaultTransactionTimeout)
+		: id(tid)
+		, transaction(trans)
+		, type(rt)
+		, timeout(ms)
 		, callback(cb) {
 
 		}
 
 		bool valid() {
-			return !transaction.empty() && nullptr != callback;
+			return id != 0 && !transaction.empty() && nullptr != callback;
+		}
+
+		// Requests on handles of the session outlive a dropped connection and are sent again once the session is claimed.
+		// Only the ones Janus can take twice: an attach or a plugin message (join, configure...) may have been
+		// carried out before the connection dropped, those are failed and left to the caller.
+		bool replayable() const {
+			return type == RequestType::DETACH || type == RequestType::TRICKLE || type == RequestType::HANGUP;
 		}
 
+		uint64_t id;
 		std::string transaction;
+		RequestType type;
+		uint32_t timeout;
 		std::shared_ptr<JCCallback> callback;
+
+		// the request itself, kept for replayable ones and only written out again when it is replayed
+		JsonBody request;
 	};
 
 	class IMessageTransport {
@@ -50,5 +78,17 @@ namespace vi {
 
 		virtual void send(const std::vector<uint8_t>& data, std::shared_ptr<JCHandler> handler) = 0;
 
+		virtual void send(const PayloadWriter& writer, std::shared_ptr<JCHandler> handler) = 0;
+
+		virtual std::vector<TransactionStats> transactionStats() = 0;
+
+		// Takes effect on the next connection
+		virtual void setConnectionPolicy(const ConnectionPolicy& policy) = 0;
+
+		// Sends the requests held since the connection dropped, once the session is claimed on the new one
+		virtual void replayPending() = 0;
+
+		// Fails the held requests, the session they belong to is gone
+		virtual void dropPending() = 0;
 	};
 }
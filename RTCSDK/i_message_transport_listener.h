@@ -7,20 +7,27 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 namespace vi {
+	class JanusMessage;
+
 	class IMessageTransportListener
 	{
 	public:
 		virtual ~IMessageTransportListener() {}
 
+		// Also after a reconnect
 		virtual void onOpened() = 0;
 
+		// The connection dropped and is being reestablished, replayable requests are held meanwhile
+		virtual void onLost(int errorCode, const std::string& reason) = 0;
+
 		virtual void onClosed() = 0;
 
 		virtual void onFailed(int errorCode, const std::string& reason) = 0;
 
-		virtual void onMessage(const std::string& json) = 0;
+		virtual void onMessage(std::shared_ptr<JanusMessage> message) = 0;
 
 	};
 }
\ No newline at end of file
@@ -7,8 +7,13 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <functional>
 #include "i_sfu_api_client_listener.h"
+#include "transaction_stats.h"
+#include "connection_policy.h"
+
+class JsonBody;
 
 namespace vi {
 	class CandidateData;
@@ -36,10 +41,18 @@ namespace vi {
 
 		virtual void detach(int64_t sessionId, int64_t handleId, std::shared_ptr<JCCallback> callback) = 0;
 
-		virtual void sendMessage(int64_t sessionId, int64_t handleId, const std::string& message, const std::string& jsep, std::shared_ptr<JCCallback> callback) = 0;
+		virtual void sendMessage(int64_t sessionId, int64_t handleId, const JsonBody& body, const JsonBody& jsep, std::shared_ptr<JCCallback> callback) = 0;
 
-		virtual void sendTrickleCandidate(int64_t sessionId, int64_t handleId, const CandidateData& candidate, std::shared_ptr<JCCallback> callback) = 0;
+		virtual void sendTrickleCandidate(int64_t sessionId, int64_t handleId, const std::vector<CandidateData>& candidates, std::shared_ptr<JCCallback> callback) = 0;
 
 		virtual void hangup(int64_t sessionId, int64_t handleId, std::shared_ptr<JCCallback> callback) = 0;
+
+		virtual std::vector<TransactionStats> transactionStats() = 0;
+
+		virtual void setConnectionPolicy(const ConnectionPolicy& policy) = 0;
+
+		virtual void replayPending() = 0;
+
+		virtual void dropPending() = 0;
 	};
 }
\ No newline at end of file
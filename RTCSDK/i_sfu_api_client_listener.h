@@ -17,10 +17,12 @@ namespace vi {
 
 		virtual void onOpened() = 0;
 
+		virtual void onLost(int errorCode, const std::string& reason) = 0;
+
 		virtual void onClosed() = 0;
 
 		virtual void onFailed(int errorCode, const std::string& reason) = 0;
 
-		virtual void onMessage(const std::string& json) = 0;
+		virtual void onMessage(std::shared_ptr<JanusMessage> message) = 0;
 	};
 }
\ No newline at end of file
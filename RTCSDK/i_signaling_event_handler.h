@@ -14,6 +14,8 @@
 #include "plugin_context.h"
 
 namespace vi {
+	class JanusMessage;
+	struct Jsep;
 
 	class ISignalingEventHandler
 	{
@@ -28,9 +30,9 @@ namespace vi {
 
 		virtual void onSlowLink(bool uplink, bool lost, const std::string& mid) = 0;
 
-		virtual void onTrickle(const std::string& trickle) = 0;
+		virtual void onTrickle(std::shared_ptr<JanusMessage> message) = 0;
 
-		virtual void onMessage(const std::string& data, const std::string& jsep) = 0;
+		virtual void onMessage(std::shared_ptr<JanusMessage> message, std::shared_ptr<Jsep> jsep) = 0;
 
 		virtual void onTimeout() = 0;
 
@@ -40,6 +42,9 @@ namespace vi {
 
 		virtual void onCleanup() = 0;
 
+		// The session got claimed back after the signaling connection dropped, the handle is still attached
+		virtual void onSessionResumed() = 0;
+
 		virtual void onDetached() = 0;
 	};
 }
@@ -6,6 +6,7 @@
 
 namespace vi {
 
+	// The requests are serialized when they go out on the signaling thread, they are not to be changed once handed over
 	class IVideoRoomApi {
 	public:
 		virtual ~IVideoRoomApi() = default;
@@ -53,6 +54,12 @@ namespace vi {
 
 		virtual void fetchParticipants(std::shared_ptr<vr::FetchParticipantsRequest> request, std::function<void(std::shared_ptr<vr::FetchParticipantsResponse>)> callback) = 0;
 
+		// View mode of the list requests, the response is decoded into views over the received message
+		// and is only valid while the callback runs, copy out whatever has to be kept
+		virtual void fetchRoomsListView(std::shared_ptr<vr::FetchRoomsListRequest> request, std::function<void(const vr::FetchRoomsListResponseView&)> callback) = 0;
+
+		virtual void fetchParticipantsView(std::shared_ptr<vr::FetchParticipantsRequest> request, std::function<void(const vr::FetchParticipantsResponseView&)> callback) = 0;
+
 	};
 
 }
\ No newline at end of file
@@ -8,14 +8,17 @@
 #include <iostream>
 #include "message_transport.h"
 #include "message_models.h"
-#include "utils/string_utils.h"
+#include "janus_message.h"
+#include "utils/transaction_id.h"
 #include "logger/logger.h"
 #include "rtc_base/thread.h"
 #include "logger/logger.h"
 
 namespace vi {
 
-	JanusApiClient::JanusApiClient(const std::string& callbackThreadName) : _callbackThreadName(callbackThreadName)
+	JanusApiClient::JanusApiClient(const std::string& callbackThreadName)
+		: _callbackThreadName(callbackThreadName)
+		, _callbackThread(TMgr->thread(callbackThreadName))
 	{
 		_transport = std::make_shared<MessageTransport>();
 	}
@@ -49,6 +52,7 @@ namespace vi {
 	void JanusApiClient::init()
 	{
 		_transport->addListener(shared_from_this());
+		_transport->init();
 	}
 
 	void JanusApiClient::connect(const std::string& url)
@@ -61,193 +65,192 @@ namespace vi {
 	{
 		JanusRequest request;
 		request.janus = "create";
-		request.transaction = StringUtils::randomString(12);
+		const TransactionId tid = TransactionId::next();
+		request.transaction = tid.str();
 		request.token = _token;
 		request.apisecret = _apisecret;
 
-		auto handler = std::make_shared<JCHandler>(request.transaction.value(), wrapAsyncCallback(callback));
+		auto handler = std::make_shared<JCHandler>(tid.value, request.transaction.value(), RequestType::CREATE, wrapAsyncCallback(callback));
 
-		std::string data = request.toJsonStr();
-
-		_transport->send(data, handler);
+		_transport->send([&request](std::string& payload) {
+			writeJson(request, payload);
+		}, handler);
 	}
 
 	void JanusApiClient::destroySession(int64_t sessionId, std::shared_ptr<JCCallback> callback) 
 	{
 		DestroyRequest request;
 		request.janus = "destroy";
-		request.transaction = StringUtils::randomString(12);
+		const TransactionId tid = TransactionId::next();
+		request.transaction = tid.str();
 		request.token = _token;
 		request.apisecret = _apisecret;
 		request.session_id = sessionId;
 
-		auto handler = std::make_shared<JCHandler>(request.transaction.value(), wrapAsyncCallback(callback));
-
-		std::string data = request.toJsonStr();
+		auto handler = std::make_shared<JCHandler>(tid.value, request.transaction.value(), RequestType::DESTROY, wrapAsyncCallback(callback));
 
-		_transport->send(data, handler);
+		_transport->send([&request](std::string& payload) {
+			writeJson(request, payload);
+		}, handler);
 	}
 
 	void JanusApiClient::reconnectSession(int64_t sessionId, std::shared_ptr<JCCallback> callback) 
 	{
 		ReconnectRequest request;
 		request.janus = "claim";
-		request.transaction = StringUtils::randomString(12);
+		const TransactionId tid = TransactionId::next();
+		request.transaction = tid.str();
 		request.token = _token;
 		request.apisecret = _apisecret;
 		request.session_id = sessionId;
 
-		auto handler = std::make_shared<JCHandler>(request.transaction.value(), wrapAsyncCallback(callback));
-
-		std::string data = request.toJsonStr();
+		auto handler = std::make_shared<JCHandler>(tid.value, request.transaction.value(), RequestType::CLAIM, wrapAsyncCallback(callback));
 
-		_transport->send(data, handler);
+		_transport->send([&request](std::string& payload) {
+			writeJson(request, payload);
+		}, handler);
 	}
 
 	void JanusApiClient::keepAlive(int64_t sessionId, std::shared_ptr<JCCallback> callback) 
 	{
 		KeepAliveRequest request;
 		request.janus = "keepalive";
-		request.transaction = StringUtils::randomString(12);
+		const TransactionId tid = TransactionId::next();
+		request.transaction = tid.str();
 		request.token = _token;
 		request.apisecret = _apisecret;
 		request.session_id = sessionId;
 
-		auto handler = std::make_shared<JCHandler>(request.transaction.value(), wrapAsyncCallback(callback));
+		auto handler = std::make_shared<JCHandler>(tid.value, request.transaction.value(), RequestType::KEEPALIVE, wrapAsyncCallback(callback));
 
-		std::string data = request.toJsonStr();
-
-		_transport->send(data, handler);
+		_transport->send([&request](std::string& payload) {
+			writeJson(request, payload);
+		}, handler);
 	}
 
 	void JanusApiClient::attach(int64_t sessionId, const std::string& plugin, const std::string& opaqueId, std::shared_ptr<JCCallback> callback)
 	{
 		AttachRequest request;
 		request.janus = "attach";
-		request.transaction = StringUtils::randomString(12);
+		const TransactionId tid = TransactionId::next();
+		request.transaction = tid.str();
 		request.token = _token;
 		request.apisecret = _apisecret;
 		request.session_id = sessionId;
 		request.plugin = plugin;
 		request.opaque_id = opaqueId;
 
-		auto handler = std::make_shared<JCHandler>(request.transaction.value(), wrapAsyncCallback(callback));
-
-		std::string data = request.toJsonStr();
+		auto handler = std::make_shared<JCHandler>(tid.value, request.transaction.value(), RequestType::ATTACH, wrapAsyncCallback(callback));
 
-		_transport->send(data, handler);
+		_transport->send([&request](std::string& payload) {
+			writeJson(request, payload);
+		}, handler);
 	}
 
 	void JanusApiClient::detach(int64_t sessionId, int64_t handleId, std::shared_ptr<JCCallback> callback) 
 	{
-		DetachRequest request;
-		request.janus = "detach";
-		request.transaction = StringUtils::randomString(12);
+		// shared with the handler, which writes it again if the request has to be replayed
+		auto request = std::make_shared<DetachRequest>();
+		request->janus = "detach";
+		const TransactionId tid = TransactionId::next();
+		request->transaction = tid.str();
+		request->token = _token;
+		request->apisecret = _apisecret;
+		request->session_id = sessionId;
+		request->handle_id = handleId;
+
+		auto handler = std::make_shared<JCHandler>(tid.value, request->transaction.value(), RequestType::DETACH, wrapAsyncCallback(callback));
+		handler->request = JsonBody::of(request);
+
+		_transport->send([&request](std::string& payload) {
+			writeJson(*request, payload);
+		}, handler);
+	}
+
+	void JanusApiClient::sendMessage(int64_t sessionId, int64_t handleId, const JsonBody& body, const JsonBody& jsep, std::shared_ptr<JCCallback> callback)
+	{
+		MessageRequest request;
+		request.janus = "message";
+		const TransactionId tid = TransactionId::next();
+		request.transaction = tid.str();
 		request.token = _token;
 		request.apisecret = _apisecret;
 		request.session_id = sessionId;
 		request.handle_id = handleId;
+		request.body = body;
+		if (!jsep.empty()) {
+			request.jsep = jsep;
+		}
 
-		auto handler = std::make_shared<JCHandler>(request.transaction.value(), wrapAsyncCallback(callback));
-
-		std::string data = request.toJsonStr();
+		auto handler = std::make_shared<JCHandler>(tid.value, request.transaction.value(), RequestType::MESSAGE, wrapAsyncCallback(callback));
 
-		_transport->send(data, handler);
+		_transport->send([&request](std::string& payload) {
+			writeJson(request, payload);
+		}, handler);
 	}
 
-	void JanusApiClient::sendMessage(int64_t sessionId, int64_t handleId, const std::string& message, const std::string& jsep, std::shared_ptr<JCCallback> callback)
+	void JanusApiClient::sendTrickleCandidate(int64_t sessionId, int64_t handleId, const std::vector<CandidateData>& candidates, std::shared_ptr<JCCallback> callback) 
 	{
-		if (jsep.empty()) {
-			MessageRequest request;
-			request.janus = "message";
-			request.transaction = StringUtils::randomString(12);
-			request.token = _token;
-			request.apisecret = _apisecret;
-			request.session_id = sessionId;
-			request.handle_id = handleId;
-			request.body = "#-MESSAGE-#";
-
-			auto handler = std::make_shared<JCHandler>(request.transaction.value(), wrapAsyncCallback(callback));
-
-			std::string data = request.toJsonStr();
-			DLOG("before replace, data = {}", data.c_str());
-			std::string tag("\"#-MESSAGE-#\"");
-			size_t pos = data.find(tag);
-			if (pos != std::string::npos) {
-				data = data.replace(pos, tag.length(), message);
-			}
-			DLOG("after replace, data = {}", data.c_str());
-			_transport->send(data, handler);
+		auto request = std::make_shared<TrickleRequest>();
+		request->janus = "trickle";
+		const TransactionId tid = TransactionId::next();
+		request->transaction = tid.str();
+		request->token = _token;
+		request->apisecret = _apisecret;
+		request->session_id = sessionId;
+		request->handle_id = handleId;
+		if (candidates.size() == 1) {
+			request->candidate = candidates.front();
 		}
 		else {
-			JsepRequest request;
-			request.janus = "message";
-			request.transaction = StringUtils::randomString(12);
-			request.token = _token;
-			request.apisecret = _apisecret;
-			request.session_id = sessionId;
-			request.handle_id = handleId;
-			request.body = "#-MESSAGE-#";
-			request.jsep = "#-JSEP-#";
-
-			auto handler = std::make_shared<JCHandler>(request.transaction.value(), wrapAsyncCallback(callback));
-
-			std::string data = request.toJsonStr();
-
-			DLOG("before replace, data = {}", data.c_str());
-
-			std::string tag("\"#-MESSAGE-#\"");
-			size_t pos = data.find(tag);
-			if (pos != std::string::npos) {
-				data = data.replace(pos, tag.length(), message);
-			}
-
-			tag = "\"#-JSEP-#\"";
-			pos = std::string::npos;
-			pos = data.find(tag);
-			if (pos != std::string::npos) {
-				data = data.replace(pos, tag.length(), jsep);
-			}
+			request->candidates = candidates;
+		}
 
-			DLOG("after replace, data = {}", data.c_str());
+		auto handler = std::make_shared<JCHandler>(tid.value, request->transaction.value(), RequestType::TRICKLE, wrapAsyncCallback(callback));
+		handler->request = JsonBody::of(request);
 
-			_transport->send(data, handler);
-		}
+		_transport->send([&request](std::string& payload) {
+			writeJson(*request, payload);
+		}, handler);
 	}
 
-	void JanusApiClient::sendTrickleCandidate(int64_t sessionId, int64_t handleId, const CandidateData& candidate, std::shared_ptr<JCCallback> callback) 
+	void JanusApiClient::hangup(int64_t sessionId, int64_t handleId, std::shared_ptr<JCCallback> callback) 
 	{
-		TrickleRequest request;
-		request.janus = "trickle";
-		request.transaction = StringUtils::randomString(12);
-		request.token = _token;
-		request.apisecret = _apisecret;
-		request.session_id = sessionId;
-		request.handle_id = handleId;
-		request.candidate = candidate;
-
-		auto handler = std::make_shared<JCHandler>(request.transaction.value(), wrapAsyncCallback(callback));
-
-		std::string data = request.toJsonStr();
-
-		_transport->send(data, handler);
+		auto request = std::make_shared<HangupRequest>();
+		request->janus = "hangup";
+		const TransactionId tid = TransactionId::next();
+		request->transaction = tid.str();
+		request->token = _token;
+		request->apisecret = _apisecret;
+		request->session_id = sessionId;
+		request->handle_id = handleId;
+
+		auto handler = std::make_shared<JCHandler>(tid.value, request->transaction.value(), RequestType::HANGUP, wrapAsyncCallback(callback));
+		handler->request = JsonBody::of(request);
+
+		_transport->send([&request](std::string& payload) {
+			writeJson(*request, payload);
+		}, handler);
 	}
 
-	void JanusApiClient::hangup(int64_t sessionId, int64_t handleId, std::shared_ptr<JCCallback> callback) 
+	std::vector<TransactionStats> JanusApiClient::transactionStats()
 	{
-		HangupRequest request;
-		request.janus = "hangup";
-		request.transaction = StringUtils::randomString(12);
-		request.token = _token;
-		request.apisecret = _apisecret;
-		request.session_id = sessionId;
-		request.handle_id = handleId;
+		return _transport->transactionStats();
+	}
 
-		auto handler = std::make_shared<JCHandler>(request.transaction.value(), wrapAsyncCallback(callback));
+	void JanusApiClient::setConnectionPolicy(const ConnectionPolicy& policy)
+	{
+		_transport->setConnectionPolicy(policy);
+	}
 
-		std::string data = request.toJsonStr();
+	void JanusApiClient::replayPending()
+	{
+		_transport->replayPending();
+	}
 
-		_transport->send(data, handler);
+	void JanusApiClient::dropPending()
+	{
+		_transport->dropPending();
 	}
 
 	void JanusApiClient::onOpened()
@@ -259,6 +262,15 @@ namespace vi {
 		});
 	}
 
+	void JanusApiClient::onLost(int errorCode, const std::string& reason)
+	{
+		UniversalObservable<ISfuApiClientListener>::notifyObservers([wself = weak_from_this(), errorCode, reason](const auto& observer) {
+			if (auto self = wself.lock()) {
+				observer->onLost(errorCode, reason);
+			}
+		});
+	}
+
 	void JanusApiClient::onClosed()
 	{
 		UniversalObservable<ISfuApiClientListener>::notifyObservers([wself = weak_from_this()](const auto& observer) {
@@ -277,24 +289,24 @@ namespace vi {
 		});
 	}
 
-	void JanusApiClient::onMessage(const std::string& json)
+	void JanusApiClient::onMessage(std::shared_ptr<JanusMessage> message)
 	{
-		UniversalObservable<ISfuApiClientListener>::notifyObservers([wself = weak_from_this(), json](const auto& observer) {
+		UniversalObservable<ISfuApiClientListener>::notifyObservers([wself = weak_from_this(), message](const auto& observer) {
 			if (auto self = wself.lock()) {
-				observer->onMessage(json);
+				observer->onMessage(message);
 			}
 		});
 	}
 
 	std::shared_ptr<JCCallback> JanusApiClient::wrapAsyncCallback(std::shared_ptr<JCCallback> callback)
 	{
-		auto lambda = [wself = weak_from_this(), callback](const std::string& json) {
+		auto lambda = [wself = weak_from_this(), callback](std::shared_ptr<JanusMessage> message) {
 			if (auto self = wself.lock()) {
 				if (callback) {
-					TMgr->thread(self->_callbackThreadName)->PostTask(RTC_FROM_HERE, [wself, callback, json]() {
+					self->_callbackThread->PostTask(RTC_FROM_HERE, [wself, callback, message]() {
 						if (auto self = wself.lock()) {
 							if (callback) {
-								(*callback)(json);
+								(*callback)(message);
 							}
 						}
 					});
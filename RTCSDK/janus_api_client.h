@@ -55,27 +55,38 @@ namespace vi {
 
 		void detach(int64_t sessionId, int64_t handleId, std::shared_ptr<JCCallback> callback) override;
 
-		void sendMessage(int64_t sessionId, int64_t handleId, const std::string& message, const std::string& jsep, std::shared_ptr<JCCallback> callback) override;
+		void sendMessage(int64_t sessionId, int64_t handleId, const JsonBody& body, const JsonBody& jsep, std::shared_ptr<JCCallback> callback) override;
 
-		void sendTrickleCandidate(int64_t sessionId, int64_t handleId, const CandidateData& candidate, std::shared_ptr<JCCallback> callback) override;
+		void sendTrickleCandidate(int64_t sessionId, int64_t handleId, const std::vector<CandidateData>& candidates, std::shared_ptr<JCCallback> callback) override;
 
 		void hangup(int64_t sessionId, int64_t handleId, std::shared_ptr<JCCallback> callback) override;
 
+		std::vector<TransactionStats> transactionStats() override;
+
+		void setConnectionPolicy(const ConnectionPolicy& policy) override;
+
+		void replayPending() override;
+
+		void dropPending() override;
+
 	protected:
 		// IMessageTransportListener
 		void onOpened() override;
 
+		void onLost(int errorCode, const std::string& reason) override;
+
 		void onClosed() override;
 
 		void onFailed(int errorCode, const std::string& reason) override;
 
-		void onMessage(const std::string& json) override;
+		void onMessage(std::shared_ptr<JanusMessage> message) override;
 
 	private:
 		std::shared_ptr<JCCallback> wrapAsyncCallback(std::shared_ptr<JCCallback> callback);
 
 	private:
 		std::string _callbackThreadName;
+		rtc::Thread* _callbackThread = nullptr;
 		std::string _url;
 		std::string _token;
 		std::string _apisecret;
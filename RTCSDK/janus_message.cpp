@@ -0,0 +1,79 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "janus_message.h"
+#include "rtc_base/time_utils.h"
+
+namespace vi {
+	std::shared_ptr<JanusMessage> JanusMessage::parse(const std::string& json, std::string& err)
+	{
+		return parse(std::string(json), err);
+	}
+
+	std::shared_ptr<JanusMessage> JanusMessage::parse(std::string&& json, std::string& err)
+	{
+		std::shared_ptr<JanusMessage> message(new JanusMessage());
+		message->_receivedAt = rtc::TimeMicros();
+		message->_buffer = std::move(json);
+
+		// the payload ends with the terminator std::string keeps after its data
+		message->_document.ParseInsitu(&message->_buffer[0]);
+		if (message->_document.HasParseError()) {
+			err = "parse error: " + std::to_string(message->_document.GetParseError());
+			return nullptr;
+		}
+
+		if (!message->_document.IsObject()) {
+			err = "not a json object";
+			return nullptr;
+		}
+
+		try {
+			message->_envelope.jdeserialize(message->_document);
+		}
+		catch (const JsonMissingKey& e) {
+			err = e.what();
+			return nullptr;
+		}
+		catch (const JsonTypeMismatch& e) {
+			err = e.what();
+			return nullptr;
+		}
+
+		return message;
+	}
+
+	std::shared_ptr<JanusMessage> JanusMessage::error(const std::string& transaction, int64_t code, const std::string& reason)
+	{
+		ErrorResponse response;
+		response.janus = "error";
+		response.transaction = transaction;
+		JanusError error;
+		error.code = code;
+		error.reason = reason;
+		response.error = error;
+
+		std::string err;
+		return parse(response.toJsonStr(), err);
+	}
+
+	const std::string& JanusMessage::raw() const
+	{
+		std::call_once(_rawOnce, [this]() {
+			rapidjson::StringBuffer buffer;
+			rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+			_document.Accept(writer);
+			_raw.assign(buffer.GetString(), buffer.GetSize());
+		});
+		return _raw;
+	}
+
+	bool JanusMessage::hasMember(const char* name) const
+	{
+		auto it = _document.FindMember(name);
+		return it != _document.MemberEnd() && !it->value.IsNull();
+	}
+}
@@ -0,0 +1,103 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <mutex>
+#include "message_models.h"
+#include "json/serialization_json.hpp"
+
+namespace vi {
+	// Error codes of replies synthesized on the client side, outside of the range used by the Janus core
+	constexpr int64_t kTransactionTimeoutError = 1001;
+
+	constexpr int64_t kTransportUnavailableError = 1002;
+
+	// A Janus message is parsed once per websocket frame, the DOM and the envelope are
+	// immutable afterwards and shared by the transport, signaling and plugin layers.
+	// The frame payload is moved in and parsed in situ: the strings of the DOM point into it,
+	// so receiving a message copies no bytes after the socket read, which fills one new buffer per frame.
+	class JanusMessage {
+	public:
+		// Takes over |json|, it is unescaped in place and no longer valid json afterwards
+		static std::shared_ptr<JanusMessage> parse(std::string&& json, std::string& err);
+
+		static std::shared_ptr<JanusMessage> parse(const std::string& json, std::string& err);
+
+		// A local 'error' reply for |transaction|, used when the server never answers
+		static std::shared_ptr<JanusMessage> error(const std::string& transaction, int64_t code, const std::string& reason);
+
+		// The message as json text, written from the DOM the first time it is asked for
+		const std::string& raw() const;
+
+		const rapidjson::Document& document() const { return _document; }
+
+		// 'janus', 'transaction', 'session_id' and 'sender'
+		const JanusResponse& envelope() const { return _envelope; }
+
+		bool hasMember(const char* name) const;
+
+		// rtc::TimeMicros() when the frame was parsed
+		int64_t receivedAt() const { return _receivedAt; }
+
+		// Deserializes the whole message into |Model|
+		template<typename Model>
+		std::shared_ptr<Model> to(std::string& err) const {
+			return fromJsonValue<Model>(_document, err);
+		}
+
+		// Deserializes the whole message into |model| in place, for the *View models whose strings
+		// point into the message and are valid only as long as it lives
+		template<typename Model>
+		bool decode(Model& model, std::string& err) const {
+			try {
+				model.jdeserialize(_document);
+			}
+			catch (const JsonMissingKey& e) {
+				err = e.what();
+				return false;
+			}
+			catch (const JsonTypeMismatch& e) {
+				err = e.what();
+				return false;
+			}
+			return true;
+		}
+
+		// Deserializes the root member |name| into |Model|, nullptr if it is missing or null
+		template<typename Model>
+		std::shared_ptr<Model> member(const char* name, std::string& err) const {
+			auto it = _document.FindMember(name);
+			if (it == _document.MemberEnd() || it->value.IsNull()) {
+				return nullptr;
+			}
+			return fromJsonValue<Model>(it->value, err);
+		}
+
+	private:
+		JanusMessage() = default;
+
+		JanusMessage(const JanusMessage&) = delete;
+
+		JanusMessage& operator=(const JanusMessage&) = delete;
+
+	private:
+		// the frame payload, owned for the DOM whose strings point into it, declared first so it goes last
+		std::string _buffer;
+
+		rapidjson::Document _document;
+
+		mutable std::once_flag _rawOnce;
+
+		mutable std::string _raw;
+
+		JanusResponse _envelope;
+
+		int64_t _receivedAt = 0;
+	};
+}
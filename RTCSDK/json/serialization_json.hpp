@@ -52,11 +52,13 @@
 #pragma once
 
 #include "absl/types/optional.h"
+#include "absl/strings/string_view.h"
 #include "stringable.hpp"
 #include <rapidjson/document.h>
 #include <rapidjson/writer.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/prettywriter.h>
+#include <memory>
 #include <iostream>
 #include <vector>
 #include <map>
@@ -154,53 +156,67 @@ inline rapidjson::Document stringToJson(const std::string& data) {
 namespace rapidjson {
 
 //deserialize native values.
+//|name| is only used to report mismatches, it stays a plain key until something is thrown.
 struct JsonValueAdapter {
-    void operator()(const Value& j, const std::string& name, int64_t& value) {
+    template<typename Name>
+    void operator()(const Value& j, const Name& name, int64_t& value) {
         if(false == j.IsInt64())
             throw JsonTypeMismatch(j, name);
         value = j.GetInt64();
     }
-    void operator()(const Value& j, const std::string& name, int& value) {
+    template<typename Name>
+    void operator()(const Value& j, const Name& name, int& value) {
         if(false == j.IsInt())
             throw JsonTypeMismatch(j, name);
         value = (int)j.GetInt();
     }
-    void operator()(const Value& j, const std::string& name, double& value) {
+    template<typename Name>
+    void operator()(const Value& j, const Name& name, double& value) {
         if(false == j.IsDouble())
             throw JsonTypeMismatch(j, name);
         value = j.GetDouble();
     }
-    void operator()(const Value& j, const std::string& name, float& value) {
+    template<typename Name>
+    void operator()(const Value& j, const Name& name, float& value) {
         if(false == j.IsDouble())
             throw JsonTypeMismatch(j, name);
         value = (float)j.GetDouble();
     }
-    void operator()(const Value& j, const std::string& name, std::string& value) {
+    template<typename Name>
+    void operator()(const Value& j, const Name& name, std::string& value) {
         if(false == j.IsString())
             throw JsonTypeMismatch(j, name);
-        value = j.GetString();
+        value.assign(j.GetString(), j.GetStringLength());
     }
-    void operator()(const Value& j, const std::string& name, bool& value) {
+    //references the string of the DOM, only valid as long as the document (e.g. of a JanusMessage) lives
+    template<typename Name>
+    void operator()(const Value& j, const Name& name, absl::string_view& value) {
+        if(false == j.IsString())
+            throw JsonTypeMismatch(j, name);
+        value = absl::string_view(j.GetString(), j.GetStringLength());
+    }
+    template<typename Name>
+    void operator()(const Value& j, const Name& name, bool& value) {
         if(false == j.IsBool())
             throw JsonTypeMismatch(j, name);
         value = j.GetBool();
     }
     //for container
-    template<typename Type>
-    void operator()(const Value& j, const std::string& name, std::vector<Type>& value) {
+    template<typename Name, typename Type>
+    void operator()(const Value& j, const Name& name, std::vector<Type>& value) {
         if(false == j.IsArray())
             throw JsonTypeMismatch(j, name);
         value.clear();
+        value.reserve(j.Size());
 		for (auto item = j.Begin(); j.End() != item; ++item) {
-            Type v;
-            JsonValueAdapter()(*item, name, v);
-            value.push_back(v);
+            value.emplace_back();
+            JsonValueAdapter()(*item, name, value.back());
         }
     }
     
     //for container
-    template<typename Type>
-    void operator()(const Value& j, const std::string& name, std::map<std::string, Type>& value) {
+    template<typename Name, typename Type>
+    void operator()(const Value& j, const Name& name, std::map<std::string, Type>& value) {
         if(false == j.IsObject())
             throw JsonTypeMismatch(j, name);
         value.clear();
@@ -224,6 +240,9 @@ struct JsonValueAdapter {
 	void set(Value& j, const std::string& value, Document::AllocatorType& alloc) {
 		j.SetString(value.c_str(), (SizeType)value.size());
 	}
+	void set(Value& j, absl::string_view value, Document::AllocatorType& alloc) {
+		j.SetString(value.data(), (SizeType)value.size());
+	}
 	void set(Value& j, const char* value, Document::AllocatorType& alloc) {
 		j.SetString(value, alloc);
 	}
@@ -321,14 +340,11 @@ struct JsonSerializer < Key, optional<Type> > {
         if (!jlist.IsObject()) {
             throw JsonTypeMismatch(jlist, name);
         }
-        if (jlist.HasMember(name)) {
-            auto memberV = jlist.FindMember(name);
-            if (!memberV->value.IsNull())
-            {
-                Type v;
-                json_deserialize(jlist, name, v);
-                value = v;
-            }
+        auto member = jlist.FindMember(name);
+        if (jlist.MemberEnd() != member && !member->value.IsNull()) {
+            //decode in place, nested models and vectors are not copied around
+            value.emplace();
+            json_deserialize(jlist, name, *value);
         }
     }
 };
@@ -353,10 +369,10 @@ struct JsonSerializerVector {
 //            throw JsonMissingKey(jlist, name);
         if(false == it->value.IsArray())
             throw JsonTypeMismatch(it->value, name);
+        value.reserve(it->value.Size());
 		for (auto jitem = it->value.Begin(); it->value.End() != jitem; ++jitem) {
-            typename Type::value_type v;
-            v.jdeserialize(*jitem);
-            value.push_back(v);
+            value.emplace_back();
+            value.back().jdeserialize(*jitem);
         }
     }
 };
@@ -458,6 +474,7 @@ struct is_native_type {
         std::is_floating_point<Type>::value ||
         //   std::is_same<Type, std::string>::value ||
         std::is_convertible<Type, std::string>::value ||
+        std::is_same<Type, absl::string_view>::value ||
         is_vector_of_native<Type>::value ||
         is_map_of_native<Type>::value;
 };
@@ -560,6 +577,103 @@ inline std::string toJsonString<rapidjson::Document>(const rapidjson::Document&
     return string_algo::to_string(json);
 }
 
+//rapidjson output stream appending to a caller owned string, which may be a recycled buffer.
+struct StringAppendStream {
+    typedef char Ch;
+    explicit StringAppendStream(std::string& s) : str(s) {}
+    void Put(char c) { str.push_back(c); }
+    void Flush() {}
+    std::string& str;
+};
+
+//per-thread scratch memory for writeJson(), the DOM and the writer stack live in a fixed buffer
+//which is rewound after every call, only documents outgrowing it fall back to the heap.
+class JsonScratch {
+public:
+    static constexpr size_t kBufferSize = 16 * 1024;
+
+    static JsonScratch& local() {
+        thread_local JsonScratch scratch;
+        return scratch;
+    }
+
+    rapidjson::MemoryPoolAllocator<>& allocator() { return _allocator; }
+
+    void rewind() { _allocator.Clear(); }
+
+private:
+    JsonScratch() : _allocator(_buffer, sizeof(_buffer)) {}
+
+    JsonScratch(const JsonScratch&) = delete;
+
+    JsonScratch& operator=(const JsonScratch&) = delete;
+
+    alignas(16) char _buffer[kBufferSize];
+
+    rapidjson::MemoryPoolAllocator<> _allocator;
+};
+
+//appends the compact json of |value| to |out| without building an intermediate string.
+template<typename Type>
+inline void writeJson(const Type& value, std::string& out) {
+    JsonScratch& scratch = JsonScratch::local();
+    {
+        rapidjson::Document json = value.jserialize(&scratch.allocator());
+        StringAppendStream stream(out);
+        rapidjson::Writer<StringAppendStream, rapidjson::UTF8<>, rapidjson::UTF8<>, rapidjson::MemoryPoolAllocator<>> writer(stream, &scratch.allocator());
+        json.Accept(writer);
+    }
+    scratch.rewind();
+}
+
+//a model carried by another one and serialized into its document, e.g. the plugin body of a janus
+//"message": it is written in the same pass as the request around it, no json text of its own is made.
+//copies share the model.
+class JsonBody {
+public:
+    JsonBody() = default;
+
+    //|model| is serialized when the request is sent, it is not to be changed afterwards
+    template<typename Model>
+    static JsonBody of(std::shared_ptr<Model> model) {
+        JsonBody body;
+        if (model) {
+            body._model = std::move(model);
+            body._serialize = &serialize<Model>;
+        }
+        return body;
+    }
+
+    template<typename Model>
+    static JsonBody of(Model model) {
+        return of(std::make_shared<const Model>(std::move(model)));
+    }
+
+    bool empty() const { return !_model; }
+
+    rapidjson::Document jserialize(rapidjson::Document::AllocatorType* allocator = nullptr) const {
+        if (!_model) {
+            rapidjson::Document json(allocator);
+            json.SetObject();
+            return json;
+        }
+        return _serialize(_model.get(), allocator);
+    }
+
+    //outgoing only
+    void jdeserialize(const rapidjson::Value& json) {}
+
+private:
+    template<typename Model>
+    static rapidjson::Document serialize(const void* model, rapidjson::Document::AllocatorType* allocator) {
+        return static_cast<const Model*>(model)->jserialize(allocator);
+    }
+
+    std::shared_ptr<const void> _model;
+
+    rapidjson::Document (*_serialize)(const void*, rapidjson::Document::AllocatorType*) = nullptr;
+};
+
 template<typename Type>
 inline std::shared_ptr<Type> fromJsonString(const std::string& data, bool bCheckValidObject = false) {
     std::shared_ptr<Type> object = std::make_shared<Type>();
@@ -593,6 +707,23 @@ inline std::shared_ptr<Type> fromJsonString(const std::string& data, std::string
     return object;
 }
 
+//deserialize from an already parsed value, so one DOM can feed several models without parsing again.
+template<typename Type>
+inline std::shared_ptr<Type> fromJsonValue(const rapidjson::Value& json, std::string& error) {
+    std::shared_ptr<Type> object = std::make_shared<Type>();
+    try {
+        object->jdeserialize(json);
+    }
+    catch (const JsonMissingKey& e) {
+        error = e.what();
+    }
+    catch (const JsonTypeMismatch& e) {
+        error = e.what();
+    }
+
+    return object;
+}
+
 
 
 
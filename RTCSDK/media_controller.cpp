@@ -4,6 +4,8 @@
 #include "pc/media_stream_proxy.h"
 #include "video_room_client.h"
 #include "video_room_api.h"
+#include "video_room_subscriber.h"
+#include "video_capture.h"
 #include "logger/logger.h"
 
 namespace vi {
@@ -109,6 +111,87 @@ namespace vi {
 		return false;
 	}
 
+	void MediaController::setRemoteVideoSize(int64_t pid, int32_t width, int32_t height, bool visible)
+	{
+		auto vrc = _vrc.lock();
+		if (!vrc) {
+			DLOG("Invalid video room client instance");
+			return;
+		}
+
+		// remote videos are identified by their mid on the subscriber connection
+		if (auto subscriber = vrc->subscriber()) {
+			subscriber->setRenderedSize(std::to_string(pid), width, height, visible);
+		}
+	}
+
+	void MediaController::setRemoteVideoVisible(int64_t pid, bool visible)
+	{
+		auto vrc = _vrc.lock();
+		if (!vrc) {
+			DLOG("Invalid video room client instance");
+			return;
+		}
+
+		if (auto subscriber = vrc->subscriber()) {
+			subscriber->setVisible(std::to_string(pid), visible);
+		}
+	}
+
+	void MediaController::setSimulcastLadder(const SimulcastLadder& ladder)
+	{
+		auto vrc = _vrc.lock();
+		if (!vrc) {
+			DLOG("Invalid video room client instance");
+			return;
+		}
+
+		vrc->setSimulcastLadder(ladder);
+		if (auto subscriber = vrc->subscriber()) {
+			subscriber->setPublisherLadder(ladder,
+				static_cast<int32_t>(CapturerTrackSource::kWidth),
+				static_cast<int32_t>(CapturerTrackSource::kHeight));
+		}
+	}
+
+	void MediaController::setSimulcastPreset(SimulcastPreset preset)
+	{
+		setSimulcastLadder(SimulcastLadder::preset(preset,
+			static_cast<int32_t>(CapturerTrackSource::kWidth),
+			static_cast<int32_t>(CapturerTrackSource::kHeight),
+			static_cast<int32_t>(CapturerTrackSource::kFps)));
+	}
+
+	void MediaController::setStatsConfig(const StatsConfig& config)
+	{
+		auto vrc = _vrc.lock();
+		if (!vrc) {
+			DLOG("Invalid video room client instance");
+			return;
+		}
+
+		vrc->setStatsConfig(config);
+		if (auto subscriber = vrc->subscriber()) {
+			subscriber->setStatsConfig(config);
+		}
+	}
+
+	std::vector<TrackStatsHistory> MediaController::trackStats()
+	{
+		auto vrc = _vrc.lock();
+		if (!vrc) {
+			DLOG("Invalid video room client instance");
+			return {};
+		}
+
+		std::vector<TrackStatsHistory> result = vrc->trackStats();
+		if (auto subscriber = vrc->subscriber()) {
+			auto remote = subscriber->trackStats();
+			result.insert(result.end(), std::make_move_iterator(remote.begin()), std::make_move_iterator(remote.end()));
+		}
+		return result;
+	}
+
 	void MediaController::onWebrtcStatus(bool isActive, const std::string& reason)
 	{
 		UniversalObservable<IMediaControlEventHandler>::notifyObservers([isActive, reason](const auto& observer) {
@@ -48,6 +48,18 @@ namespace vi {
 
         bool isVideoMuted(int64_t pid) override;
 
+        void setRemoteVideoSize(int64_t pid, int32_t width, int32_t height, bool visible) override;
+
+        void setRemoteVideoVisible(int64_t pid, bool visible) override;
+
+        void setSimulcastLadder(const SimulcastLadder& ladder) override;
+
+        void setSimulcastPreset(SimulcastPreset preset) override;
+
+        void setStatsConfig(const StatsConfig& config) override;
+
+        std::vector<TrackStatsHistory> trackStats() override;
+
         void onWebrtcStatus(bool isActive, const std::string& reason);
 
         void onLocalTrack(rtc::scoped_refptr<webrtc::MediaStreamTrackInterface> track, int64_t mid, bool on);
@@ -3,6 +3,8 @@
 #include <memory>
 #include <string>
 #include "weak_proxy.h"
+#include "simulcast_ladder.h"
+#include "track_stats.h"
 
 namespace vi {
 
@@ -36,6 +38,26 @@ namespace vi {
 		virtual void muteVideo(int64_t pid, const std::string& mid, bool mute) = 0;
 
 		virtual bool isVideoMuted(int64_t pid) = 0;
+
+		// Size in device pixels the remote video |pid| (as handed out by onCreateVideoTrack) is shown at,
+		// lets the SDK receive the smallest simulcast layer that still fills it
+		virtual void setRemoteVideoSize(int64_t pid, int32_t width, int32_t height, bool visible) = 0;
+
+		// Hidden remote videos are paused on the subscriber connection so nothing is received nor decoded for them
+		virtual void setRemoteVideoVisible(int64_t pid, bool visible) = 0;
+
+		// Encodings the local video is published with, applied without renegotiation once publishing.
+		// Remote videos are picked among the layers of the same ladder.
+		virtual void setSimulcastLadder(const SimulcastLadder& ladder) = 0;
+
+		// Same as setSimulcastLadder with a ladder derived from the capture format
+		virtual void setSimulcastPreset(SimulcastPreset preset) = 0;
+
+		// Poll interval and history length of the rtp stream stats of both the publisher and the subscriber connection
+		virtual void setStatsConfig(const StatsConfig& config) = 0;
+
+		// Last samples of every local and remote rtp stream
+		virtual std::vector<TrackStatsHistory> trackStats() = 0;
     };
 
 	BEGIN_WEAK_PROXY_MAP(MediaController)
@@ -52,5 +74,11 @@ namespace vi {
 		WEAK_PROXY_METHOD1(bool, isAudioMuted, int64_t)
 		WEAK_PROXY_METHOD3(void, muteVideo, int64_t, const std::string&, bool)
 		WEAK_PROXY_METHOD1(bool, isVideoMuted, int64_t)
+		WEAK_PROXY_METHOD4(void, setRemoteVideoSize, int64_t, int32_t, int32_t, bool)
+		WEAK_PROXY_METHOD2(void, setRemoteVideoVisible, int64_t, bool)
+		WEAK_PROXY_METHOD1(void, setSimulcastLadder, const SimulcastLadder&)
+		WEAK_PROXY_METHOD1(void, setSimulcastPreset, SimulcastPreset)
+		WEAK_PROXY_METHOD1(void, setStatsConfig, const StatsConfig&)
+		WEAK_PROXY_METHOD0(std::vector<TrackStatsHistory>, trackStats)
 	END_WEAK_PROXY_MAP()
 }
\ No newline at end of file
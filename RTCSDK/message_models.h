@@ -7,12 +7,39 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
 #include "json/jsonable.hpp"
 #include "absl/types/optional.h"
 
 
 namespace vi {
 
+	// Janus reports |unpublished| and |leaving| either as a feed id or as the string "ok"
+	// when the event refers to ourselves, "ok" is mapped to 0
+	struct TolerantId {
+		int64_t id = 0;
+
+		rapidjson::Document jserialize(rapidjson::Document::AllocatorType* allocator = nullptr) const {
+			rapidjson::Document j(allocator);
+			j.SetInt64(id);
+			return j;
+		}
+
+		void jdeserialize(const rapidjson::Value& j) {
+			if (j.IsInt64()) {
+				id = j.GetInt64();
+			}
+			else if (j.IsString()) {
+				id = std::strcmp(j.GetString(), "ok") == 0 ? 0 : std::strtoll(j.GetString(), nullptr, 10);
+			}
+			else {
+				throw JsonTypeMismatch(j, "id");
+			}
+		}
+	};
+
 	struct JanusRequest {
 		absl::optional<std::string> janus;
 		absl::optional<std::string> token;
@@ -45,6 +72,14 @@ namespace vi {
 		FIELDS_MAP("code", code, "reason", reason);
 	};
 
+	struct ErrorResponse {
+		absl::optional<std::string> janus;
+		absl::optional<std::string> transaction;
+		absl::optional<JanusError> error;
+
+		FIELDS_MAP("janus", janus, "transaction", transaction, "error", error);
+	};
+
 	struct JanusData {
 		absl::optional<std::string> videoroom;
 
@@ -217,8 +252,9 @@ namespace vi {
 		absl::optional<int64_t> session_id;
 		absl::optional<int64_t> handle_id;
 		absl::optional<CandidateData> candidate;
+		absl::optional<std::vector<CandidateData>> candidates;
 		
-		FIELDS_MAP("janus", janus, "token", token, "apisecret", apisecret, "transaction", transaction, "session_id", session_id, "handle_id", handle_id, "candidate", candidate);
+		FIELDS_MAP("janus", janus, "token", token, "apisecret", apisecret, "transaction", transaction, "session_id", session_id, "handle_id", handle_id, "candidate", candidate, "candidates", candidates);
 	};
 
 	struct TrickleResponse {
@@ -238,20 +274,9 @@ namespace vi {
 		absl::optional<std::string> transaction;
 		absl::optional<int64_t> session_id;
 		absl::optional<int64_t> handle_id;
-		absl::optional<std::string> body;
-		
-		FIELDS_MAP("janus", janus, "token", token, "apisecret", apisecret, "transaction", transaction, "session_id", session_id, "handle_id", handle_id, "body", body);
-	};
-
-	struct JsepRequest {
-		absl::optional<std::string> janus;
-		absl::optional<std::string> token;
-		absl::optional<std::string> apisecret;
-		absl::optional<std::string> transaction;
-		absl::optional<int64_t> session_id;
-		absl::optional<int64_t> handle_id;
-		absl::optional<std::string> body;
-		absl::optional<std::string> jsep;
+		// written in place from the plugin request and the sdp
+		absl::optional<JsonBody> body;
+		absl::optional<JsonBody> jsep;
 		
 		FIELDS_MAP("janus", janus, "token", token, "apisecret", apisecret, "transaction", transaction, "session_id", session_id, "handle_id", handle_id, "body", body, "jsep", jsep);
 	};
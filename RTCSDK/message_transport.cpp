@@ -6,17 +6,36 @@
 
 #include "message_transport.h"
 #include <iostream>
+#include <algorithm>
 #include "websocket/i_connection_listener.h"
 #include "websocket/websocket_endpoint.h"
+#include "websocket/unix_socket_endpoint.h"
 #include "i_message_transport_listener.h"
 #include "logger/logger.h"
 #include "message_models.h"
-#include "json/serialization_json.hpp"
+#include "janus_message.h"
+#include "transaction_registry.h"
+#include "utils/transaction_id.h"
+#include "utils/thread_provider.h"
+#include "rtc_base/helpers.h"
+
+namespace {
+	// the shift of the backoff stops growing here, the policy caps it long before
+	constexpr uint32_t kMaxBackoffShift = 16;
+
+	uint32_t backoff(const vi::ConnectionPolicy& policy, uint32_t attempt)
+	{
+		const uint64_t base = static_cast<uint64_t>(policy.initialBackoffMs) << std::min(attempt - 1, kMaxBackoffShift);
+		const uint32_t delay = static_cast<uint32_t>(std::min<uint64_t>(base, policy.maxBackoffMs));
+		// up to a quarter more, so clients dropped together do not come back in lockstep
+		return delay + rtc::CreateRandomId() % (delay / 4 + 1);
+	}
+}
 
 namespace vi {
 	MessageTransport::MessageTransport()
 	{
-		_websocket = std::make_shared<WebsocketEndpoint>();
+		_registry = std::make_unique<TransactionRegistry>();
 	}
 
 	MessageTransport::~MessageTransport()
@@ -26,17 +45,32 @@ namespace vi {
 
 	void MessageTransport::init()
 	{
+		_thread = TMgr->thread(NamedThread::MESSAGE_TRANSPORT);
 
+		_expiryTimer = Timers->scheduleRepeating(_thread, [wself = weak_from_this()]() {
+			if (auto self = wself.lock()) {
+				auto expired = self->_registry->expire();
+				if (!expired.empty()) {
+					WLOG("{} transaction(s) timed out", expired.size());
+					self->fail(std::move(expired), kTransactionTimeoutError, "transaction timeout");
+				}
+			}
+		}, 1000);
 	}
 
 	void MessageTransport::destroy()
 	{
-
+		if (auto timers = Timers) {
+			timers->cancel(_expiryTimer);
+			timers->cancel(_pingTimer.exchange(0));
+			timers->cancel(_reconnectTimer.exchange(0));
+		}
+		_expiryTimer = 0;
 	}
 
 	bool MessageTransport::isValid()
 	{
-		if (_websocket && _connectionId != -1) {
+		if (_endpoint && _connectionId != -1) {
 			return true;
 		}
 		return false;
@@ -56,73 +90,338 @@ namespace vi {
 	void MessageTransport::connect(const std::string& url)
 	{
 		_url = url;
-		if (_websocket) {
-			_connectionId = _websocket->connect(_url, shared_from_this(), "janus-protocol");
+		_closing = false;
+		_everOpened = false;
+
+		// unix:///path reaches a Janus on this host through its pfunix transport, anything else is a websocket url
+		const bool local = UnixSocketEndpoint::accepts(url);
+		if (!_endpoint || local != _local) {
+			if (local) {
+				_endpoint = std::make_shared<UnixSocketEndpoint>();
+			}
+			else {
+				_endpoint = std::make_shared<WebsocketEndpoint>(connectionPolicy().ioThreads);
+			}
+			_local = local;
+		}
+		open();
+	}
+
+	void MessageTransport::open()
+	{
+		if (!_endpoint) {
+			return;
+		}
+		const auto policy = connectionPolicy();
+		_connectionId = _endpoint->connect(_url, shared_from_this(), "janus-protocol", policy.pingIntervalMs > 0 ? policy.pongTimeoutMs : 0);
+		if (_connectionId == -1 && _reconnecting) {
+			if (_thread) {
+				_thread->PostTask(RTC_FROM_HERE, [wself = weak_from_this()]() {
+					if (auto self = wself.lock()) {
+						self->onDropped(-1, "connect initialization error", true);
+					}
+				});
+			}
 		}
 	}
 
 	void MessageTransport::disconnect()
 	{
+		_closing = true;
+		if (auto timers = Timers) {
+			timers->cancel(_pingTimer.exchange(0));
+			timers->cancel(_reconnectTimer.exchange(0));
+		}
+		dropPending();
 		if (isValid()) {
-			_websocket->close(_connectionId, websocketpp::close::status::normal, "");
+			_endpoint->close(_connectionId, websocketpp::close::status::normal, "");
 		}
 	}
 
 	void MessageTransport::send(const std::string& data, std::shared_ptr<JCHandler> handler)
 	{
-		if (isValid()) {
-			_websocket->sendText(_connectionId, data);
+		if (hold(handler)) {
+			return;
+		}
+		if (track(handler)) {
+			_endpoint->sendText(_connectionId, data);
 			DLOG("sendText: {}", data.c_str());
-			if (handler->valid()) {
-				std::lock_guard<std::mutex> locker(_callbackMutex);
-				_callbacksMap[handler->transaction] = handler->callback;
-			}
 		}
 	}
 
 	void MessageTransport::send(const std::vector<uint8_t>& data, std::shared_ptr<JCHandler> handler)
 	{
-		if (isValid()) {
-			_websocket->sendBinary(_connectionId, data);
-			if (handler->valid()) {
-				std::lock_guard<std::mutex> locker(_callbackMutex);
-				_callbacksMap[handler->transaction] = handler->callback;
+		if (track(handler)) {
+			_endpoint->sendBinary(_connectionId, data);
+		}
+	}
+
+	void MessageTransport::send(const PayloadWriter& writer, std::shared_ptr<JCHandler> handler)
+	{
+		if (hold(handler)) {
+			return;
+		}
+		if (track(handler)) {
+			_endpoint->sendText(_connectionId, writer);
+		}
+	}
+
+	std::vector<TransactionStats> MessageTransport::transactionStats()
+	{
+		return _registry->stats();
+	}
+
+	void MessageTransport::setConnectionPolicy(const ConnectionPolicy& policy)
+	{
+		std::lock_guard<std::mutex> lock(_policyMutex);
+		_policy = policy;
+	}
+
+	ConnectionPolicy MessageTransport::connectionPolicy()
+	{
+		std::lock_guard<std::mutex> lock(_policyMutex);
+		return _policy;
+	}
+
+	void MessageTransport::replayPending()
+	{
+		std::vector<std::shared_ptr<JCHandler>> held;
+		{
+			std::lock_guard<std::mutex> lock(_heldMutex);
+			_reconnecting = false;
+			held.swap(_held);
+		}
+
+		DLOG("replaying {} request(s)", held.size());
+		for (const auto& handler : held) {
+			if (track(handler)) {
+				_endpoint->sendText(_connectionId, [&handler](std::string& payload) {
+					writeJson(handler->request, payload);
+				});
 			}
 		}
 	}
 
-	// IConnectionListener
-	void MessageTransport::onOpen()
+	void MessageTransport::dropPending()
 	{
-		DLOG("opened");
+		std::vector<std::shared_ptr<JCHandler>> held;
+		{
+			std::lock_guard<std::mutex> lock(_heldMutex);
+			_reconnecting = false;
+			held.swap(_held);
+		}
+
+		if (!held.empty()) {
+			fail(std::move(held), kTransportUnavailableError, "session lost");
+		}
+	}
+
+	bool MessageTransport::hold(const std::shared_ptr<JCHandler>& handler)
+	{
+		if (!_reconnecting || !handler || !handler->valid() || !handler->replayable() || handler->request.empty()) {
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(_heldMutex);
+		// replayPending() may have run in between
+		if (!_reconnecting) {
+			return false;
+		}
+		_held.emplace_back(handler);
+		return true;
+	}
 
-		UniversalObservable<IMessageTransportListener>::notifyObservers([wself = weak_from_this()](const auto& observer) {
+	bool MessageTransport::track(std::shared_ptr<JCHandler> handler)
+	{
+		const bool tracked = handler && handler->valid();
+		if (!isValid()) {
+			if (tracked) {
+				fail({ handler }, kTransportUnavailableError, "transport unavailable");
+			}
+			return false;
+		}
+
+		// register before sending, the reply may come back before send() returns
+		if (tracked) {
+			if (auto displaced = _registry->add(handler)) {
+				WLOG("transaction {} displaced before it got a reply", displaced->transaction);
+				fail({ displaced }, kTransactionTimeoutError, "transaction timeout");
+			}
+		}
+		return true;
+	}
+
+	void MessageTransport::fail(std::vector<std::shared_ptr<JCHandler>> handlers, int64_t code, const std::string& reason)
+	{
+		if (_thread) {
+			_thread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), handlers = std::move(handlers), code, reason]() {
+				if (auto self = wself.lock()) {
+					for (const auto& handler : handlers) {
+						if (auto message = JanusMessage::error(handler->transaction, code, reason)) {
+							(*handler->callback)(message);
+						}
+					}
+				}
+			});
+		}
+	}
+
+	void MessageTransport::startPing()
+	{
+		const auto policy = connectionPolicy();
+		if (policy.pingIntervalMs == 0) {
+			return;
+		}
+
+		// websocket level pings, a dead peer shows up within interval + pong timeout instead of a tcp timeout
+		TimerId timer = Timers->scheduleRepeating(_thread, [wself = weak_from_this()]() {
 			if (auto self = wself.lock()) {
-				observer->onOpened();
+				if (self->isValid()) {
+					self->_endpoint->sendPing(self->_connectionId, "");
+				}
 			}
+		}, policy.pingIntervalMs);
+
+		Timers->cancel(_pingTimer.exchange(timer));
+	}
+
+	void MessageTransport::stopPing()
+	{
+		if (auto timers = Timers) {
+			timers->cancel(_pingTimer.exchange(0));
+		}
+	}
+
+	void MessageTransport::onDropped(int code, const std::string& reason, bool failed)
+	{
+		stopPing();
+
+		if (_closing || !_everOpened) {
+			_connectionId = -1;
+			auto pending = _registry->clear();
+			if (!pending.empty()) {
+				fail(std::move(pending), kTransportUnavailableError, "transport closed");
+			}
+			UniversalObservable<IMessageTransportListener>::notifyObservers([wself = weak_from_this(), failed, code, reason](const auto& observer) {
+				if (auto self = wself.lock()) {
+					if (failed) {
+						observer->onFailed(code, reason);
+					}
+					else {
+						observer->onClosed();
+					}
+				}
+			});
+			return;
+		}
+
+		// sends from now on are held, then the ones in flight are moved over in front of them
+		_reconnecting = true;
+		_connectionId = -1;
+
+		auto pending = _registry->clear();
+		std::sort(pending.begin(), pending.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs->id < rhs->id;
 		});
+		std::vector<std::shared_ptr<JCHandler>> lost;
+		{
+			std::lock_guard<std::mutex> lock(_heldMutex);
+			auto it = _held.begin();
+			for (auto& handler : pending) {
+				if (handler->replayable() && !handler->request.empty()) {
+					it = std::next(_held.insert(it, std::move(handler)));
+				}
+				else {
+					lost.emplace_back(std::move(handler));
+				}
+			}
+		}
+		if (!lost.empty()) {
+			fail(std::move(lost), kTransportUnavailableError, "transport closed");
+		}
+
+		const auto policy = connectionPolicy();
+		++_attempt;
+		if (policy.maxAttempts > 0 && _attempt > policy.maxAttempts) {
+			WLOG("giving up reconnecting after {} attempt(s)", policy.maxAttempts);
+			_attempt = 0;
+			_everOpened = false;
+			dropPending();
+			UniversalObservable<IMessageTransportListener>::notifyObservers([wself = weak_from_this()](const auto& observer) {
+				if (auto self = wself.lock()) {
+					observer->onClosed();
+				}
+			});
+			return;
+		}
+
+		if (_attempt == 1) {
+			UniversalObservable<IMessageTransportListener>::notifyObservers([wself = weak_from_this(), code, reason](const auto& observer) {
+				if (auto self = wself.lock()) {
+					observer->onLost(code, reason);
+				}
+			});
+		}
+
+		const uint32_t delay = backoff(policy, _attempt);
+		ILOG("reconnecting in {} ms, attempt {}", delay, _attempt);
+		TimerId timer = Timers->schedule(_thread, [wself = weak_from_this()]() {
+			if (auto self = wself.lock()) {
+				self->_reconnectTimer = 0;
+				if (!self->_closing) {
+					self->open();
+				}
+			}
+		}, delay);
+
+		Timers->cancel(_reconnectTimer.exchange(timer));
+	}
+
+	// IConnectionListener
+	void MessageTransport::onOpen()
+	{
+		DLOG("opened");
+
+		if (_thread) {
+			_thread->PostTask(RTC_FROM_HERE, [wself = weak_from_this()]() {
+				if (auto self = wself.lock()) {
+					self->_everOpened = true;
+					self->_attempt = 0;
+					self->startPing();
+					self->UniversalObservable<IMessageTransportListener>::notifyObservers([wself](const auto& observer) {
+						if (auto self = wself.lock()) {
+							observer->onOpened();
+						}
+					});
+				}
+			});
+		}
 	}
 
 	void MessageTransport::onFail(int errorCode, const std::string& reason)
 	{
 		DLOG("errorCode = {}, reason = {}", errorCode, reason.c_str());
 
-		UniversalObservable<IMessageTransportListener>::notifyObservers([wself = weak_from_this(), errorCode, reason](const auto& observer) {
-			if (auto self = wself.lock()) {
-				observer->onFailed(errorCode, reason);
-			}
-		});
+		if (_thread) {
+			_thread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), errorCode, reason]() {
+				if (auto self = wself.lock()) {
+					self->onDropped(errorCode, reason, true);
+				}
+			});
+		}
 	}
 
 	void MessageTransport::onClose(int closeCode, const std::string& reason)
 	{
 		DLOG("errorCode = {}, reaseon = {}", closeCode, reason.c_str());
 
-		UniversalObservable<IMessageTransportListener>::notifyObservers([wself = weak_from_this()](const auto& observer) {
-			if (auto self = wself.lock()) {
-				observer->onClosed();
-			}
-		});
+		if (_thread) {
+			_thread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), closeCode, reason]() {
+				if (auto self = wself.lock()) {
+					self->onDropped(closeCode, reason, false);
+				}
+			});
+		}
 	}
 
 	bool MessageTransport::onValidate()
@@ -131,64 +430,42 @@ namespace vi {
 		return true;
 	}
 
-	void MessageTransport::onTextMessage(const std::string& json)
+	void MessageTransport::onTextMessage(std::string&& json)
 	{
 		DLOG("json = {}", json.c_str());
 
-		// |unpublished| can be int or string, replace string 'ok' to 0
-		std::string data = json;
-
-		// TODO: remove workaround
-		std::string tag1("\"unpublished\": \"ok\"");
-		size_t pos = data.find(tag1);
-		if (pos != std::string::npos) {
-			data = data.replace(pos, tag1.length(), "\"unpublished\": 0");
-		}
-
-		std::string tag2("\"leaving\": \"ok\"");
-		pos = data.find(tag2);
-		if (pos != std::string::npos) {
-			data = data.replace(pos, tag2.length(), "\"leaving\": 0");
-		}
-
 		std::string err;
-		auto response = fromJsonString<JanusResponse>(data, err);
-
-		if (!err.empty()) {
-			DLOG("parse JanusResponse failed");
+		auto message = JanusMessage::parse(std::move(json), err);
+		if (!message) {
+			DLOG("parse JanusResponse failed: {}", err);
 			return;
 		}
 
-		if (!response->janus) {
+		const auto& response = message->envelope();
+		if (!response.janus) {
 			DLOG("could not find 'janus' in response");
 			return;
 		}
 
-		if (response->transaction && (response->janus.value_or("") == "ack"
-			|| response->janus.value_or("") == "success"
-			|| response->janus.value_or("") == "error"
-			|| response->janus.value_or("") == "server_info")) {
-			if (auto thread = TMgr->thread("message-transport")) {
-				TMgr->thread("message-transport")->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), response, data]() {
+		const std::string& janus = response.janus.value();
+		if (response.transaction && (janus == "ack" || janus == "success" || janus == "error" || janus == "server_info")) {
+			auto handler = _registry->take(TransactionId::parse(response.transaction.value()));
+			if (!handler) {
+				DLOG("no pending transaction: {}", response.transaction.value());
+				return;
+			}
+			if (_thread) {
+				_thread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), handler, message]() {
 					if (auto self = wself.lock()) {
-						std::lock_guard<std::mutex> locker(self->_callbackMutex);
-						const std::string& transaction = response->transaction.value();
-						if (self->_callbacksMap.find(transaction) != self->_callbacksMap.end()) {
-							std::shared_ptr<JCCallback> callback = self->_callbacksMap[transaction];
-							if (callback) {
-								(*callback)(data);
-							}
-							self->_callbacksMap.erase(transaction);
-						}
+						(*handler->callback)(message);
 					}
 				});
 			}
-
 		}
 		else {
-			UniversalObservable<IMessageTransportListener>::notifyObservers([wself = weak_from_this(), data](const auto& observer) {
+			UniversalObservable<IMessageTransportListener>::notifyObservers([wself = weak_from_this(), message](const auto& observer) {
 				if (auto self = wself.lock()) {
-					observer->onMessage(data);
+					observer->onMessage(message);
 				}
 			});
 		}
@@ -212,6 +489,11 @@ namespace vi {
 
 	void MessageTransport::onPongTimeout(const std::string& text)
 	{
-		DLOG("text = {}", text.c_str());
+		WLOG("no pong within {} ms, dropping the connection", connectionPolicy().pongTimeoutMs);
+
+		// the close handshake is bounded by the pong timeout as well, onClose() follows either way
+		if (isValid()) {
+			_endpoint->close(_connectionId, websocketpp::close::status::going_away, "pong timeout");
+		}
 	}
 }
\ No newline at end of file
@@ -8,13 +8,18 @@
 
 #include <memory>
 #include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <functional>
 #include "i_message_transport.h"
-#include <unordered_map>
 #include "websocket/i_connection_listener.h"
-#include "websocket/websocket_endpoint.h"
+#include "websocket/i_connection_endpoint.h"
 #include "utils/universal_observable.hpp"
+#include "utils/timer_service.h"
 
 namespace vi {
+	class TransactionRegistry;
 	class MessageTransport
 		: public IMessageTransport
 		, public IConnectionListener
@@ -43,6 +48,16 @@ namespace vi {
 		
 		void send(const std::vector<uint8_t>& data, std::shared_ptr<JCHandler> handler) override;
 
+		void send(const PayloadWriter& writer, std::shared_ptr<JCHandler> handler) override;
+
+		std::vector<TransactionStats> transactionStats() override;
+
+		void setConnectionPolicy(const ConnectionPolicy& policy) override;
+
+		void replayPending() override;
+
+		void dropPending() override;
+
 	protected:
 		// IConnectionListener implement
 		void onOpen() override;
@@ -53,7 +68,7 @@ namespace vi {
 
 		bool onValidate() override;
 
-		void onTextMessage(const std::string& text) override;
+		void onTextMessage(std::string&& text) override;
 
 		void onBinaryMessage(const std::vector<uint8_t>& data) override;
 
@@ -66,15 +81,65 @@ namespace vi {
 	private:
 		bool isValid();
 
+		bool track(std::shared_ptr<JCHandler> handler);
+
+		void fail(std::vector<std::shared_ptr<JCHandler>> handlers, int64_t code, const std::string& reason);
+
+		// Keeps |handler| for replayPending() if the connection is being reestablished and it carries its request
+		bool hold(const std::shared_ptr<JCHandler>& handler);
+
+		void open();
+
+		// Runs on _thread, a connection that never opened or got closed by disconnect() ends for good,
+		// any other one is reestablished with backoff while the replayable requests in flight are held
+		void onDropped(int code, const std::string& reason, bool failed);
+
+		void startPing();
+
+		void stopPing();
+
+		ConnectionPolicy connectionPolicy();
+
 	private:
 		std::string _url;
 
-		int _connectionId = -1;
+		std::atomic<int> _connectionId{ -1 };
+
+		std::mutex _policyMutex;
+
+		ConnectionPolicy _policy;
+
+		// set by disconnect(), a drop is then not recovered
+		std::atomic<bool> _closing{ false };
+
+		// a connection opened since connect(), later drops are recovered
+		std::atomic<bool> _everOpened{ false };
+
+		// from the drop until replayPending()/dropPending()
+		std::atomic<bool> _reconnecting{ false };
+
+		// failed attempts since the last open, touched on _thread only
+		uint32_t _attempt = 0;
+
+		std::mutex _heldMutex;
+
+		// replayable requests waiting for the session to be claimed, in sending order
+		std::vector<std::shared_ptr<JCHandler>> _held;
+
+		std::atomic<TimerId> _pingTimer{ 0 };
+
+		std::atomic<TimerId> _reconnectTimer{ 0 };
+
+		// picked by the scheme of the url in connect()
+		std::shared_ptr<IConnectionEndpoint> _endpoint;
+
+		bool _local = false;
 
-		std::shared_ptr<WebsocketEndpoint> _websocket;
+		std::unique_ptr<TransactionRegistry> _registry;
 
-		std::mutex _callbackMutex;
+		TimerId _expiryTimer = 0;
 
-		std::unordered_map<std::string, std::shared_ptr<JCCallback>> _callbacksMap;
+		// resolved in init(), replies and failures are delivered on it
+		rtc::Thread* _thread = nullptr;
 	};
 }
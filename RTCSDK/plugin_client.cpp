@@ -5,7 +5,6 @@
  **/
 
 #include "plugin_client.h"
-#include "utils/task_scheduler.h"
 #include "utils/thread_provider.h"
 #include "logger/logger.h"
 #include "helper_utils.h"
@@ -26,9 +25,10 @@
 #include "logger/logger.h"
 #include "service/rtc_engine.h"
 #include "utils/thread_provider.h"
-#include "utils/task_scheduler.h"
 #include "message_models.h"
+#include "janus_message.h"
 #include "utils/sdp_utils.h"
+#include "stats_collector.h"
 #include "absl/types/optional.h"
 
 namespace vi {
@@ -36,7 +36,11 @@ namespace vi {
 	{
 		_pluginContext = std::make_shared<PluginContext>(sc, pcf);
 
-		_rtcStatsTaskScheduler = TaskScheduler::create();
+		_statsCollector = std::make_shared<StatsCollector>(StatsConfig().historySize);
+
+		_serviceThread = TMgr->thread(NamedThread::PLUGIN_CLIENT);
+
+		_statsThread = TMgr->thread(NamedThread::STATS_COLLECTOR);
 	}
 
 	PluginClient::~PluginClient()
@@ -91,7 +95,7 @@ namespace vi {
 	void PluginClient::sendMessage(std::shared_ptr<MessageEvent> event)
 	{
 		if (auto sc = _pluginContext->signalingClient.lock()) {
-			if (sc->sessionStatus() == SessionStatus::CONNECTED) {
+			if (acceptsRequests(sc->sessionStatus())) {
 				sc->sendMessage(_pluginContext->handleId, event);
 			}
 		}
@@ -100,7 +104,7 @@ namespace vi {
 	void PluginClient::hangup(bool sendRequest)
 	{
 		if (auto sc = _pluginContext->signalingClient.lock()) {
-			if (sc->sessionStatus() == SessionStatus::CONNECTED) {
+			if (acceptsRequests(sc->sessionStatus())) {
 				sc->hangup(_pluginContext->handleId, sendRequest);
 			}
 		}
@@ -115,56 +119,126 @@ namespace vi {
 		}
 	}
 
-	void PluginClient::startRtcStatsReport()
+	void PluginClient::setTrickleBatching(uint32_t windowMs, uint32_t batchSize)
 	{
-		_rtcStatsTaskId = _rtcStatsTaskScheduler->schedule([wself = weak_from_this()]() {
-			auto self = wself.lock();
-			if (!self) {
-				return;
+		_serviceThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), windowMs, batchSize]() {
+			if (auto self = wself.lock()) {
+				self->_pluginContext->trickleWindowMs = windowMs;
+				self->_pluginContext->trickleBatchSize = batchSize > 0 ? batchSize : 1;
 			}
+		});
+	}
 
-			const auto& context = self->_pluginContext;
-			if (!context->statsObserver) {
-				context->statsObserver = StatsObserver::create();
+	void PluginClient::setSimulcastLadder(const SimulcastLadder& ladder)
+	{
+		_serviceThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), ladder]() {
+			if (auto self = wself.lock()) {
+				self->_pluginContext->simulcastLadder = ladder;
+				self->applySimulcastLadder();
+			}
+		});
+	}
 
-				auto socb = std::make_shared<StatsCallback>([wself](const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report) {
-					DLOG("RTC Stats Report: {}", report->ToJson());
-					auto self = wself.lock();
-					if (!self) {
-						return;
-					}
+	void PluginClient::applySimulcastLadder()
+	{
+		const auto& context = _pluginContext;
+		if (!context->pc) {
+			return;
+		}
 
-					auto sc = self->pluginContext()->signalingClient.lock();
-					if (!sc) {
-						return;
-					}
+		for (const auto& sender : context->pc->GetSenders()) {
+			if (!sender->track() || sender->track()->kind() != webrtc::MediaStreamTrackInterface::kVideoKind) {
+				continue;
+			}
+			webrtc::RtpParameters params = sender->GetParameters();
+			// a single encoding is not simulcast, leave its limits to the encoder
+			if (params.encodings.size() < 2 || !context->simulcastLadder.applyTo(params)) {
+				continue;
+			}
+			webrtc::RTCError error = sender->SetParameters(params);
+			if (!error.ok()) {
+				WLOG("Applying the simulcast ladder failed: {}", error.message());
+			}
+		}
+	}
 
-					if (sc->sessionStatus() !=SessionStatus::CONNECTED) {
-						return;
-					}
+	void PluginClient::setStatsConfig(const StatsConfig& config)
+	{
+		_statsIntervalMs = config.intervalMs;
+		_statsCollector->setHistorySize(config.historySize);
+		if (_statsTimer.load() != 0) {
+			startRtcStatsReport();
+		}
+	}
 
-					auto eventHandlerThread = TMgr->thread("message-transport");
-					eventHandlerThread->PostTask(RTC_FROM_HERE, [wself, report]() {
-						if (auto self = wself.lock()) {
-							self->onStatsDelivered(report);
-						}
-					});
-				});
-				context->statsObserver->setCallback(socb);
-			}
-			if (context->pc) {
-				context->pc->GetStats(context->statsObserver.get());
+	void PluginClient::startRtcStatsReport()
+	{
+		const TimerId timer = Timers->scheduleRepeating(_serviceThread, [wself = weak_from_this()]() {
+			if (auto self = wself.lock()) {
+				self->pollStats();
 			}
-		}, 5000, true);
+		}, _statsIntervalMs.load());
+		Timers->cancel(_statsTimer.exchange(timer));
 	}
 
 	void PluginClient::stopRtcStatsReport()
 	{
-		if (_rtcStatsTaskScheduler) {
-			_rtcStatsTaskScheduler->cancelAll();
+		const TimerId timer = _statsTimer.exchange(0);
+		if (timer == 0) {
+			return;
+		}
+		if (auto timers = Timers) {
+			timers->cancel(timer);
 		}
 	}
 
+	std::vector<TrackStatsHistory> PluginClient::trackStats()
+	{
+		return _statsCollector->history();
+	}
+
+	void PluginClient::pollStats()
+	{
+		const auto& context = _pluginContext;
+		auto sc = context->signalingClient.lock();
+		if (!context->pc || !sc || !acceptsRequests(sc->sessionStatus())) {
+			return;
+		}
+
+		if (!context->statsObserver) {
+			context->statsObserver = StatsObserver::create();
+
+			// delivered on the webrtc signaling thread, the report is only read by the collector
+			auto socb = std::make_shared<StatsCallback>([collector = _statsCollector, thread = _statsThread](const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report) {
+				thread->PostTask(RTC_FROM_HERE, [collector, report]() {
+					collector->ingest(*report);
+				});
+			});
+			context->statsObserver->setCallback(socb);
+		}
+
+		// the peer connection is taken here, where cleanupWebrtc() releases it; its proxy calls block
+		// on the webrtc signaling thread, so they are made from the stats thread
+		_statsThread->PostTask(RTC_FROM_HERE, [collector = _statsCollector, pc = context->pc, observer = context->statsObserver]() {
+			std::unordered_map<std::string, std::string> mids;
+			for (const auto& transceiver : pc->GetTransceivers()) {
+				const auto mid = transceiver->mid();
+				if (!mid) {
+					continue;
+				}
+				if (auto track = transceiver->receiver()->track()) {
+					mids[track->id()] = *mid;
+				}
+				if (auto track = transceiver->sender()->track()) {
+					mids[track->id()] = *mid;
+				}
+			}
+			collector->setTrackMids(std::move(mids));
+
+			pc->GetStats(observer.get());
+		});
+	}
+
 	void PluginClient::sendSdp()
 	{
 		DLOG("Sending offer/answer SDP...");
@@ -462,26 +536,7 @@ namespace vi {
 					init.direction = webrtc::RtpTransceiverDirection::kSendRecv;
 					init.stream_ids = { stream->id() };
 
-					webrtc::RtpEncodingParameters ph;
-					ph.rid = "h";
-					ph.active = true;
-					ph.max_bitrate_bps = 900000;
-
-					webrtc::RtpEncodingParameters pm;
-					pm.rid = "m";
-					pm.active = true;
-					pm.max_bitrate_bps = 300000;
-					pm.scale_resolution_down_by = 2;
-
-					webrtc::RtpEncodingParameters pl;
-					pl.rid = "m";
-					pl.active = true;
-					pl.max_bitrate_bps = 100000;
-					pl.scale_resolution_down_by = 4;
-
-					init.send_encodings.emplace_back(ph);
-					init.send_encodings.emplace_back(pm);
-					init.send_encodings.emplace_back(pl);
+					init.send_encodings = context->simulcastLadder.toEncodings();
 
 					context->pc->AddTransceiver(track, init);
 				}
@@ -495,7 +550,7 @@ namespace vi {
 				DLOG("Data channel created by Janus.");
 				if (auto self = wself.lock()) {
 					// should be called in SERVICE thread
-					TMgr->thread("plugin-client")->PostTask(RTC_FROM_HERE, [wself, dataChannel]() {
+					self->_serviceThread->PostTask(RTC_FROM_HERE, [wself, dataChannel]() {
 						if (auto self = wself.lock()) {
 							self->createDataChannel(dataChannel->label(), dataChannel);
 						}
@@ -557,7 +612,7 @@ namespace vi {
 				context->candidates.clear();
 				if (auto self = wself.lock()) {
 					// should be called in SERVICE thread
-					TMgr->thread("plugin-client")->PostTask(RTC_FROM_HERE, [wself, event]() {
+					self->_serviceThread->PostTask(RTC_FROM_HERE, [wself, event]() {
 						if (auto self = wself.lock()) {
 							self->_createAnswer(event);
 						}
@@ -1172,40 +1227,6 @@ namespace vi {
 
 		bool sendVideo = HelperUtils::isVideoSendEnabled(media);
 
-		if (sendVideo && simulcast) {
-			std::vector<rtc::scoped_refptr<webrtc::RtpSenderInterface>> senders = context->pc->GetSenders();
-			rtc::scoped_refptr<webrtc::RtpSenderInterface> sender;
-			for (auto& s : senders) {
-				if (s->track()->kind() == webrtc::MediaStreamTrackInterface::kVideoKind) {
-					sender = s;
-				}
-			}
-			if (sender) {
-				webrtc::RtpParameters params = sender->GetParameters();
-				webrtc::RtpEncodingParameters ph;
-				ph.rid = "h";
-				ph.active = true;
-				ph.max_bitrate_bps = 900000;
-
-				webrtc::RtpEncodingParameters pm;
-				pm.rid = "m";
-				pm.active = true;
-				pm.max_bitrate_bps = 300000;
-				pm.scale_resolution_down_by = 2;
-
-				webrtc::RtpEncodingParameters pl;
-				pl.rid = "m";
-				pl.active = true;
-				pl.max_bitrate_bps = 100000;
-				pl.scale_resolution_down_by = 4;
-
-				params.encodings.emplace_back(ph);
-				params.encodings.emplace_back(pm);
-				params.encodings.emplace_back(pl);
-
-				sender->SetParameters(params);
-			}
-		}
 		std::unique_ptr<CreateSessionDescObserver> createOfferObserver;
 		createOfferObserver.reset(new rtc::RefCountedObject<CreateSessionDescObserver>());
 
@@ -1227,8 +1248,17 @@ namespace vi {
 
 			SetSessionDescObserver* ssdo(new rtc::RefCountedObject<SetSessionDescObserver>());
 
-			ssdo->setSuccessCallback(std::make_shared<SetSessionDescSuccessCallback>([]() {
+			ssdo->setSuccessCallback(std::make_shared<SetSessionDescSuccessCallback>([wself, sendVideo, simulcast]() {
 				DLOG("Set session description success.");
+				auto self = wself.lock();
+				if (self && sendVideo && simulcast) {
+					// the simulcast encodings exist once the local description is applied
+					self->_serviceThread->PostTask(RTC_FROM_HERE, [wself]() {
+						if (auto self = wself.lock()) {
+							self->applySimulcastLadder();
+						}
+					});
+				}
 			}));
 
 			ssdo->setFailureCallback(std::make_shared<SetSessionDescFailureCallback>([event, wself](webrtc::RTCError error) {
@@ -1312,38 +1342,6 @@ namespace vi {
 
 		bool sendVideo = HelperUtils::isVideoSendEnabled(media);
 
-		if (sendVideo && simulcast) {
-			DLOG("Enabling Simulcasting");
-			std::vector<rtc::scoped_refptr<webrtc::RtpSenderInterface>> senders = context->pc->GetSenders();
-			rtc::scoped_refptr<webrtc::RtpSenderInterface> sender = senders[1];
-
-			if (sender) {
-				webrtc::RtpParameters params = sender->GetParameters();
-				webrtc::RtpEncodingParameters ph;
-				ph.rid = "h";
-				ph.active = true;
-				ph.max_bitrate_bps = 900000;
-
-				webrtc::RtpEncodingParameters pm;
-				pm.rid = "m";
-				pm.active = true;
-				pm.max_bitrate_bps = 300000;
-				pm.scale_resolution_down_by = 2;
-
-				webrtc::RtpEncodingParameters pl;
-				pl.rid = "m";
-				pl.active = true;
-				pl.max_bitrate_bps = 100000;
-				pl.scale_resolution_down_by = 4;
-
-				params.encodings.emplace_back(ph);
-				params.encodings.emplace_back(pm);
-				params.encodings.emplace_back(pl);
-
-				sender->SetParameters(params);
-			}
-		}
-
 		auto wself = weak_from_this();
 
 		std::unique_ptr<CreateSessionDescObserver> createAnswerObserver;
@@ -1366,8 +1364,17 @@ namespace vi {
 
 			SetSessionDescObserver* ssdo(new rtc::RefCountedObject<SetSessionDescObserver>());
 
-			ssdo->setSuccessCallback(std::make_shared<SetSessionDescSuccessCallback>([]() {
+			ssdo->setSuccessCallback(std::make_shared<SetSessionDescSuccessCallback>([wself, sendVideo, simulcast]() {
 				DLOG("Set session description success.");
+				auto self = wself.lock();
+				if (self && sendVideo && simulcast) {
+					// the simulcast encodings exist once the local description is applied
+					self->_serviceThread->PostTask(RTC_FROM_HERE, [wself]() {
+						if (auto self = wself.lock()) {
+							self->applySimulcastLadder();
+						}
+					});
+				}
 			}));
 
 			ssdo->setFailureCallback(std::make_shared<SetSessionDescFailureCallback>([event, wself](webrtc::RTCError error) {
@@ -1445,12 +1452,19 @@ namespace vi {
 			context->pc = nullptr;
 		}
 
+		// a batch or a flush still queued belongs to the closed peer connection
+		++context->pcGeneration;
+		context->pendingCandidates.clear();
+		context->trickleFlushScheduled = false;
+
 		context->candidates.clear();
 		context->localSdp = absl::nullopt;
 		context->remoteSdp = absl::nullopt;
 		context->iceDone = false;
 		context->dataChannels.clear();
 		context->dtmfSender = nullptr;
+
+		_statsCollector->clear();
 	}
 
 
@@ -1476,35 +1490,26 @@ namespace vi {
 				std::string candidateStr;
 				candidate->ToString(&candidateStr);
 
-				auto event = std::make_shared<TrickleCandidateEvent>();
-				event->candidate.candidate = candidateStr;
-				event->candidate.sdpMid = candidate->sdp_mid();
-				event->candidate.sdpMLineIndex = (int)candidate->sdp_mline_index();
-				event->candidate.completed = false;
-
-				if (auto sc = _pluginContext->signalingClient.lock()) {
-					if (sc->sessionStatus() == SessionStatus::CONNECTED) {
-						sc->sendTrickleCandidate(_pluginContext->handleId, event);
-					}
-				}
+				CandidateData data;
+				data.candidate = candidateStr;
+				data.sdpMid = candidate->sdp_mid();
+				data.sdpMLineIndex = (int)candidate->sdp_mline_index();
+				data.completed = false;
+				queueCandidate(data);
 			}
 		}
 		else {
 			DLOG("End of candidates.");
 			_pluginContext->iceDone = true;
 			if (_pluginContext->trickle) {
-				auto event = std::make_shared<TrickleCandidateEvent>();
-				event->candidate.completed = true;
-				if (auto sc = _pluginContext->signalingClient.lock()) {
-					if (sc->sessionStatus() == SessionStatus::CONNECTED) {
-						sc->sendTrickleCandidate(_pluginContext->handleId, event);
-					}
-				}
+				CandidateData data;
+				data.completed = true;
+				queueCandidate(data);
 			}
 			else {
 				// should be called in SERVICE thread
 				DLOG("send candidates.");
-				TMgr->thread("plugin-client")->PostTask(RTC_FROM_HERE, [wself = weak_from_this()]() {
+				_serviceThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this()]() {
 					if (auto self = wself.lock()) {
 						self->sendSdp();
 					}
@@ -1513,6 +1518,59 @@ namespace vi {
 		}
 	}
 
+	void PluginClient::queueCandidate(const CandidateData& candidate)
+	{
+		// batches are only touched on the plugin-client thread
+		const uint64_t generation = _pluginContext->pcGeneration;
+		_serviceThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), candidate, generation]() {
+			auto self = wself.lock();
+			if (!self) {
+				return;
+			}
+
+			auto& context = self->_pluginContext;
+			if (generation != context->pcGeneration) {
+				DLOG("dropping a candidate of a closed peer connection");
+				return;
+			}
+			context->pendingCandidates.emplace_back(candidate);
+
+			if (candidate.completed.value_or(false) || context->trickleWindowMs == 0 || context->pendingCandidates.size() >= context->trickleBatchSize) {
+				self->flushCandidates(generation);
+			}
+			else if (!context->trickleFlushScheduled) {
+				context->trickleFlushScheduled = true;
+				self->_serviceThread->PostDelayedTask(RTC_FROM_HERE, [wself, generation]() {
+					if (auto self = wself.lock()) {
+						self->flushCandidates(generation);
+					}
+				}, context->trickleWindowMs);
+			}
+		});
+	}
+
+	void PluginClient::flushCandidates(uint64_t generation)
+	{
+		// cleanupWebrtc() already dropped the batch and the flag, a later batch has a flush of its own
+		if (generation != _pluginContext->pcGeneration) {
+			return;
+		}
+
+		_pluginContext->trickleFlushScheduled = false;
+		if (_pluginContext->pendingCandidates.empty()) {
+			return;
+		}
+
+		auto event = std::make_shared<TrickleCandidateEvent>();
+		event->candidates.swap(_pluginContext->pendingCandidates);
+
+		if (auto sc = _pluginContext->signalingClient.lock()) {
+			if (acceptsRequests(sc->sessionStatus())) {
+				sc->sendTrickleCandidate(_pluginContext->handleId, event);
+			}
+		}
+	}
+
 	void PluginClient::OnTrack(rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver)
 	{
 		_eventHandlerThread->PostTask(RTC_FROM_HERE, [transceiver, wself = weak_from_this()]() {
@@ -1560,10 +1618,10 @@ namespace vi {
 		});
 	}
 
-	void PluginClient::onTrickle(const std::string& trickle)
+	void PluginClient::onTrickle(std::shared_ptr<JanusMessage> message)
 	{
 		std::string err;
-		std::shared_ptr<TrickleResponse> model = fromJsonString<TrickleResponse>(trickle, err);
+		std::shared_ptr<TrickleResponse> model = message->to<TrickleResponse>(err);
 		if (!err.empty()) {
 			DLOG("parse JanusResponse failed");
 			return;
@@ -1624,6 +1682,21 @@ namespace vi {
 	{
 		cleanupWebrtc();
 	}
+
+	void PluginClient::onSessionResumed()
+	{
+		const auto& context = _pluginContext;
+		if (!context->pc) {
+			return;
+		}
+
+		// ICE rides out a short signaling outage on its own, only restart it where media broke as well
+		const auto state = context->pc->standardized_ice_connection_state();
+		if (state == webrtc::PeerConnectionInterface::kIceConnectionDisconnected || state == webrtc::PeerConnectionInterface::kIceConnectionFailed) {
+			ILOG("handle {} resumed with ice state {}, restarting ice", context->handleId, static_cast<int>(state));
+			restartIce();
+		}
+	}
 }
 
 
@@ -8,13 +8,17 @@
 
 #include <memory>
 #include <string>
+#include <atomic>
 #include "i_webrtc_event_handler.h"
 #include "i_signaling_event_handler.h"
 #include "signaling_client_status.h"
+#include "track_stats.h"
+#include "utils/timer_service.h"
 
 namespace vi {
 	class SignalingClientInterface;
-	class TaskScheduler;
+	struct SimulcastLadder;
+	class StatsCollector;
 
 	class PluginClient
 		: public ISignalingEventHandler
@@ -57,10 +61,20 @@ namespace vi {
 
 		void detach(std::shared_ptr<DetachEvent> event);
 
+		void setTrickleBatching(uint32_t windowMs, uint32_t batchSize);
+
+		// Takes effect on the next offer, and right away on a published simulcast video through SetParameters
+		void setSimulcastLadder(const SimulcastLadder& ladder);
+
+		// Restarts a running poll with the new interval
+		void setStatsConfig(const StatsConfig& config);
+
 		void startRtcStatsReport();
 
 		void stopRtcStatsReport();
 
+		std::vector<TrackStatsHistory> trackStats();
+
 	protected:
 		void prepareWebrtc(bool isOffer, std::shared_ptr<PrepareWebrtcEvent> event);
 
@@ -78,6 +92,15 @@ namespace vi {
 
 		void cleanupWebrtc(bool hangupRequest = true);
 
+		void queueCandidate(const CandidateData& candidate);
+
+		// Trickles the pending batch, unless the peer connection of |generation| is gone
+		void flushCandidates(uint64_t generation);
+
+		void applySimulcastLadder();
+
+		void pollStats();
+
 	protected:
 		// webrtc events
 
@@ -106,15 +129,18 @@ namespace vi {
 
 		virtual void onChannelData(const std::string& label, const std::string& data) {}
 
-		virtual void onStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report) {}
+		// Renegotiates with fresh ICE credentials, the way the plugin expects it
+		virtual void restartIce() {}
 
 	public:
 		// signaling service events
 
-		void onTrickle(const std::string& trickle) override;
+		void onTrickle(std::shared_ptr<JanusMessage> message) override;
 
 		void onCleanup() override;
 
+		void onSessionResumed() override;
+
 	protected:
 		uint64_t _id = 0;
 
@@ -122,12 +148,21 @@ namespace vi {
 
 		std::shared_ptr<PluginContext> _pluginContext;
 
-		std::shared_ptr<TaskScheduler> _rtcStatsTaskScheduler;
+		std::shared_ptr<StatsCollector> _statsCollector;
 
-		uint64_t _rtcStatsTaskId = 0;
+		std::atomic<int64_t> _statsIntervalMs{ StatsConfig().intervalMs };
+
+		// 0 when not polling, swapped by start/stop from any thread
+		std::atomic<TimerId> _statsTimer{ 0 };
 
 		rtc::Thread* _eventHandlerThread = nullptr;
 
+		// resolved once at construction, see ThreadProvider::thread(NamedThread)
+		rtc::Thread* _serviceThread = nullptr;
+
+		// shared by every plugin client, runs the GetStats calls and ingests the reports
+		rtc::Thread* _statsThread = nullptr;
+
 		// key: mid, value: receiver-id
 		std::unordered_map<std::string, std::string> _receiverId2Mid;
 	};
@@ -20,6 +20,7 @@
 #include "signaling_events.h"
 #include "signaling_client_interface.h"
 #include "video_capture.h"
+#include "simulcast_ladder.h"
 
 namespace vi {
 
@@ -53,6 +54,19 @@ namespace vi {
 		rtc::scoped_refptr<webrtc::DtmfSenderInterface> dtmfSender;
 		std::unique_ptr<DtmfObserver> dtmfObserver;
 		std::vector<std::shared_ptr<webrtc::IceCandidateInterface>> candidates;
+
+		// Local candidates are coalesced per handle and trickled in one request, a batch is flushed
+		// |trickleWindowMs| after its first candidate or once it holds |trickleBatchSize| of them.
+		// A window of 0 trickles every candidate on its own
+		uint32_t trickleWindowMs = 20;
+		uint32_t trickleBatchSize = 16;
+		std::vector<CandidateData> pendingCandidates;
+		bool trickleFlushScheduled = false;
+		// bumped when the peer connection is closed, candidates and flushes of an earlier one are dropped
+		std::atomic<uint64_t> pcGeneration{ 0 };
+
+		// encodings a simulcast video is published with, service thread only
+		SimulcastLadder simulcastLadder = SimulcastLadder::standard();
 		rtc::scoped_refptr<StatsObserver> statsObserver;
 
 		rtc::scoped_refptr<webrtc::MediaStreamInterface> localStream;
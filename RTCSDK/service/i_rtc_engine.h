@@ -8,12 +8,17 @@
 
 #include <memory>
 #include <string>
+#include "connection_policy.h"
+
 namespace vi {
     class VideoRoomClientInterface;
     class IEngineEventHandler;
 
     struct Options {
         std::string serverUrl;
+
+        // liveness checks and reconnection of the signaling connection
+        ConnectionPolicy connection;
     };
 
     class IRTCEngine {
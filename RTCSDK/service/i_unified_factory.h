@@ -12,6 +12,7 @@ namespace vi {
     class ThreadProvider;
     class IServiceFactory;
     class SignalingClientInterface;
+    class TimerService;
 
     class IUnifiedFactory {
     public:
@@ -26,6 +27,8 @@ namespace vi {
         virtual std::shared_ptr<vi::IServiceFactory> getServiceFactory() = 0;
 
         virtual std::shared_ptr<vi::SignalingClientInterface> getSignalingClient() = 0;
+
+        virtual std::shared_ptr<vi::TimerService> getTimerService() = 0;
     };
 
 }
\ No newline at end of file
@@ -84,6 +84,7 @@ namespace vi {
 	void RTCEngine::startup()
 	{
 		auto sc = uFactory->getSignalingClient();
+		sc->setConnectionPolicy(_options.connection);
 		sc->connect(_options.serverUrl);
 	}
 
@@ -106,7 +107,13 @@ namespace vi {
 	void RTCEngine::onSessionStatus(SessionStatus status)
 	{
 		Observable::notifyObserver4Change<IEngineEventHandler>(_observers, [status](const auto& observer) {
-			EngineStatus es = status == SessionStatus::CONNECTED ? EngineStatus::CONNECTED : EngineStatus::DISCONNECTED;
+			EngineStatus es = EngineStatus::DISCONNECTED;
+			if (status == SessionStatus::CONNECTED) {
+				es = EngineStatus::CONNECTED;
+			}
+			else if (status == SessionStatus::RECONNECTING) {
+				es = EngineStatus::RECONNECTING;
+			}
 			observer->onStatus(es);
 		});
 	}
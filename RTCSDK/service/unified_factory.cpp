@@ -9,6 +9,7 @@
 #include "signaling_client.h"
 #include "signaling_client_interface.h"
 #include "utils/thread_provider.h"
+#include "utils/timer_service.h"
 
 namespace vi {
 	UnifiedFactory::UnifiedFactory()
@@ -21,7 +22,12 @@ namespace vi {
 		if (!_threadProvider) {
 			_threadProvider = std::make_unique<vi::ThreadProvider>();
 			_threadProvider->init();
-			_threadProvider->create({ "signaling-service", "plugin-client", "message-transport", "capture-session" });
+			_threadProvider->create({ "signaling-service", "plugin-client", "message-transport", "capture-session", "timer-service", "stats-collector" });
+		}
+
+		if (!_timerService) {
+			_timerService = std::make_shared<vi::TimerService>();
+			_timerService->init(_threadProvider->thread(NamedThread::TIMER_SERVICE));
 		}
 
 		if (!_serviceFactory) {
@@ -45,6 +51,10 @@ namespace vi {
 			_serviceFactory->destroy();
 		}
 
+		if (_timerService) {
+			_timerService->destroy();
+		}
+
 		if (_threadProvider) {
 			_threadProvider->destroy();
 		}
@@ -64,4 +74,9 @@ namespace vi {
 	{
 		return _signalingClient;
 	}
+
+	std::shared_ptr<vi::TimerService> UnifiedFactory::getTimerService()
+	{
+		return _timerService;
+	}
 }
\ No newline at end of file
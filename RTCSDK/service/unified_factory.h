@@ -27,11 +27,15 @@ namespace vi {
 
         std::shared_ptr<vi::SignalingClientInterface> getSignalingClient() override;
 
+        std::shared_ptr<vi::TimerService> getTimerService() override;
+
     private:
         std::unique_ptr<vi::ThreadProvider> _threadProvider;
 
         std::shared_ptr<vi::IServiceFactory> _serviceFactory;
 
         std::shared_ptr<vi::SignalingClientInterface> _signalingClient;
+
+        std::shared_ptr<vi::TimerService> _timerService;
     };
 }
\ No newline at end of file
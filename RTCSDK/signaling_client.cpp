@@ -12,9 +12,10 @@
 #include "logger/logger.h"
 #include "service/rtc_engine.h"
 #include "utils/thread_provider.h"
-#include "utils/task_scheduler.h"
 #include "message_models.h"
+#include "janus_message.h"
 #include "absl/types/optional.h"
+#include "rtc_base/time_utils.h"
 
 namespace vi {
 
@@ -27,10 +28,9 @@ namespace vi {
 	{
 		DLOG("~SignalingClient");
 
-		if (_heartbeatTaskScheduler) {
-			_heartbeatTaskScheduler->cancelAll();
+		if (auto timers = Timers) {
+			timers->cancel(_heartbeatTimer);
 		}
-		DLOG("~SignalingClient");
 	}
 
 	void SignalingClient::init()
@@ -41,8 +41,6 @@ namespace vi {
 		_client = std::make_shared<vi::JanusApiClient>("signaling-service");
 		_client->addListener(shared_from_this());
 		_client->init();
-
-		_heartbeatTaskScheduler = TaskScheduler::create();
 	}
 
 	void SignalingClient::cleanup()
@@ -66,6 +64,13 @@ namespace vi {
 		UniversalObservable<ISignalingClientObserver>::removeObserver(observer);
 	}
 
+	void SignalingClient::setConnectionPolicy(const ConnectionPolicy& policy)
+	{
+		if (_client) {
+			_client->setConnectionPolicy(policy);
+		}
+	}
+
 	void SignalingClient::connect(const std::string& url)
 	{
 		if (!_client) {
@@ -81,15 +86,28 @@ namespace vi {
 		return _sessionStatus;
 	}
 
+	std::vector<TransactionStats> SignalingClient::transactionStats()
+	{
+		if (!_client) {
+			return {};
+		}
+		return _client->transactionStats();
+	}
+
+	std::vector<DispatchStats> SignalingClient::dispatchStats()
+	{
+		return _dispatchMeter.stats();
+	}
+
 	void SignalingClient::attach(const std::string& plugin, const std::string& opaqueId, std::shared_ptr<PluginClient> pluginClient)
 	{
 		if (!pluginClient) {
 			return;
 		}
 
-		auto lambda = [wself = weak_from_this(), pluginClient](const std::string& json) {
+		auto lambda = [wself = weak_from_this(), pluginClient](std::shared_ptr<JanusMessage> message) {
 			std::string err;
-			std::shared_ptr<AttachResponse> model = fromJsonString<AttachResponse>(json, err);
+			std::shared_ptr<AttachResponse> model = message->to<AttachResponse>(err);
 			if (!err.empty()) {
 				DLOG("parse JanusResponse failed");
 				return;
@@ -100,7 +118,10 @@ namespace vi {
 				if (model->janus.value_or("") == "success") {
 					int64_t handleId = model->data->id.value();
 					pluginClient->setHandleId(handleId);
-					self->_pluginClientMap[handleId] = pluginClient;
+					{
+						std::lock_guard<std::mutex> lock(self->_pluginClientMutex);
+						self->_pluginClientMap[handleId] = pluginClient;
+					}
 					self->_eventHandlerThread->PostTask(RTC_FROM_HERE, [wself, pluginClient]() {
 						auto self = wself.lock();
 						if (!self) {
@@ -131,60 +152,132 @@ namespace vi {
 
 	void SignalingClient::reconnectSession()
 	{
-		// TODO: ?
+		DLOG("claiming session: {}", _sessionId);
+		auto lambda = [wself = weak_from_this()](std::shared_ptr<JanusMessage> message) {
+			DLOG("janus = {}", message->envelope().janus.value_or(""));
+			auto self = wself.lock();
+			if (!self) {
+				return;
+			}
+			if (message->envelope().janus.value_or("") == "success") {
+				self->onSessionClaimed();
+				return;
+			}
+
+			std::string err;
+			std::shared_ptr<JanusError> error = message->member<JanusError>("error", err);
+			const int64_t code = error ? error->code.value_or(0) : 0;
+			if (code == kTransportUnavailableError) {
+				// the new connection dropped as well, the session is claimed again on the next one
+				WLOG("claiming session {} failed: {}", self->_sessionId, error->reason.value_or(""));
+				return;
+			}
+			if (code == kTransactionTimeoutError) {
+				WLOG("claiming session {} timed out, trying again", self->_sessionId);
+				self->reconnectSession();
+				return;
+			}
+			// only Janus itself can tell the session is gone
+			self->onSessionLost();
+		};
+		std::shared_ptr<JCCallback> callback = std::make_shared<JCCallback>(lambda);
+		_client->reconnectSession(_sessionId, callback);
+	}
+
+	void SignalingClient::onSessionClaimed()
+	{
+		ILOG("session {} recovered in {} ms", _sessionId, rtc::TimeMillis() - _lostAt);
+
+		_connected = true;
+		startHeartbeat();
+		_client->replayPending();
+		setSessionStatus(SessionStatus::CONNECTED);
+
+		// signaling is back, media may not be: each handle checks its own peer connection
+		for (int64_t handleId : handleIds()) {
+			_eventHandlerThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), handleId]() {
+				auto self = wself.lock();
+				if (!self) {
+					return;
+				}
+				if (auto pluginClient = self->getHandler(handleId)) {
+					pluginClient->onSessionResumed();
+				}
+			});
+		}
+	}
+
+	void SignalingClient::onSessionLost()
+	{
+		WLOG("session {} could not be claimed, creating a new one", _sessionId);
+
+		_client->dropPending();
+		std::unordered_map<int64_t, std::weak_ptr<PluginClient>> pluginClients;
+		{
+			std::lock_guard<std::mutex> lock(_pluginClientMutex);
+			pluginClients.swap(_pluginClientMap);
+		}
+		for (const auto& pair : pluginClients) {
+			_eventHandlerThread->PostTask(RTC_FROM_HERE, [pluginClient = pair.second]() {
+				if (auto pc = pluginClient.lock()) {
+					pc->onCleanup();
+				}
+			});
+		}
+		_sessionId = -1;
+		setSessionStatus(SessionStatus::DISCONNECTED);
+
 		std::shared_ptr<CreateSessionEvent> event = std::make_shared<CreateSessionEvent>();
-		event->reconnect = true;
-		auto lambda = [](bool success, const std::string& response) {
-			DLOG("response: {}", response.c_str());
+		event->reconnect = false;
+		auto lambda = [wself = weak_from_this()](bool success, const std::string& response) {
+			if (auto self = wself.lock()) {
+				self->_connected = success;
+			}
 		};
 		event->callback = std::make_shared<vi::EventCallback>(lambda);
 		createSession(event);
 	}
 
+	void SignalingClient::setSessionStatus(SessionStatus status)
+	{
+		if (_sessionStatus == status) {
+			return;
+		}
+		_sessionStatus = status;
+		UniversalObservable<ISignalingClientObserver>::notifyObservers([status](const auto& observer) {
+			observer->onSessionStatus(status);
+		});
+	}
+
 	void SignalingClient::sendMessage(int64_t handleId, std::shared_ptr<MessageEvent> event)
 	{
-		if (_sessionStatus == SessionStatus::CONNECTED) {
+		if (acceptsRequests(_sessionStatus)) {
 			if (const auto& pluginClient = getHandler(handleId)) {
-				auto lambda = [wself = weak_from_this(), event](const std::string& json) {
-					DLOG("janus = {}", json);
+				auto lambda = [wself = weak_from_this(), event](std::shared_ptr<JanusMessage> message) {
 					if (auto self = wself.lock()) {
 						if (!event) {
 							return;
 						}
 
-						std::string err;
-						std::shared_ptr<JanusResponse> model = fromJsonString<JanusResponse>(json, err);
-						if (!err.empty()) {
-							DLOG("parse JanusResponse failed");
-							return;
-						}
+						const std::string janus = message->envelope().janus.value_or("");
+						DLOG("janus = {}", janus);
 
-						if (event->callback) {
-							if (model->janus.value_or("") == "success" || model->janus.value_or("") == "ack") {
-								self->_eventHandlerThread->PostTask(RTC_FROM_HERE, [cb = event->callback, json]() {
-									if (cb) {
-										(*cb)(true, json);
-									}
-								});
-							}
-							else if (model->janus.value_or("") != "ack") {
-								self->_eventHandlerThread->PostTask(RTC_FROM_HERE, [cb = event->callback, json]() {
-									if (cb) {
-										(*cb)(false, json);
-									}
-								});
-							}
+						if (event->reply) {
+							const bool success = janus == "success" || janus == "ack";
+							self->_eventHandlerThread->PostTask(RTC_FROM_HERE, [cb = event->reply, success, message]() {
+								(*cb)(success, message);
+							});
 						}
 					}
 				};
 				std::shared_ptr<JCCallback> callback = std::make_shared<JCCallback>(lambda);
-				_client->sendMessage(_sessionId, handleId, event->message, event->jsep, callback);
+				_client->sendMessage(_sessionId, handleId, event->body, event->jsep, callback);
 			}
 		}
 		else {
-			if (event && event->callback) {
-				_eventHandlerThread->PostTask(RTC_FROM_HERE, [cb = event->callback]() {
-					(*cb)(false, "service down!");
+			if (event && event->reply) {
+				_eventHandlerThread->PostTask(RTC_FROM_HERE, [cb = event->reply]() {
+					(*cb)(false, JanusMessage::error("", kTransportUnavailableError, "service down!"));
 				});
 			}
 		}
@@ -198,8 +291,8 @@ namespace vi {
 		}
 
 		if (hangupRequest == true) {
-			auto lambda = [wself = weak_from_this()](const std::string& json) {
-				DLOG("janus = {}", json);
+			auto lambda = [wself = weak_from_this()](std::shared_ptr<JanusMessage> message) {
+				DLOG("janus = {}", message->envelope().janus.value_or(""));
 				if (auto self = wself.lock()) {
 				}
 			};
@@ -250,13 +343,14 @@ namespace vi {
 			return;
 		}
 
-		auto lambda = [wself = weak_from_this(), handleId](const std::string& json) {
-			DLOG("janus = {}", json);
+		auto lambda = [wself = weak_from_this(), handleId](std::shared_ptr<JanusMessage> message) {
+			DLOG("janus = {}", message->envelope().janus.value_or(""));
 			auto self = wself.lock();
 			if (!self) {
 				return;
 			}
 
+			std::lock_guard<std::mutex> lock(self->_pluginClientMutex);
 			self->_pluginClientMap.erase(handleId);
 		};
 		std::shared_ptr<JCCallback> callback = std::make_shared<JCCallback>(lambda);
@@ -272,6 +366,16 @@ namespace vi {
 
 	void SignalingClient::onOpened()
 	{
+		if (_sessionStatus == SessionStatus::RECONNECTING) {
+			if (_sessionId > 0) {
+				reconnectSession();
+			}
+			else {
+				onSessionLost();
+			}
+			return;
+		}
+
 		std::shared_ptr<CreateSessionEvent> event = std::make_shared<CreateSessionEvent>();
 		event->reconnect = false;
 		auto lambda = [wself = weak_from_this()](bool success, const std::string& response) {
@@ -283,212 +387,188 @@ namespace vi {
 		createSession(event);
 	}
 
+	void SignalingClient::onLost(int errorCode, const std::string& reason)
+	{
+		WLOG("connection lost, code = {}, reason = {}", errorCode, reason.c_str());
+
+		_connected = false;
+		// a connection that drops again before the session is claimed does not restart the clock
+		if (_sessionStatus != SessionStatus::RECONNECTING) {
+			_lostAt = rtc::TimeMillis();
+		}
+		Timers->cancel(_heartbeatTimer);
+		_heartbeatTimer = 0;
+		setSessionStatus(SessionStatus::RECONNECTING);
+	}
+
 	void SignalingClient::onClosed()
 	{
 		_connected = false;
+		Timers->cancel(_heartbeatTimer);
+		_heartbeatTimer = 0;
+		setSessionStatus(SessionStatus::DISCONNECTED);
 	}	
 	
 	void SignalingClient::onFailed(int errorCode, const std::string& reason)
 	{
 		_connected = false;
+		Timers->cancel(_heartbeatTimer);
+		_heartbeatTimer = 0;
+		setSessionStatus(SessionStatus::DISCONNECTED);
 	}
 
-	void SignalingClient::onMessage(const std::string& json)
+	template<typename Handler>
+	void SignalingClient::dispatch(SignalingEvent type, int64_t sender, const std::shared_ptr<JanusMessage>& message, Handler handler)
 	{
-		std::string err;
-		std::shared_ptr<JanusResponse> response = fromJsonString<JanusResponse>(json, err);
-		if (!err.empty()) {
-			DLOG("parse JanusResponse failed");
-			return;
-		}
+		_eventHandlerThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), type, sender, receivedAt = message->receivedAt(), handler = std::move(handler)]() {
+			auto self = wself.lock();
+			if (!self) {
+				return;
+			}
+			auto pluginClient = self->getHandler(sender);
+			if (!pluginClient) {
+				self->_dispatchMeter.drop(type);
+				return;
+			}
+			self->_dispatchMeter.record(type, rtc::TimeMicros() - receivedAt);
+			handler(pluginClient);
+		});
+	}
 
-		int64_t sender = response->sender.value();
-		auto& pluginClient = getHandler(sender);
-		if (!pluginClient) {
-			return;
-		}
+	void SignalingClient::onMessage(std::shared_ptr<JanusMessage> message)
+	{
+		const auto& response = message->envelope();
+
+		// looked up once, on the event handler thread, by dispatch()
+		int64_t sender = response.sender.value_or(-1);
 
 		auto wself = weak_from_this();
 
 		int32_t retries = 0;
 
-		if (response->janus.value_or("") == "keepalive") {
+		const std::string janus = response.janus.value_or("");
+
+		if (janus == "keepalive") {
 			DLOG("Got a keepalive on session: {}", _sessionId);
 		}
-		else if (response->janus.value_or("") == "server_info") {
+		else if (janus == "server_info") {
 			// Just info on the Janus instance
-			DLOG("Got info on the Janus instance: {}", response->janus.value_or(""));
+			DLOG("Got info on the Janus instance: {}", janus);
 		}
-		else if (response->janus.value_or("") == "trickle") {
-			DLOG("Got info on the Janus instance: {}", response->janus.value_or(""));
+		else if (janus == "trickle") {
+			DLOG("Got info on the Janus instance: {}", janus);
 
-			_eventHandlerThread->PostTask(RTC_FROM_HERE, [json, sender, wself]() {
-				auto self = wself.lock();
-				if (!self) {
-					return;
-				}
-				if (auto pluginClient = self->getHandler(sender)) {
-					pluginClient->onTrickle(json);
-				}
+			dispatch(SignalingEvent::TRICKLE, sender, message, [message](const std::shared_ptr<PluginClient>& pluginClient) {
+				pluginClient->onTrickle(message);
 			});
 		}
-		else if (response->janus.value_or("") == "webrtcup") {
+		else if (janus == "webrtcup") {
 			// The PeerConnection with the server is up! Notify this
 			DLOG("Got a webrtcup event on session: {}", _sessionId);
 
-			_eventHandlerThread->PostTask(RTC_FROM_HERE, [sender, wself]() {
-				auto self = wself.lock();
-				if (!self) {
-					return;
-				}
-				if (auto pluginClient = self->getHandler(sender)) {
-					pluginClient->onWebrtcStatus(true, "");
-				}
+			dispatch(SignalingEvent::WEBRTCUP, sender, message, [](const std::shared_ptr<PluginClient>& pluginClient) {
+				pluginClient->onWebrtcStatus(true, "");
 			});
 		}
-		else if (response->janus.value_or("") == "hangup") {
+		else if (janus == "hangup") {
 			// A plugin asked the core to hangup a PeerConnection on one of our handles
 			DLOG("Got a hangup event on session: {}", _sessionId);
 
 			std::string err;
-			std::shared_ptr<HangupResponse> model = fromJsonString<HangupResponse>(json, err);
+			std::shared_ptr<HangupResponse> model = message->to<HangupResponse>(err);
 			if (!err.empty()) {
 				DLOG("parse JanusResponse failed");
 				return;
 			}
 
-			_eventHandlerThread->PostTask(RTC_FROM_HERE, [sender, wself, reason = model->reason.value_or("")]() {
-				auto self = wself.lock();
-				if (!self) {
-					return;
-				}
-				if (auto pluginClient = self->getHandler(sender)) {
-					pluginClient->onWebrtcStatus(false, reason);
-					pluginClient->onHangup();
-				}
+			dispatch(SignalingEvent::HANGUP, sender, message, [reason = model->reason.value_or("")](const std::shared_ptr<PluginClient>& pluginClient) {
+				pluginClient->onWebrtcStatus(false, reason);
+				pluginClient->onHangup();
 			});
 		}
-		else if (response->janus.value_or("") == "detached") {
+		else if (janus == "detached") {
 			// A plugin asked the core to detach one of our handles
 			DLOG("Got a detached event on session: {}", _sessionId);
 
-			_eventHandlerThread->PostTask(RTC_FROM_HERE, [sender, wself]() {
-				auto self = wself.lock();
-				if (!self) {
-					return;
-				}
-				if (auto pluginClient = self->getHandler(sender)) {
-					pluginClient->onDetached();
-				}
+			dispatch(SignalingEvent::DETACHED, sender, message, [](const std::shared_ptr<PluginClient>& pluginClient) {
+				pluginClient->onDetached();
 			});
 		}
-		else if (response->janus.value_or("") == "media") {
+		else if (janus == "media") {
 			// Media started/stopped flowing
 			DLOG("Got a media event on session: {}", _sessionId);
 
 			std::string err;
-			std::shared_ptr<MediaResponse> model = fromJsonString<MediaResponse>(json, err);
+			std::shared_ptr<MediaResponse> model = message->to<MediaResponse>(err);
 			if (!err.empty()) {
 				DLOG("parse JanusResponse failed");
 				return;
 			}
 
-			_eventHandlerThread->PostTask(RTC_FROM_HERE, [sender, wself, model]() {
-				auto self = wself.lock();
-				if (!self) {
-					return;
-				}
-				if (auto pluginClient = self->getHandler(sender)) {
-					pluginClient->onMediaStatus(model->type.value_or(""), model->receiving.value_or(false), model->mid.value_or(""));
-
-				}
+			dispatch(SignalingEvent::MEDIA, sender, message, [model](const std::shared_ptr<PluginClient>& pluginClient) {
+				pluginClient->onMediaStatus(model->type.value_or(""), model->receiving.value_or(false), model->mid.value_or(""));
 			});
 		}
-		else if (response->janus.value_or("") == "slowlink") {
+		else if (janus == "slowlink") {
 			DLOG("Got a slowlink event on session: {}", _sessionId);
 
 			std::string err;
-			std::shared_ptr<SlowlinkResponse> model = fromJsonString<SlowlinkResponse>(json, err);
+			std::shared_ptr<SlowlinkResponse> model = message->to<SlowlinkResponse>(err);
 			if (!err.empty()) {
 				DLOG("parse JanusResponse failed");
 				return;
 			}
 
-			_eventHandlerThread->PostTask(RTC_FROM_HERE, [sender, wself, model]() {
-				auto self = wself.lock();
-				if (!self) {
-					return;
-				}
-				if (auto pluginClient = self->getHandler(sender)) {
-					pluginClient->onSlowLink(model->uplink.value_or(false), model->lost.value_or(false), model->mid.value_or(""));
-				}
+			dispatch(SignalingEvent::SLOWLINK, sender, message, [model](const std::shared_ptr<PluginClient>& pluginClient) {
+				pluginClient->onSlowLink(model->uplink.value_or(false), model->lost.value_or(false), model->mid.value_or(""));
 			});
 		}
-		else if (response->janus.value_or("") == "event") {
+		else if (janus == "event") {
 			DLOG("Got a plugin event on session: {}", _sessionId);
 
-			std::string err;
-			std::shared_ptr<JanusEvent> event = fromJsonString<JanusEvent>(json, err);
-			if (!err.empty()) {
-				DLOG("parse JanusResponse failed");
-				return;
-			}
-
-			if (!event->plugindata) {
+			if (!message->hasMember("plugindata")) {
 				ELOG("Missing plugindata...");
 				return;
 			}
 			
-			DLOG(" -- Event is coming from {} ({})", sender, event->plugindata->plugin.value_or(""));
+			DLOG(" -- Event is coming from {}", sender);
 
-			std::string jsep = event->jsep ? event->jsep->toJsonStr() : "";
+			std::string err;
+			std::shared_ptr<Jsep> jsep = message->member<Jsep>("jsep", err);
+			if (!err.empty()) {
+				DLOG("parse Jsep failed");
+				return;
+			}
 
-			_eventHandlerThread->PostTask(RTC_FROM_HERE, [sender, wself, json, jsep]() {
-				auto self = wself.lock();
-				if (!self) {
-					return;
-				}
-				if (auto pluginClient = self->getHandler(sender)) {
-					pluginClient->onMessage(json, jsep);
-				}
+			dispatch(SignalingEvent::PLUGIN_EVENT, sender, message, [message, jsep](const std::shared_ptr<PluginClient>& pluginClient) {
+				pluginClient->onMessage(message, jsep);
 			});
 		}
-		else if (response->janus.value_or("") == "timeout") {
+		else if (janus == "timeout") {
 			ELOG("Timeout on session: {}", _sessionId);
-			_eventHandlerThread->PostTask(RTC_FROM_HERE, [sender, wself]() {
-				auto self = wself.lock();
-				if (!self) {
-					return;
-				}
-				if (auto pluginClient = self->getHandler(sender)) {
-					pluginClient->onTimeout();
-				}
+
+			dispatch(SignalingEvent::TIMEOUT, sender, message, [](const std::shared_ptr<PluginClient>& pluginClient) {
+				pluginClient->onTimeout();
 			});
 		}
-		else if (response->janus.value_or("") == "error") {
+		else if (janus == "error") {
 			// something wrong happened
-			DLOG("Something wrong happened: {}", response->janus.value_or(""));
+			DLOG("Something wrong happened: {}", janus);
 
-			_eventHandlerThread->PostTask(RTC_FROM_HERE, [sender, wself]() {
-				auto self = wself.lock();
-				if (!self) {
-					return;
-				}
-				if (auto pluginClient = self->getHandler(sender)) {
-					pluginClient->onError("");
-				}
+			dispatch(SignalingEvent::JANUS_ERROR, sender, message, [](const std::shared_ptr<PluginClient>& pluginClient) {
+				pluginClient->onError("");
 			});
 		}
 		else {
-			WLOG("Unknown message/event {} on session: {}'", response->janus.value_or(""),  _sessionId);
+			WLOG("Unknown message/event {} on session: {}'", janus,  _sessionId);
 		}
 	}
 
 	void SignalingClient::createSession(std::shared_ptr<CreateSessionEvent> event)
 	{
-		auto lambda = [wself = weak_from_this(), event](const std::string& json) {
+		auto lambda = [wself = weak_from_this(), event](std::shared_ptr<JanusMessage> message) {
 			std::string err;
-			std::shared_ptr<CreateSessionResponse> model = fromJsonString<CreateSessionResponse>(json, err);
+			std::shared_ptr<CreateSessionResponse> model = message->to<CreateSessionResponse>(err);
 			if (!err.empty()) {
 				DLOG("parse JanusResponse failed");
 				return;
@@ -496,13 +576,25 @@ namespace vi {
 
 			DLOG("model.janus = {}", model->janus.value_or(""));
 			if (auto self = wself.lock()) {
-				self->_sessionId = model->session_id.value_or(0) > 0 ? model->session_id.value() : model->data->id.value();
+				if (model->janus.value_or("") != "success") {
+					std::shared_ptr<JanusError> error = message->member<JanusError>("error", err);
+					const std::string reason = error ? error->reason.value_or("") : model->janus.value_or("");
+					ELOG("create session failed: {}", reason);
+					if (event && event->callback) {
+						self->_eventHandlerThread->PostTask(RTC_FROM_HERE, [cb = event->callback, reason]() {
+							(*cb)(false, reason);
+						});
+					}
+					return;
+				}
+				if (model->session_id.value_or(0) > 0) {
+					self->_sessionId = model->session_id.value();
+				}
+				else if (model->data && model->data->id) {
+					self->_sessionId = model->data->id.value();
+				}
 				self->startHeartbeat();
-				self->_sessionStatus =SessionStatus::CONNECTED;
-
-				self->UniversalObservable<ISignalingClientObserver>::notifyObservers([](const auto& observer) {
-					observer->onSessionStatus(SessionStatus::CONNECTED);
-				});
+				self->setSessionStatus(SessionStatus::CONNECTED);
 
 				if (event && event->callback) {
 					self->_eventHandlerThread->PostTask(RTC_FROM_HERE, [cb = event->callback]() {
@@ -522,16 +614,17 @@ namespace vi {
 
 	void SignalingClient::startHeartbeat()
 	{
-		_heartbeatTaskId = _heartbeatTaskScheduler->schedule([wself = weak_from_this()]() {
+		Timers->cancel(_heartbeatTimer);
+		_heartbeatTimer = Timers->scheduleRepeating(TMgr->thread(NamedThread::SIGNALING_SERVICE), [wself = weak_from_this()]() {
 			if (auto self = wself.lock()) {
 				DLOG("sessionHeartbeat() called");
-				auto lambda = [](const std::string& json) {
-					DLOG("janus = {}", json);
+				auto lambda = [](std::shared_ptr<JanusMessage> message) {
+					DLOG("janus = {}", message->envelope().janus.value_or(""));
 				};
 				std::shared_ptr<JCCallback> callback = std::make_shared<JCCallback>(lambda);
 				self->_client->keepAlive(self->_sessionId, callback);
 			}
-		}, 5000, true);
+		}, 5000);
 	}
 
 	std::shared_ptr<PluginClient> SignalingClient::getHandler(int64_t handleId)
@@ -540,26 +633,39 @@ namespace vi {
 			ELOG("Missing sender...");
 			return nullptr;
 		}
-		if (_pluginClientMap.find(handleId) == _pluginClientMap.end()) {
+		std::lock_guard<std::mutex> lock(_pluginClientMutex);
+		auto it = _pluginClientMap.find(handleId);
+		if (it == _pluginClientMap.end()) {
 			ELOG("This handle is not attached to this session");
 			return nullptr;
 		}
-		return _pluginClientMap[handleId].lock();
+		return it->second.lock();
+	}
+
+	std::vector<int64_t> SignalingClient::handleIds()
+	{
+		std::lock_guard<std::mutex> lock(_pluginClientMutex);
+		std::vector<int64_t> ids;
+		ids.reserve(_pluginClientMap.size());
+		for (const auto& pair : _pluginClientMap) {
+			ids.emplace_back(pair.first);
+		}
+		return ids;
 	}
 
 	void SignalingClient::sendTrickleCandidate(int64_t handleId, std::shared_ptr<TrickleCandidateEvent> event)
 	{
-		auto lambda = [wself = weak_from_this(), event](const std::string& json) {
+		auto lambda = [wself = weak_from_this(), event](std::shared_ptr<JanusMessage> message) {
 			if (auto self = wself.lock()) {
 				if (event && event->callback) {
-					self->_eventHandlerThread->PostTask(RTC_FROM_HERE, [cb = event->callback, json]() {
-						(*cb)(true, json);
+					self->_eventHandlerThread->PostTask(RTC_FROM_HERE, [cb = event->callback, janus = message->envelope().janus.value_or("")]() {
+						(*cb)(true, janus);
 					});
 				}
 			}
 		};
 		std::shared_ptr<JCCallback> callback = std::make_shared<JCCallback>(lambda);
-		_client->sendTrickleCandidate(_sessionId, handleId, event->candidate, callback);
+		_client->sendTrickleCandidate(_sessionId, handleId, event->candidates, callback);
 	}
 
 	void SignalingClient::destroySession(std::shared_ptr<DestroySessionEvent> event)
@@ -581,10 +687,9 @@ namespace vi {
 			return;
 		}
 		if (event->cleanupHandles) {
-			for (auto pair : _pluginClientMap) {
+			for (int64_t hId : handleIds()) {
 				std::shared_ptr<DetachEvent> de = std::make_shared<DetachEvent>();
 				de->noRequest = true;
-				int64_t hId = pair.first;
 				auto lambda = [hId](bool success, const std::string& response) {
 					DLOG("destroyHandle, handleId = {}, success = {}, response = {}", hId, success, response.c_str());
 				};
@@ -606,8 +711,8 @@ namespace vi {
 		}
 
 		// TODO: destroy session from janus 
-		auto lambda = [wself = weak_from_this()](const std::string& json) {
-			DLOG("janus = {}", json);
+		auto lambda = [wself = weak_from_this()](std::shared_ptr<JanusMessage> message) {
+			DLOG("janus = {}", message->envelope().janus.value_or(""));
 			if (auto self = wself.lock()) {
 				self->_client->removeListener(self);
 			}
@@ -11,6 +11,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <mutex>
 #include "i_sfu_api_client.h"
 #include "i_sfu_api_client_listener.h"
 #include "signaling_events.h"
@@ -18,13 +19,14 @@
 #include "utils/universal_observable.hpp"
 #include "signaling_client_status.h"
 #include "i_signaling_client_observer.h"
+#include "dispatch_meter.h"
+#include "utils/timer_service.h"
 
 namespace rtc {
 	class Thread;
 }
 
 namespace vi {
-	class TaskScheduler;
 	class CapturerTrackSource;
 	class PluginClient;
 	class SignalingClient
@@ -48,6 +50,12 @@ namespace vi {
 
 		SessionStatus sessionStatus() override;
 
+		std::vector<TransactionStats> transactionStats() override;
+
+		std::vector<DispatchStats> dispatchStats() override;
+
+		void setConnectionPolicy(const ConnectionPolicy& policy) override;
+
 		void connect(const std::string& url) override;
 
 	protected:
@@ -69,11 +77,13 @@ namespace vi {
 
 	    void onOpened() override;
 
+		void onLost(int errorCode, const std::string& reason) override;
+
 		void onClosed() override;
 
 		void onFailed(int errorCode, const std::string& reason) override;
 
-		void onMessage(const std::string& json) override;
+		void onMessage(std::shared_ptr<JanusMessage> message) override;
 
 	private:
 
@@ -82,14 +92,30 @@ namespace vi {
 	private:
 		void createSession(std::shared_ptr<CreateSessionEvent> event);
 
+		// Claims the session back on a new connection, the handles survive and the held requests are replayed
 		void reconnectSession();
 
+		void onSessionClaimed();
+
+		// The session expired on the server while we were away, its handles are gone as well
+		void onSessionLost();
+
+		void setSessionStatus(SessionStatus status);
+
 		void destroySession(std::shared_ptr<DestroySessionEvent> event);
 
 		void startHeartbeat();
 
 		std::shared_ptr<PluginClient> getHandler(int64_t handleId);
 
+		// The handles attached at the time of the call
+		std::vector<int64_t> handleIds();
+
+		// Runs |handler| with the plugin client of |sender| on the event handler thread and accounts the dispatch latency of |message|,
+		// or accounts it as dropped when |sender| has no plugin client (any more)
+		template<typename Handler>
+		void dispatch(SignalingEvent type, int64_t sender, const std::shared_ptr<JanusMessage>& message, Handler handler);
+
 	private:
 		std::string _server;	
 
@@ -103,17 +129,23 @@ namespace vi {
 
 		bool _connected = false;
 
+		// read from the event handler thread as well, through getHandler()
+		std::mutex _pluginClientMutex;
+
 		std::unordered_map<int64_t, std::weak_ptr<PluginClient>> _pluginClientMap;
 
 		std::shared_ptr<ISfuApiClient> _client;
 
-		std::shared_ptr<TaskScheduler> _heartbeatTaskScheduler;
-
-		uint64_t _heartbeatTaskId = 0;
+		TimerId _heartbeatTimer = 0;
 
 		SessionStatus _sessionStatus = SessionStatus::DISCONNECTED;
 
+		// when the connection dropped, for the recovery time
+		int64_t _lostAt = 0;
+
 		rtc::Thread* _eventHandlerThread;
+
+		DispatchMeter _dispatchMeter;
 	};
 }
 
@@ -7,10 +7,14 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include <functional>
 #include "signaling_events.h"
 #include "service/i_unified_factory.h"
 #include "signaling_client_status.h"
+#include "transaction_stats.h"
+#include "dispatch_stats.h"
+#include "connection_policy.h"
 #include "weak_proxy.h"
 
 namespace vi {
@@ -31,6 +35,15 @@ namespace vi {
 
 		virtual SessionStatus sessionStatus() = 0;
 
+		// Round trip latency histograms of the requests sent to the current Janus server, one entry per RequestType
+		virtual std::vector<TransactionStats> transactionStats() = 0;
+
+		// Receive-to-handler latency histograms of the events routed to plugin handles, one entry per SignalingEvent
+		virtual std::vector<DispatchStats> dispatchStats() = 0;
+
+		// Applies from the next connect()
+		virtual void setConnectionPolicy(const ConnectionPolicy& policy) = 0;
+
 		virtual void connect(const std::string& url) = 0;
 
 		virtual void attach(const std::string& plugin, const std::string& opaqueId, std::shared_ptr<PluginClient> pluginClient) = 0;
@@ -52,8 +65,11 @@ namespace vi {
 		WEAK_PROXY_METHOD0(void, cleanup)
 		WEAK_PROXY_METHOD1(void, registerObserver, std::shared_ptr<ISignalingClientObserver>)
 		WEAK_PROXY_METHOD1(void, unregisterObserver, std::shared_ptr<ISignalingClientObserver>)
+		WEAK_PROXY_METHOD1(void, setConnectionPolicy, const ConnectionPolicy&)
 		WEAK_PROXY_METHOD1(void, connect, const std::string&)
 		WEAK_PROXY_METHOD0(SessionStatus, sessionStatus)
+		WEAK_PROXY_METHOD0(std::vector<TransactionStats>, transactionStats)
+		WEAK_PROXY_METHOD0(std::vector<DispatchStats>, dispatchStats)
 		WEAK_PROXY_METHOD3(void, attach, const std::string&, const std::string&, std::shared_ptr<PluginClient>)
 		WEAK_PROXY_METHOD1(void, destroy, std::shared_ptr<DestroySessionEvent>)
 		WEAK_PROXY_METHOD2(void, sendMessage, int64_t, std::shared_ptr<MessageEvent>)
@@ -5,6 +5,15 @@
 namespace vi {
 	enum class SessionStatus : uint32_t {
 		CONNECTED = 0,
-		DISCONNECTED
+		DISCONNECTED,
+		// the transport dropped, the session is claimed back on the next connection
+		RECONNECTING
 	};
+
+	// Requests sent while reconnecting are held by the transport and replayed once the session is claimed,
+	// the ones that must not reach Janus twice fail right away
+	inline bool acceptsRequests(SessionStatus status)
+	{
+		return status == SessionStatus::CONNECTED || status == SessionStatus::RECONNECTING;
+	}
 }
\ No newline at end of file
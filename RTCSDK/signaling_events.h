@@ -7,6 +7,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include <functional>
 #include "api/peer_connection_interface.h"
 #include "api/media_stream_interface.h"
@@ -14,9 +15,13 @@
 #include "message_models.h"
 
 namespace vi {
+	class JanusMessage;
+
 	using SuccessCallback = std::function<void()>;
 	using FailureCallback = std::function<void(const std::string& reason)>;
 	using EventCallback = std::function<void(bool success, const std::string& response)>;
+	// The reply of Janus as it was parsed off the frame, models are decoded from its DOM
+	using ReplyCallback = std::function<void(bool success, std::shared_ptr<JanusMessage> reply)>;
 
 	class EventBase {
 	public:
@@ -27,13 +32,17 @@ namespace vi {
 
 	class MessageEvent : public EventBase {
 	public:
-		std::string message;
-		std::string jsep;
+		// the plugin request and the sdp, serialized straight into the outgoing "message"
+		JsonBody body;
+		JsonBody jsep;
+		// called instead of |callback|, with a local error reply when the request could not be sent
+		std::shared_ptr<ReplyCallback> reply;
 	};
 
 	class TrickleCandidateEvent : public EventBase {
 	public:
-		CandidateData candidate;
+		// Trickled in one request, the last one may be the end-of-candidates marker
+		std::vector<CandidateData> candidates;
 	};
 
 	class ChannelDataEvent : public EventBase {
@@ -0,0 +1,138 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "simulcast_ladder.h"
+#include <algorithm>
+
+namespace {
+	// roughly what VP8 needs for talking heads, 640x480@30 -> ~300 kbps
+	constexpr double kBitsPerPixel = 0.033;
+
+	// below this a layer is not worth its own encoder
+	constexpr int32_t kMinLayerHeight = 90;
+
+	constexpr int32_t kMinLayerBitrateBps = 50000;
+
+	int32_t bitrateFor(int32_t width, int32_t height, double scale, double fps)
+	{
+		const double pixels = (width / scale) * (height / scale);
+		return std::max(kMinLayerBitrateBps, static_cast<int32_t>(pixels * fps * kBitsPerPixel));
+	}
+
+	vi::SimulcastLayerSpec layer(const std::string& rid, double scale, int32_t maxBitrateBps)
+	{
+		vi::SimulcastLayerSpec spec;
+		spec.rid = rid;
+		spec.scaleResolutionDownBy = scale;
+		spec.maxBitrateBps = maxBitrateBps;
+		return spec;
+	}
+
+	bool apply(const vi::SimulcastLayerSpec& spec, webrtc::RtpEncodingParameters& encoding)
+	{
+		webrtc::RtpEncodingParameters updated = encoding;
+		updated.active = spec.active;
+		updated.scale_resolution_down_by = spec.scaleResolutionDownBy;
+		updated.max_bitrate_bps = spec.maxBitrateBps > 0 ? absl::optional<int>(spec.maxBitrateBps) : absl::nullopt;
+		updated.max_framerate = spec.maxFramerate;
+		updated.scalability_mode = spec.scalabilityMode;
+		if (updated == encoding) {
+			return false;
+		}
+		encoding = updated;
+		return true;
+	}
+}
+
+namespace vi {
+	SimulcastLadder SimulcastLadder::standard()
+	{
+		SimulcastLadder ladder;
+		ladder.layers.emplace_back(layer("h", 1.0, 900000));
+		ladder.layers.emplace_back(layer("m", 2.0, 300000));
+		ladder.layers.emplace_back(layer("l", 4.0, 100000));
+		return ladder;
+	}
+
+	SimulcastLadder SimulcastLadder::preset(SimulcastPreset preset, int32_t width, int32_t height, int32_t fps)
+	{
+		SimulcastLadder ladder;
+		if (width <= 0 || height <= 0 || fps <= 0) {
+			return standard();
+		}
+
+		ladder.layers.emplace_back(layer("h", 1.0, bitrateFor(width, height, 1.0, fps)));
+		ladder.layers.emplace_back(layer("m", 2.0, bitrateFor(width, height, 2.0, fps)));
+		ladder.layers.emplace_back(layer("l", 4.0, bitrateFor(width, height, 4.0, fps)));
+
+		for (auto& spec : ladder.layers) {
+			// keep the rid so Janus still sees three substreams, just stop encoding it
+			if (height / spec.scaleResolutionDownBy < kMinLayerHeight) {
+				spec.active = false;
+			}
+		}
+
+		switch (preset) {
+		case SimulcastPreset::LOW:
+			ladder.layers[0].active = false;
+			for (auto& spec : ladder.layers) {
+				spec.maxFramerate = std::min(fps, 15);
+				spec.maxBitrateBps = bitrateFor(width, height, spec.scaleResolutionDownBy, *spec.maxFramerate);
+			}
+			break;
+		case SimulcastPreset::MEDIUM:
+			ladder.layers[2].maxFramerate = std::min(fps, 15);
+			ladder.layers[2].maxBitrateBps = bitrateFor(width, height, 4.0, *ladder.layers[2].maxFramerate);
+			break;
+		case SimulcastPreset::HIGH:
+			break;
+		}
+
+		// never leave a publisher without any layer
+		if (std::none_of(ladder.layers.begin(), ladder.layers.end(), [](const auto& spec) { return spec.active; })) {
+			ladder.layers.back().active = true;
+		}
+
+		return ladder;
+	}
+
+	std::vector<webrtc::RtpEncodingParameters> SimulcastLadder::toEncodings() const
+	{
+		std::vector<webrtc::RtpEncodingParameters> encodings;
+		encodings.reserve(layers.size());
+		for (const auto& spec : layers) {
+			webrtc::RtpEncodingParameters encoding;
+			encoding.rid = spec.rid;
+			apply(spec, encoding);
+			encodings.emplace_back(encoding);
+		}
+		return encodings;
+	}
+
+	bool SimulcastLadder::applyTo(webrtc::RtpParameters& parameters) const
+	{
+		bool changed = false;
+		const size_t count = parameters.encodings.size();
+		for (size_t i = 0; i < count; ++i) {
+			webrtc::RtpEncodingParameters& encoding = parameters.encodings[i];
+			const SimulcastLayerSpec* spec = nullptr;
+			if (!encoding.rid.empty()) {
+				auto it = std::find_if(layers.begin(), layers.end(), [&encoding](const auto& s) {
+					return s.rid == encoding.rid;
+				});
+				spec = it != layers.end() ? &*it : nullptr;
+			}
+			else if (count <= layers.size()) {
+				// ssrc simulcast lists the lowest resolution first, the ladder the highest
+				spec = &layers[count - 1 - i];
+			}
+			if (spec) {
+				changed |= apply(*spec, encoding);
+			}
+		}
+		return changed;
+	}
+}
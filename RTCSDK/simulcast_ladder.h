@@ -0,0 +1,52 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "absl/types/optional.h"
+#include "api/rtp_parameters.h"
+
+namespace vi {
+	struct SimulcastLayerSpec {
+		std::string rid;
+		bool active = true;
+		double scaleResolutionDownBy = 1.0;
+		int32_t maxBitrateBps = 0;
+		absl::optional<double> maxFramerate;
+		// e.g. "L1T3", only honoured by encoders that support it
+		absl::optional<std::string> scalabilityMode;
+	};
+
+	// Device classes the presets are tuned for
+	enum class SimulcastPreset : int {
+		LOW = 0,
+		MEDIUM,
+		HIGH
+	};
+
+	// The encodings a published video is sent with, top layer first. The rids are the ones Janus
+	// maps to substreams: "h" (2), "m" (1) and "l" (0).
+	struct SimulcastLadder {
+		std::vector<SimulcastLayerSpec> layers;
+
+		// 900/300/100 kbps at full, half and quarter resolution
+		static SimulcastLadder standard();
+
+		// Derives bitrates from the capture format, lower classes drop the top layer and the frame rate
+		static SimulcastLadder preset(SimulcastPreset preset, int32_t width, int32_t height, int32_t fps);
+
+		// Encodings for RtpTransceiverInit::send_encodings
+		std::vector<webrtc::RtpEncodingParameters> toEncodings() const;
+
+		// Copies the ladder onto the encodings a sender negotiated, as SetParameters cannot add or remove any.
+		// Encodings are matched by rid, encodings without one (ssrc simulcast) by position, lowest first.
+		// Returns false if nothing changed.
+		bool applyTo(webrtc::RtpParameters& parameters) const;
+	};
+}
@@ -0,0 +1,219 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "simulcast_layer_selector.h"
+#include <algorithm>
+
+namespace vi {
+	// odr-used by std::min/std::max, C++14 wants a definition
+	constexpr int32_t SimulcastLayerSelector::kTopSubstream;
+
+	constexpr int32_t SimulcastLayerSelector::kTopTemporal;
+
+	SimulcastLayerSelector::SimulcastLayerSelector()
+		: SimulcastLayerSelector(Config())
+	{
+	}
+
+	SimulcastLayerSelector::SimulcastLayerSelector(const Config& config)
+		: _config(config)
+	{
+	}
+
+	SimulcastLayerSelector::Config SimulcastLayerSelector::fromLadder(const SimulcastLadder& ladder, int32_t width, int32_t height)
+	{
+		Config config;
+		config.width = width;
+		config.height = height;
+		for (size_t i = 0; i < ladder.layers.size(); ++i) {
+			const SimulcastLayerSpec& spec = ladder.layers[i];
+			int32_t substream = kTopSubstream - static_cast<int32_t>(i);
+			if (spec.rid == "h") {
+				substream = 2;
+			}
+			else if (spec.rid == "m") {
+				substream = 1;
+			}
+			else if (spec.rid == "l") {
+				substream = 0;
+			}
+			if (substream < 0 || substream > kTopSubstream || !spec.active) {
+				continue;
+			}
+			config.layerHeights[substream] = static_cast<int32_t>(height / std::max(spec.scaleResolutionDownBy, 1.0));
+		}
+		return config;
+	}
+
+	void SimulcastLayerSelector::setConfig(const Config& config, int64_t nowMs)
+	{
+		_config = config;
+		for (auto& it : _tracks) {
+			retarget(it.second, nowMs);
+		}
+	}
+
+	void SimulcastLayerSelector::add(const std::string& mid)
+	{
+		_tracks.emplace(mid, Track());
+	}
+
+	void SimulcastLayerSelector::update(const std::string& mid, int32_t width, int32_t height, bool visible, int64_t nowMs)
+	{
+		auto it = _tracks.find(mid);
+		if (it == _tracks.end()) {
+			return;
+		}
+
+		Track& track = it->second;
+		track.width = width;
+		track.height = height;
+		track.visible = visible;
+		retarget(track, nowMs);
+	}
+
+	void SimulcastLayerSelector::setVisible(const std::string& mid, bool visible, int64_t nowMs)
+	{
+		auto it = _tracks.find(mid);
+		if (it == _tracks.end()) {
+			return;
+		}
+
+		Track& track = it->second;
+		track.visible = visible;
+		retarget(track, nowMs);
+	}
+
+	void SimulcastLayerSelector::retarget(Track& track, int64_t nowMs)
+	{
+		const SimulcastLayer target = select(track.current, track.width, track.height, track.visible);
+		if (target != track.target) {
+			track.target = target;
+			track.since = nowMs;
+		}
+	}
+
+	void SimulcastLayerSelector::remove(const std::string& mid)
+	{
+		_tracks.erase(mid);
+	}
+
+	void SimulcastLayerSelector::clear()
+	{
+		_tracks.clear();
+	}
+
+	std::vector<std::pair<std::string, SimulcastLayer>> SimulcastLayerSelector::poll(int64_t nowMs)
+	{
+		std::vector<std::pair<std::string, SimulcastLayer>> changes;
+		for (auto& it : _tracks) {
+			Track& track = it.second;
+			if (track.target != track.current && nowMs - track.since >= delayOf(track)) {
+				track.current = track.target;
+				changes.emplace_back(it.first, track.current);
+			}
+		}
+		return changes;
+	}
+
+	absl::optional<int64_t> SimulcastLayerSelector::nextDeadline() const
+	{
+		absl::optional<int64_t> deadline;
+		for (const auto& it : _tracks) {
+			const Track& track = it.second;
+			if (track.target != track.current) {
+				const int64_t due = track.since + delayOf(track);
+				deadline = deadline ? std::min(*deadline, due) : due;
+			}
+		}
+		return deadline;
+	}
+
+	SimulcastLayer SimulcastLayerSelector::select(const SimulcastLayer& current, int32_t width, int32_t height, bool visible) const
+	{
+		SimulcastLayer layer;
+		if (!visible) {
+			// keep the layer, resuming then does not start from the bottom
+			layer = current;
+			layer.send = false;
+			return layer;
+		}
+
+		if (width <= 0 || height <= 0) {
+			// not laid out yet
+			layer = current;
+			layer.send = true;
+			return layer;
+		}
+
+		// the frame is drawn aspect-fit, so a wide tile is bound by its height and a tall one by its width
+		int32_t rendered = height;
+		if (_config.width > 0 && _config.height > 0) {
+			rendered = static_cast<int32_t>(std::min<int64_t>(height, (int64_t)width * _config.height / _config.width));
+		}
+
+		int32_t substream = std::max(0, std::min(current.substream, kTopSubstream));
+		if (layerHeight(substream) == 0) {
+			// not sent (any more), start from the closest layer that is
+			const int32_t below = sentBelow(substream);
+			substream = below >= 0 ? below : sentAbove(substream);
+		}
+		if (substream < 0) {
+			// no ladder known, Janus relays the best it gets
+			layer.substream = kTopSubstream;
+			layer.temporal = kTopTemporal;
+			return layer;
+		}
+
+		for (int32_t above = sentAbove(substream); above >= 0 && rendered > layerHeight(substream) * (1.0f + _config.margin); above = sentAbove(substream)) {
+			substream = above;
+		}
+		for (int32_t below = sentBelow(substream); below >= 0 && rendered < layerHeight(below) * (1.0f - _config.margin); below = sentBelow(substream)) {
+			substream = below;
+		}
+
+		layer.substream = substream;
+		// thumbnails far below the bottom layer do not need its full frame rate
+		layer.temporal = (sentBelow(substream) < 0 && rendered < layerHeight(substream) / 2) ? kTopTemporal - 1 : kTopTemporal;
+		return layer;
+	}
+
+	int32_t SimulcastLayerSelector::layerHeight(int32_t substream) const
+	{
+		return _config.layerHeights[substream];
+	}
+
+	int32_t SimulcastLayerSelector::sentAbove(int32_t substream) const
+	{
+		for (int32_t s = substream + 1; s <= kTopSubstream; ++s) {
+			if (layerHeight(s) > 0) {
+				return s;
+			}
+		}
+		return -1;
+	}
+
+	int32_t SimulcastLayerSelector::sentBelow(int32_t substream) const
+	{
+		for (int32_t s = substream - 1; s >= 0; --s) {
+			if (layerHeight(s) > 0) {
+				return s;
+			}
+		}
+		return -1;
+	}
+
+	int64_t SimulcastLayerSelector::delayOf(const Track& track) const
+	{
+		if (track.target.send != track.current.send) {
+			return track.target.send ? 0 : _config.downswitchDelayMs;
+		}
+
+		const bool down = track.target.substream < track.current.substream
+			|| (track.target.substream == track.current.substream && track.target.temporal < track.current.temporal);
+		return down ? _config.downswitchDelayMs : _config.upswitchDelayMs;
+	}
+}
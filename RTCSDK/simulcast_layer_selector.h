@@ -0,0 +1,117 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <map>
+#include <array>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "absl/types/optional.h"
+#include "simulcast_ladder.h"
+
+namespace vi {
+	struct SimulcastLayer {
+		int32_t substream = 2;
+		int32_t temporal = 2;
+		// false while the video is hidden, Janus then stops relaying it and the decoder idles
+		bool send = true;
+
+		bool operator==(const SimulcastLayer& other) const {
+			return substream == other.substream && temporal == other.temporal && send == other.send;
+		}
+
+		bool operator!=(const SimulcastLayer& other) const {
+			return !(*this == other);
+		}
+	};
+
+	// Picks the simulcast layer a remote video should be received at from the size it is rendered at.
+	// Substreams are sized after the ladder the publishers send, layers they do not send are never asked for.
+	// A layer switch is only committed
+	// once the new target held for a while, longer when switching down, and the size thresholds have a margin,
+	// so resizing a window or a tile flickering between two sizes does not flood Janus with configure requests.
+	// A hidden video is paused after the down-switch delay and resumed at once when it shows up again.
+	class SimulcastLayerSelector {
+	public:
+		static constexpr int32_t kTopSubstream = 2;
+
+		static constexpr int32_t kTopTemporal = 2;
+
+		struct Config {
+			// height of each substream, lowest first, 0 for one that is not sent. None known: the top layer is kept
+			std::array<int32_t, kTopSubstream + 1> layerHeights{};
+
+			// aspect ratio of the published video
+			int32_t width = 0;
+			int32_t height = 0;
+
+			// fraction a tile has to exceed (or undercut) a layer's height by before switching
+			float margin = 0.15f;
+
+			int64_t upswitchDelayMs = 300;
+			int64_t downswitchDelayMs = 1500;
+		};
+
+		SimulcastLayerSelector();
+
+		explicit SimulcastLayerSelector(const Config& config);
+
+		// The layers of |ladder| sent from a |width|x|height| capture, rids "h", "m" and "l" are substreams 2, 1 and 0
+		static Config fromLadder(const SimulcastLadder& ladder, int32_t width, int32_t height);
+
+		// Retargets the tracked videos against the new layers
+		void setConfig(const Config& config, int64_t nowMs);
+
+		// Starts tracking a received video, Janus starts off sending it at the top layer
+		void add(const std::string& mid);
+
+		// Reports the size in device pixels |mid| is rendered at, unknown mids are ignored
+		void update(const std::string& mid, int32_t width, int32_t height, bool visible, int64_t nowMs);
+
+		// Same as update() keeping the last reported size
+		void setVisible(const std::string& mid, bool visible, int64_t nowMs);
+
+		void remove(const std::string& mid);
+
+		void clear();
+
+		// Commits the targets that held long enough and returns them
+		std::vector<std::pair<std::string, SimulcastLayer>> poll(int64_t nowMs);
+
+		// When poll() has something to commit next, if anything is pending
+		absl::optional<int64_t> nextDeadline() const;
+
+	private:
+		struct Track {
+			SimulcastLayer current;
+			SimulcastLayer target;
+			int64_t since = 0;
+			int32_t width = 0;
+			int32_t height = 0;
+			bool visible = true;
+		};
+
+		void retarget(Track& track, int64_t nowMs);
+
+		SimulcastLayer select(const SimulcastLayer& current, int32_t width, int32_t height, bool visible) const;
+
+		int32_t layerHeight(int32_t substream) const;
+
+		// The closest substream above or below |substream| that is sent, -1 if there is none
+		int32_t sentAbove(int32_t substream) const;
+
+		int32_t sentBelow(int32_t substream) const;
+
+		int64_t delayOf(const Track& track) const;
+
+	private:
+		Config _config;
+
+		std::map<std::string, Track> _tracks;
+	};
+}
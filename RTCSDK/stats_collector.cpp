@@ -0,0 +1,262 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "stats_collector.h"
+#include <cstring>
+#include <algorithm>
+#include "api/stats/rtc_stats_report.h"
+#include "api/stats/rtcstats_objects.h"
+
+namespace {
+	template<typename T>
+	T valueOr(const webrtc::RTCStatsMember<T>& member, T fallback)
+	{
+		return member.is_defined() ? *member : fallback;
+	}
+
+	template<typename T>
+	const T* lookup(const webrtc::RTCStatsReport& report, const webrtc::RTCStatsMember<std::string>& id)
+	{
+		if (!id.is_defined()) {
+			return nullptr;
+		}
+		const webrtc::RTCStats* stats = report.Get(*id);
+		if (!stats || std::strcmp(stats->type(), T::kType) != 0) {
+			return nullptr;
+		}
+		return &stats->cast_to<T>();
+	}
+
+	// rtt of the pair the transport currently sends on, -1 before the first STUN round trip
+	double transportRoundTripTimeMs(const webrtc::RTCStatsReport& report)
+	{
+		for (const auto* pair : report.GetStatsOfType<webrtc::RTCIceCandidatePairStats>()) {
+			if (valueOr(pair->nominated, false) && pair->current_round_trip_time.is_defined()) {
+				return *pair->current_round_trip_time * 1000.0;
+			}
+		}
+		return -1;
+	}
+
+	std::string kindOf(const webrtc::RTCRTPStreamStats& stats)
+	{
+		if (stats.kind.is_defined()) {
+			return *stats.kind;
+		}
+		return valueOr(stats.media_type, std::string());
+	}
+}
+
+namespace vi {
+	StatsCollector::StatsCollector(size_t historySize)
+		: _historySize(std::max<size_t>(historySize, 1))
+	{
+	}
+
+	StatsCollector::~StatsCollector()
+	{
+	}
+
+	void StatsCollector::setHistorySize(size_t historySize)
+	{
+		historySize = std::max<size_t>(historySize, 1);
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (historySize == _historySize) {
+			return;
+		}
+		_historySize = historySize;
+		for (auto& pair : _streams) {
+			Stream& stream = pair.second;
+			std::vector<TrackStats> ring;
+			ring.reserve(historySize);
+			const size_t keep = std::min(stream.count, historySize);
+			for (size_t i = stream.count - keep; i < stream.count; ++i) {
+				ring.emplace_back(stream.ring[(stream.next + stream.ring.size() - stream.count + i) % stream.ring.size()]);
+			}
+			stream.count = ring.size();
+			stream.next = ring.size() % historySize;
+			ring.resize(historySize);
+			stream.ring = std::move(ring);
+		}
+	}
+
+	void StatsCollector::setTrackMids(std::unordered_map<std::string, std::string> mids)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_trackMids = std::move(mids);
+	}
+
+	StatsCollector::Stream& StatsCollector::stream(const std::string& id, const std::string& trackId, const std::string& kind, bool inbound)
+	{
+		Stream& stream = _streams[id];
+		if (stream.ring.empty()) {
+			stream.ring.resize(_historySize);
+			stream.info.kind = kind;
+			stream.info.inbound = inbound;
+		}
+		if (stream.info.mid.empty()) {
+			auto it = _trackMids.find(trackId);
+			if (it != _trackMids.end()) {
+				stream.info.mid = it->second;
+			}
+		}
+		stream.pass = _pass;
+		return stream;
+	}
+
+	bool StatsCollector::delta(Stream& stream, const Counters& now, TrackStats& sample)
+	{
+		const Counters last = stream.last;
+		const bool seeded = stream.seeded;
+		stream.last = now;
+		stream.seeded = true;
+
+		// a restarted stream (e.g. a reused ssrc) counts from zero again
+		if (!seeded || now.timestampUs <= last.timestampUs || now.bytes < last.bytes || now.frames < last.frames) {
+			return false;
+		}
+
+		const int64_t elapsedUs = now.timestampUs - last.timestampUs;
+		sample.timestampMs = now.timestampUs / 1000;
+		sample.bitrateBps = static_cast<int64_t>((now.bytes - last.bytes) * 8 * 1000000 / elapsedUs);
+
+		const uint64_t frames = now.frames - last.frames;
+		if (stream.info.kind == "video") {
+			sample.framesPerSecond = frames * 1000000.0 / elapsedUs;
+		}
+		if (frames > 0) {
+			sample.codecTimeMs = (now.codecTime - last.codecTime) * 1000.0 / frames;
+			if (now.qpSum >= last.qpSum) {
+				sample.qp = static_cast<double>(now.qpSum - last.qpSum) / frames;
+			}
+		}
+
+		if (stream.info.inbound && now.packets >= last.packets) {
+			const int64_t lost = std::max<int64_t>(now.packetsLost - last.packetsLost, 0);
+			const int64_t expected = lost + static_cast<int64_t>(now.packets - last.packets);
+			sample.lossRate = expected > 0 ? static_cast<double>(lost) / expected : 0;
+		}
+
+		return true;
+	}
+
+	void StatsCollector::push(Stream& stream, const TrackStats& sample)
+	{
+		stream.ring[stream.next] = sample;
+		stream.next = (stream.next + 1) % stream.ring.size();
+		stream.count = std::min(stream.count + 1, stream.ring.size());
+	}
+
+	void StatsCollector::ingest(const webrtc::RTCStatsReport& report)
+	{
+		const double transportRttMs = transportRoundTripTimeMs(report);
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		++_pass;
+
+		for (const auto* rtp : report.GetStatsOfType<webrtc::RTCInboundRTPStreamStats>()) {
+			const auto* track = lookup<webrtc::RTCMediaStreamTrackStats>(report, rtp->track_id);
+			const std::string trackId = track ? valueOr(track->track_identifier, std::string()) : std::string();
+			Stream& s = stream(rtp->id(), trackId, kindOf(*rtp), true);
+
+			Counters now;
+			now.timestampUs = rtp->timestamp_us();
+			now.bytes = valueOr(rtp->bytes_received, uint64_t(0));
+			now.packets = valueOr(rtp->packets_received, uint32_t(0));
+			now.packetsLost = valueOr(rtp->packets_lost, int32_t(0));
+			now.frames = valueOr(rtp->frames_decoded, uint32_t(0));
+			now.codecTime = valueOr(rtp->total_decode_time, 0.0);
+			now.qpSum = valueOr(rtp->qp_sum, uint64_t(0));
+
+			TrackStats sample;
+			if (!delta(s, now, sample)) {
+				continue;
+			}
+			if (rtp->jitter.is_defined()) {
+				sample.jitterMs = *rtp->jitter * 1000.0;
+			}
+			if (track && track->freeze_count.is_defined()) {
+				sample.freezeCount = *track->freeze_count;
+			}
+			sample.roundTripTimeMs = transportRttMs;
+			push(s, sample);
+		}
+
+		for (const auto* rtp : report.GetStatsOfType<webrtc::RTCOutboundRTPStreamStats>()) {
+			const auto* track = lookup<webrtc::RTCMediaStreamTrackStats>(report, rtp->track_id);
+			const std::string trackId = track ? valueOr(track->track_identifier, std::string()) : std::string();
+			Stream& s = stream(rtp->id(), trackId, kindOf(*rtp), false);
+			if (s.info.rid.empty() && rtp->rid.is_defined()) {
+				s.info.rid = *rtp->rid;
+			}
+
+			Counters now;
+			now.timestampUs = rtp->timestamp_us();
+			now.bytes = valueOr(rtp->bytes_sent, uint64_t(0));
+			now.packets = valueOr(rtp->packets_sent, uint32_t(0));
+			now.frames = valueOr(rtp->frames_encoded, uint32_t(0));
+			now.codecTime = valueOr(rtp->total_encode_time, 0.0);
+			now.qpSum = valueOr(rtp->qp_sum, uint64_t(0));
+
+			TrackStats sample;
+			if (!delta(s, now, sample)) {
+				continue;
+			}
+			sample.roundTripTimeMs = transportRttMs;
+			if (const auto* remote = lookup<webrtc::RTCRemoteInboundRtpStreamStats>(report, rtp->remote_id)) {
+				if (remote->jitter.is_defined()) {
+					sample.jitterMs = *remote->jitter * 1000.0;
+				}
+				if (remote->fraction_lost.is_defined()) {
+					sample.lossRate = *remote->fraction_lost;
+				}
+				if (remote->round_trip_time.is_defined()) {
+					sample.roundTripTimeMs = *remote->round_trip_time * 1000.0;
+				}
+			}
+			push(s, sample);
+		}
+
+		for (auto it = _streams.begin(); it != _streams.end();) {
+			if (it->second.pass != _pass) {
+				it = _streams.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+	}
+
+	std::vector<TrackStatsHistory> StatsCollector::history() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		std::vector<TrackStatsHistory> result;
+		result.reserve(_streams.size());
+		for (const auto& pair : _streams) {
+			const Stream& stream = pair.second;
+			if (stream.count == 0) {
+				continue;
+			}
+			TrackStatsHistory history = stream.info;
+			history.samples.reserve(stream.count);
+			const size_t size = stream.ring.size();
+			for (size_t i = 0; i < stream.count; ++i) {
+				history.samples.emplace_back(stream.ring[(stream.next + size - stream.count + i) % size]);
+			}
+			result.emplace_back(std::move(history));
+		}
+		return result;
+	}
+
+	void StatsCollector::clear()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_streams.clear();
+		_trackMids.clear();
+	}
+}
@@ -0,0 +1,88 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "track_stats.h"
+
+namespace webrtc {
+	class RTCStatsReport;
+}
+
+namespace vi {
+	// Turns the RTCStatsReports of one peer connection into compact per rtp stream samples.
+	// Only the typed members the samples need are read, the report is never serialized. Each stream keeps
+	// its last cumulative counters to compute the next delta and a ring of its last |historySize| samples.
+	// Ingested on the stats thread, read from any thread
+	class StatsCollector {
+	public:
+		explicit StatsCollector(size_t historySize = StatsConfig().historySize);
+
+		~StatsCollector();
+
+		// Keeps the newest samples of every stream when shrinking
+		void setHistorySize(size_t historySize);
+
+		// key: track id, value: mid; tracks are mapped to their transceiver by the owner of the peer connection
+		void setTrackMids(std::unordered_map<std::string, std::string> mids);
+
+		// Appends one sample per rtp stream of |report|, streams gone from the report are dropped.
+		// The first report of a stream only seeds its counters
+		void ingest(const webrtc::RTCStatsReport& report);
+
+		std::vector<TrackStatsHistory> history() const;
+
+		void clear();
+
+	private:
+		struct Counters {
+			int64_t timestampUs = 0;
+			uint64_t bytes = 0;
+			uint64_t packets = 0;
+			int64_t packetsLost = 0;
+			uint64_t frames = 0;
+			double codecTime = 0;
+			uint64_t qpSum = 0;
+		};
+
+		struct Stream {
+			TrackStatsHistory info;
+			Counters last;
+			bool seeded = false;
+			uint64_t pass = 0;
+			std::vector<TrackStats> ring;
+			size_t next = 0;
+			size_t count = 0;
+		};
+
+		Stream& stream(const std::string& id, const std::string& trackId, const std::string& kind, bool inbound);
+
+		void push(Stream& stream, const TrackStats& sample);
+
+		// Fills the rates of |sample| from the counters of the previous report, false if there is none to compare with
+		static bool delta(Stream& stream, const Counters& now, TrackStats& sample);
+
+		StatsCollector(const StatsCollector&) = delete;
+
+		StatsCollector& operator=(const StatsCollector&) = delete;
+
+	private:
+		mutable std::mutex _mutex;
+
+		size_t _historySize;
+
+		uint64_t _pass = 0;
+
+		// key: id of the rtp stream stats
+		std::unordered_map<std::string, Stream> _streams;
+
+		std::unordered_map<std::string, std::string> _trackMids;
+	};
+}
@@ -0,0 +1,81 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "subscription_set.h"
+#include <algorithm>
+#include <iterator>
+
+namespace vi {
+	void SubscriptionSet::want(const vr::Publisher& publisher)
+	{
+		if (!publisher.id) {
+			return;
+		}
+
+		const int64_t feed = publisher.id.value();
+		dropWanted(feed);
+
+		if (!publisher.streams) {
+			return;
+		}
+
+		for (const auto& stream : publisher.streams.value()) {
+			if (!stream.mid || stream.disabled.value_or(false)) {
+				continue;
+			}
+			_wanted.insert(StreamKey{ feed, stream.mid.value() });
+		}
+	}
+
+	void SubscriptionSet::drop(int64_t feed)
+	{
+		dropWanted(feed);
+	}
+
+	bool SubscriptionSet::dirty() const
+	{
+		return _wanted != _current;
+	}
+
+	SubscriptionSet::Diff SubscriptionSet::take()
+	{
+		Diff diff;
+		std::set_difference(_wanted.begin(), _wanted.end(), _current.begin(), _current.end(), std::back_inserter(diff.subscribe));
+		std::set_difference(_current.begin(), _current.end(), _wanted.begin(), _wanted.end(), std::back_inserter(diff.unsubscribe));
+		_current = _wanted;
+		return diff;
+	}
+
+	void SubscriptionSet::rollback(const Diff& diff)
+	{
+		for (const auto& key : diff.subscribe) {
+			_current.erase(key);
+		}
+		for (const auto& key : diff.unsubscribe) {
+			_current.insert(key);
+		}
+	}
+
+	void SubscriptionSet::reset()
+	{
+		_current.clear();
+	}
+
+	bool SubscriptionSet::empty() const
+	{
+		return _current.empty();
+	}
+
+	void SubscriptionSet::dropWanted(int64_t feed)
+	{
+		auto first = _wanted.lower_bound(StreamKey{ feed, std::string() });
+		auto last = first;
+		while (last != _wanted.end() && last->feed == feed) {
+			++last;
+		}
+		_wanted.erase(first, last);
+	}
+}
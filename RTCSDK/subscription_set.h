@@ -0,0 +1,64 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <set>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "video_room_models.h"
+
+namespace vi {
+	// The publisher streams a subscriber wants against the ones Janus is sending it.
+	// Publisher churn only edits the wanted set, take() then turns everything that changed
+	// since the last call into one subscribe/unsubscribe diff, i.e. one renegotiation.
+	class SubscriptionSet {
+	public:
+		struct StreamKey {
+			int64_t feed = 0;
+			std::string mid;
+
+			bool operator<(const StreamKey& other) const {
+				return feed != other.feed ? feed < other.feed : mid < other.mid;
+			}
+		};
+
+		struct Diff {
+			std::vector<StreamKey> subscribe;
+			std::vector<StreamKey> unsubscribe;
+
+			bool empty() const { return subscribe.empty() && unsubscribe.empty(); }
+		};
+
+		// Wants every enabled stream of |publisher|, replacing what was wanted from it before
+		void want(const vr::Publisher& publisher);
+
+		void drop(int64_t feed);
+
+		bool dirty() const;
+
+		// What has to change to get from the current to the wanted set, assumed applied from then on
+		Diff take();
+
+		// Undoes a diff Janus refused
+		void rollback(const Diff& diff);
+
+		// Janus dropped the subscription, e.g. on hangup
+		void reset();
+
+		// Nothing subscribed yet, the next diff goes into a "join"
+		bool empty() const;
+
+	private:
+		void dropWanted(int64_t feed);
+
+	private:
+		std::set<StreamKey> _wanted;
+
+		std::set<StreamKey> _current;
+	};
+}
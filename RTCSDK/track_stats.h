@@ -0,0 +1,63 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace vi {
+	struct StatsConfig {
+		// period of the GetStats poll, every sample covers one period
+		int64_t intervalMs = 2000;
+
+		// samples kept per rtp stream
+		size_t historySize = 30;
+	};
+
+	// One rtp stream over one poll period, rates and averages are computed from the deltas of the
+	// cumulative counters of two consecutive reports. -1 means webrtc did not report the input
+	struct TrackStats {
+		int64_t timestampMs = 0;
+
+		int64_t bitrateBps = 0;
+
+		double framesPerSecond = -1;
+
+		double jitterMs = -1;
+
+		// lost / expected packets, from RTCP receiver reports on the sending side
+		double lossRate = -1;
+
+		double roundTripTimeMs = -1;
+
+		// total freezes seen by the renderer, inbound video only
+		int64_t freezeCount = -1;
+
+		// average decode time (inbound) or encode time (outbound) per frame
+		double codecTimeMs = -1;
+
+		// average qp per frame
+		double qp = -1;
+	};
+
+	struct TrackStatsHistory {
+		std::string mid;
+
+		// simulcast layer of an outbound video, empty otherwise
+		std::string rid;
+
+		// "audio" or "video"
+		std::string kind;
+
+		bool inbound = true;
+
+		// oldest first
+		std::vector<TrackStats> samples;
+	};
+}
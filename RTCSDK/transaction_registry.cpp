@@ -0,0 +1,228 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "transaction_registry.h"
+#include <thread>
+#include <chrono>
+#include "rtc_base/time_utils.h"
+
+namespace {
+	constexpr uint64_t kEmpty = 0;
+
+	constexpr uint64_t kLocked = UINT64_MAX;
+
+	// retries of a locked slot before giving the core away, a holder is usually done by then
+	constexpr uint32_t kSpins = 64;
+
+	// yields before sleeping, the holder of the slot is probably not running
+	constexpr uint32_t kYields = 16;
+
+	constexpr std::chrono::microseconds kSleep{ 50 };
+
+	// Waits out the holder of a locked slot, a little longer on every call
+	class Backoff {
+	public:
+		void wait()
+		{
+			if (_rounds < kSpins) {
+				++_rounds;
+			}
+			else if (_rounds < kSpins + kYields) {
+				++_rounds;
+				std::this_thread::yield();
+			}
+			else {
+				std::this_thread::sleep_for(kSleep);
+			}
+		}
+
+	private:
+		uint32_t _rounds = 0;
+	};
+
+	size_t roundUpPowerOfTwo(size_t value)
+	{
+		size_t result = 1;
+		while (result < value) {
+			result <<= 1;
+		}
+		return result;
+	}
+
+	size_t bucketOf(int64_t elapsed)
+	{
+		size_t bucket = 0;
+		while (elapsed > 0 && bucket < vi::TransactionStats::kBuckets - 1) {
+			elapsed >>= 1;
+			++bucket;
+		}
+		return bucket;
+	}
+}
+
+namespace vi {
+	TransactionRegistry::TransactionRegistry(size_t capacity)
+		: _mask(roundUpPowerOfTwo(capacity) - 1)
+		, _slots(new Slot[_mask + 1])
+	{
+	}
+
+	TransactionRegistry::~TransactionRegistry()
+	{
+	}
+
+	bool TransactionRegistry::lock(Slot& slot, uint64_t id)
+	{
+		Backoff backoff;
+		for (;;) {
+			uint64_t current = id;
+			if (slot.id.compare_exchange_weak(current, kLocked, std::memory_order_acquire, std::memory_order_relaxed)) {
+				return true;
+			}
+			if (current == kLocked) {
+				backoff.wait();
+			}
+			else if (current != id) {
+				return false;
+			}
+		}
+	}
+
+	std::shared_ptr<JCHandler> TransactionRegistry::release(Slot& slot)
+	{
+		std::shared_ptr<JCHandler> handler = std::move(slot.handler);
+		slot.id.store(kEmpty, std::memory_order_release);
+		return handler;
+	}
+
+	std::shared_ptr<JCHandler> TransactionRegistry::add(std::shared_ptr<JCHandler> handler)
+	{
+		if (!handler || handler->id == kEmpty || handler->id == kLocked) {
+			return nullptr;
+		}
+
+		Slot& slot = _slots[handler->id & _mask];
+		uint64_t current = slot.id.load(std::memory_order_relaxed);
+		Backoff backoff;
+		for (;;) {
+			if (current == kLocked) {
+				backoff.wait();
+				current = slot.id.load(std::memory_order_relaxed);
+			}
+			else if (slot.id.compare_exchange_weak(current, kLocked, std::memory_order_acquire, std::memory_order_relaxed)) {
+				break;
+			}
+		}
+
+		std::shared_ptr<JCHandler> displaced = std::move(slot.handler);
+		if (displaced) {
+			recordTimeout(displaced->type);
+		}
+
+		const int64_t now = rtc::TimeMillis();
+		const uint64_t id = handler->id;
+		slot.sentAt = now;
+		slot.deadline.store(now + handler->timeout, std::memory_order_relaxed);
+		slot.handler = std::move(handler);
+		slot.id.store(id, std::memory_order_release);
+
+		return displaced;
+	}
+
+	std::shared_ptr<JCHandler> TransactionRegistry::take(uint64_t id)
+	{
+		if (id == kEmpty || id == kLocked) {
+			return nullptr;
+		}
+
+		Slot& slot = _slots[id & _mask];
+		if (!lock(slot, id)) {
+			return nullptr;
+		}
+
+		const int64_t elapsed = rtc::TimeMillis() - slot.sentAt;
+		std::shared_ptr<JCHandler> handler = release(slot);
+		record(handler->type, elapsed);
+
+		return handler;
+	}
+
+	std::vector<std::shared_ptr<JCHandler>> TransactionRegistry::expire()
+	{
+		std::vector<std::shared_ptr<JCHandler>> expired;
+
+		const int64_t now = rtc::TimeMillis();
+		for (size_t i = 0; i <= _mask; ++i) {
+			Slot& slot = _slots[i];
+			const uint64_t id = slot.id.load(std::memory_order_acquire);
+			if (id == kEmpty || id == kLocked || slot.deadline.load(std::memory_order_relaxed) > now) {
+				continue;
+			}
+			if (!lock(slot, id)) {
+				continue;
+			}
+			std::shared_ptr<JCHandler> handler = release(slot);
+			recordTimeout(handler->type);
+			expired.emplace_back(std::move(handler));
+		}
+
+		return expired;
+	}
+
+	std::vector<std::shared_ptr<JCHandler>> TransactionRegistry::clear()
+	{
+		std::vector<std::shared_ptr<JCHandler>> pending;
+
+		for (size_t i = 0; i <= _mask; ++i) {
+			Slot& slot = _slots[i];
+			const uint64_t id = slot.id.load(std::memory_order_acquire);
+			if (id == kEmpty || id == kLocked) {
+				continue;
+			}
+			if (lock(slot, id)) {
+				pending.emplace_back(release(slot));
+			}
+		}
+
+		return pending;
+	}
+
+	std::vector<TransactionStats> TransactionRegistry::stats() const
+	{
+		std::vector<TransactionStats> result(_histograms.size());
+		for (size_t i = 0; i < _histograms.size(); ++i) {
+			const Histogram& histogram = _histograms[i];
+			TransactionStats& stats = result[i];
+			stats.type = static_cast<RequestType>(i);
+			stats.completed = histogram.completed.load(std::memory_order_relaxed);
+			stats.timedOut = histogram.timedOut.load(std::memory_order_relaxed);
+			for (size_t b = 0; b < TransactionStats::kBuckets; ++b) {
+				stats.buckets[b] = histogram.buckets[b].load(std::memory_order_relaxed);
+			}
+		}
+		return result;
+	}
+
+	void TransactionRegistry::record(RequestType type, int64_t elapsed)
+	{
+		const size_t index = static_cast<size_t>(type);
+		if (index >= _histograms.size()) {
+			return;
+		}
+		Histogram& histogram = _histograms[index];
+		histogram.buckets[bucketOf(elapsed)].fetch_add(1, std::memory_order_relaxed);
+		histogram.completed.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void TransactionRegistry::recordTimeout(RequestType type)
+	{
+		const size_t index = static_cast<size_t>(type);
+		if (index >= _histograms.size()) {
+			return;
+		}
+		_histograms[index].timedOut.fetch_add(1, std::memory_order_relaxed);
+	}
+}
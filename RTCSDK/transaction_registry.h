@@ -0,0 +1,75 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <atomic>
+#include "i_message_transport.h"
+#include "transaction_stats.h"
+
+namespace vi {
+	// Pending transactions of one transport, keyed by their integer id.
+	// A transaction lives in slot |id & (capacity - 1)|, the slot's id word doubles as a per-slot spin lock
+	// (kEmpty / kLocked / owner id), so registering and resolving never take a mutex nor touch the heap.
+	// It is not lock-free: a thread finding its slot locked waits for the holder, which only moves a handler
+	// in or out, and backs off from spinning to yielding to sleeping should the holder have been preempted.
+	// An id that is still pending |capacity| ids later gets displaced and is handed back to the caller.
+	class TransactionRegistry {
+	public:
+		explicit TransactionRegistry(size_t capacity = 4096);
+
+		~TransactionRegistry();
+
+		// Returns the handler that previously owned the slot, if any
+		std::shared_ptr<JCHandler> add(std::shared_ptr<JCHandler> handler);
+
+		// Removes the pending handler of |id| and accounts its round trip, nullptr if unknown or already resolved
+		std::shared_ptr<JCHandler> take(uint64_t id);
+
+		// Removes every handler whose deadline has passed
+		std::vector<std::shared_ptr<JCHandler>> expire();
+
+		// Removes every pending handler
+		std::vector<std::shared_ptr<JCHandler>> clear();
+
+		std::vector<TransactionStats> stats() const;
+
+	private:
+		struct Slot {
+			std::atomic<uint64_t> id{ 0 };
+			std::atomic<int64_t> deadline{ 0 };
+			int64_t sentAt = 0;
+			std::shared_ptr<JCHandler> handler;
+		};
+
+		struct Histogram {
+			std::atomic<uint64_t> completed{ 0 };
+			std::atomic<uint64_t> timedOut{ 0 };
+			std::array<std::atomic<uint64_t>, TransactionStats::kBuckets> buckets{};
+		};
+
+		bool lock(Slot& slot, uint64_t id);
+
+		std::shared_ptr<JCHandler> release(Slot& slot);
+
+		void record(RequestType type, int64_t elapsed);
+
+		void recordTimeout(RequestType type);
+
+		TransactionRegistry(const TransactionRegistry&) = delete;
+
+		TransactionRegistry& operator=(const TransactionRegistry&) = delete;
+
+	private:
+		const size_t _mask;
+
+		std::unique_ptr<Slot[]> _slots;
+
+		std::array<Histogram, static_cast<size_t>(RequestType::COUNT)> _histograms;
+	};
+}
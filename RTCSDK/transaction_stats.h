@@ -0,0 +1,76 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+
+namespace vi {
+	enum class RequestType : uint32_t {
+		CREATE = 0,
+		CLAIM,
+		DESTROY,
+		KEEPALIVE,
+		ATTACH,
+		DETACH,
+		MESSAGE,
+		TRICKLE,
+		HANGUP,
+		COUNT
+	};
+
+	inline const char* requestTypeName(RequestType type)
+	{
+		switch (type) {
+		case RequestType::CREATE: return "create";
+		case RequestType::CLAIM: return "claim";
+		case RequestType::DESTROY: return "destroy";
+		case RequestType::KEEPALIVE: return "keepalive";
+		case RequestType::ATTACH: return "attach";
+		case RequestType::DETACH: return "detach";
+		case RequestType::MESSAGE: return "message";
+		case RequestType::TRICKLE: return "trickle";
+		case RequestType::HANGUP: return "hangup";
+		default: return "unknown";
+		}
+	}
+
+	// Round trip latency of one request type, measured from send() to the first reply carrying the transaction.
+	// buckets[0] counts replies within 1ms, buckets[i] those within [2^(i-1), 2^i) ms, the last bucket is open ended
+	struct TransactionStats {
+		static constexpr size_t kBuckets = 17;
+
+		RequestType type = RequestType::CREATE;
+
+		uint64_t completed = 0;
+
+		uint64_t timedOut = 0;
+
+		std::array<uint64_t, kBuckets> buckets{};
+
+		// Upper bound in ms of the bucket holding the |p|-th percentile (0.0 ~ 1.0), -1 if nothing completed yet
+		int64_t percentile(double p) const
+		{
+			if (completed == 0) {
+				return -1;
+			}
+			uint64_t rank = static_cast<uint64_t>(p * completed);
+			if (rank == 0) {
+				rank = 1;
+			}
+			uint64_t seen = 0;
+			for (size_t i = 0; i < kBuckets; ++i) {
+				seen += buckets[i];
+				if (seen >= rank) {
+					return int64_t(1) << i;
+				}
+			}
+			return int64_t(1) << (kBuckets - 1);
+		}
+	};
+}
@@ -5,6 +5,10 @@
 #include <string>
 #include "absl/types/optional.h"
 
+namespace rtc {
+    class Thread;
+}
+
 namespace vi {
 
     class INotification;
@@ -19,6 +23,9 @@ namespace vi {
         virtual ~IObserver() = default;
         
         virtual absl::optional<std::string> scheduleThread() = 0;
+
+        // |scheduleThread| resolved when the observer was created
+        virtual rtc::Thread* thread() = 0;
         
         virtual void notify(const std::shared_ptr<INotification>& nf) = 0;
         
@@ -102,13 +102,12 @@ public:
             
         }
     
-    R marshal(const std::string& name) {
+    R marshal(rtc::Thread* thread) {
 		const auto task = [&]() {
 			this->invoke(std::index_sequence_for<Args...>());
 			_promises.set_value();
 		};
 
-		rtc::Thread* thread = TMgr->thread(name);
 		assert(thread);
 		if (thread->IsCurrent()) {
             task();
@@ -171,16 +170,18 @@ private:
     c##ProxyWithInternal(std::shared_ptr<INTERNAL_CLASS> c,                         \
     const std::string& threadName)                                                  \
     : _threadName(threadName)                                                      \
+    , _thread(TMgr->thread(threadName))                                            \
     , _c(c) {}                                                                     \
     private:                                                                        \
-    const std::string _threadName;
+    const std::string _threadName;                                                  \
+    rtc::Thread* const _thread;
 
 #define SHARED_PROXY_MAP_BOILERPLATE(c)                                             \
     public:                                                                         \
     ~c##ProxyWithInternal() {                                                       \
     MethodCall<c##ProxyWithInternal, void> call(                                    \
     this, &c##ProxyWithInternal::destroyInternal);                                  \
-    call.marshal(_threadName);                                                     \
+    call.marshal(_thread);                                                         \
     }                                                                               \
     private:                                                                        \
     void destroyInternal() { _c = nullptr; }                                       \
@@ -209,27 +210,27 @@ private:
 #define PROXY_METHOD0(r, method)                                                    \
     r method() override {                                                           \
     MethodCall<C, r> call(_c.get(), &C::method);                                   \
-    return call.marshal(_threadName);                                              \
+    return call.marshal(_thread);                                                  \
 }
 
 #define PROXY_METHOD1(r, method, t1)                                                \
     r method(t1 a1) override {                                                      \
     MethodCall<C, r, t1> call(_c.get(), &C::method, std::move(a1));                \
-    return call.marshal(_threadName);                                              \
+    return call.marshal(_thread);                                                  \
 }
 
 #define PROXY_METHOD2(r, method, t1, t2)                                            \
     r method(t1 a1, t2 a2) override {                                               \
     MethodCall<C, r, t1, t2> call(_c.get(), &C::method, std::move(a1),             \
     std::move(a2));                                                                 \
-    return call.marshal(_threadName);                                              \
+    return call.marshal(_thread);                                                  \
 }
 
 #define PROXY_METHOD3(r, method, t1, t2, t3)                                        \
     r method(t1 a1, t2 a2, t3 a3) override {                                        \
     MethodCall<C, r, t1, t2, t3> call(_c.get(), &C::method, std::move(a1),         \
     std::move(a2), std::move(a3));                                                  \
-    return call.marshal(_threadName);                                              \
+    return call.marshal(_thread);                                                  \
 }
 
 #define PROXY_METHOD4(r, method, t1, t2, t3, t4)                                    \
@@ -237,7 +238,7 @@ private:
     MethodCall<C, r, t1, t2, t3, t4> call(_c.get(), &C::method, std::move(a1),     \
     std::move(a2), std::move(a3),                                                   \
     std::move(a4));                                                                 \
-    return call.marshal(_threadName);                                              \
+    return call.marshal(_thread);                                                  \
 }
 
 #define PROXY_METHOD5(r, method, t1, t2, t3, t4, t5)                                \
@@ -245,7 +246,7 @@ private:
     MethodCall<C, r, t1, t2, t3, t4, t5> call(_c.get(), &C::method, std::move(a1), \
     std::move(a2), std::move(a3),                                                   \
     std::move(a4), std::move(a5));                                                  \
-    return call.marshal(_threadName);                                              \
+    return call.marshal(_thread);                                                  \
 }
 
 }
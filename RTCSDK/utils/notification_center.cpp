@@ -86,8 +86,7 @@ namespace vi {
 
         for (const auto& observer : observers) {
             if (observer && observer->shouldAccept(notification)) {
-                absl::optional<std::string> scheduleThread = observer->scheduleThread();
-                rtc::Thread* thread = TMgr->thread(scheduleThread.value_or(""));
+                rtc::Thread* thread = observer->thread();
                 assert(thread);
                 if (thread->IsCurrent()) {
 				    observer->notify(notification);
@@ -4,6 +4,7 @@
 #include <memory>
 #include <functional>
 #include "i_observer.hpp"
+#include "thread_provider.h"
 #include "rtc_base/deprecated/recursive_critical_section.h"
 
 namespace vi {
@@ -17,7 +18,8 @@ namespace vi {
         Observer(const std::shared_ptr<T>& object, Method method)
         : _object(object)
         , _method(method)
-        , m_queue(std::string("main"))
+        , _scheduleThread(std::string("main"))
+        , _thread(TMgr->thread(NamedThread::MAIN))
         {
         }
         
@@ -25,6 +27,7 @@ namespace vi {
         : _object(object)
         , _method(method)
         , _scheduleThread(scheduleThread)
+        , _thread(TMgr->thread(scheduleThread.value_or("")))
         {
         }
         
@@ -32,6 +35,7 @@ namespace vi {
         : _object(observer._object)
         , _method(observer._method)
         , _scheduleThread(observer._scheduleThread)
+        , _thread(observer._thread)
         {
         }
         
@@ -40,6 +44,7 @@ namespace vi {
                 _object = observer._object;
                 _method = observer._method;
                 _scheduleThread = observer._scheduleThread;
+                _thread = observer._thread;
             }
             return *this;
         }
@@ -52,6 +57,11 @@ namespace vi {
         {
             return _scheduleThread;
         }
+
+        rtc::Thread* thread() override
+        {
+            return _thread;
+        }
         
         void notify(const std::shared_ptr<INotification>& notification) override
         {
@@ -102,6 +112,7 @@ namespace vi {
         std::weak_ptr<T> _object;
         Method _method;
         absl::optional<std::string> _scheduleThread;
+        rtc::Thread* _thread = nullptr;
     };
 
 }
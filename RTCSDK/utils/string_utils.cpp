@@ -6,23 +6,17 @@
 
 #include "string_utils.h"
 #include <random>
-#include <time.h>
-#include <chrono>
-#include "logger/logger.h"
 
 namespace vi {
-	// Helper method to create random identifiers (e.g., transaction)
-	 std::string StringUtils::randomString(int32_t len) {
-		std::string charSet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
-		std::string randomString;
+	// Helper method to create random identifiers (e.g., opaque id), transactions use TransactionId instead
+	std::string StringUtils::randomString(int32_t len) {
+		static const char charSet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+		static thread_local std::mt19937 engine(std::random_device{}());
+		std::uniform_int_distribution<int> dist(0, sizeof(charSet) - 2);
 
-		std::default_random_engine engine((int64_t)std::chrono::steady_clock::now().time_since_epoch().count());
-		std::uniform_int_distribution<int> dist(0, charSet.length() - 1);
-
-		for (int32_t i = 0; i < len; ++i) {
-			int32_t randomPoz = dist(engine);
-			//DLOG("--> pos = {}", randomPoz);
-			randomString += charSet.substr(randomPoz, 1);
+		std::string randomString(len > 0 ? len : 0, '\0');
+		for (auto& c : randomString) {
+			c = charSet[dist(engine)];
 		}
 		return randomString;
 	}
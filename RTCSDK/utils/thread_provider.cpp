@@ -11,6 +11,12 @@
 #include "rtc_base/physical_socket_server.h"
 #include "logger/logger.h"
 
+namespace {
+	const char* kThreadNames[] = { "main", "signaling-service", "plugin-client", "message-transport", "capture-session", "timer-service", "stats-collector" };
+
+	static_assert(sizeof(kThreadNames) / sizeof(kThreadNames[0]) == static_cast<size_t>(vi::NamedThread::COUNT), "kThreadNames is out of sync with NamedThread");
+}
+
 namespace vi {
 	ThreadProvider::ThreadProvider() : _destroy(true), _inited(false)
 	{
@@ -31,6 +37,8 @@ namespace vi {
 
 		_mainThread = rtc::ThreadManager::Instance()->CurrentThread();
 
+		_handles[static_cast<size_t>(NamedThread::MAIN)].store(_mainThread, std::memory_order_release);
+
 		_inited = true;
 	}
 
@@ -52,6 +60,10 @@ namespace vi {
 			_threadsMap[name] = rtc::Thread::Create();
 			_threadsMap[name]->SetName(name, nullptr);
 			_threadsMap[name]->Start();
+
+			if (auto id = namedThread(name)) {
+				_handles[static_cast<size_t>(id.value())].store(_threadsMap[name].get(), std::memory_order_release);
+			}
 		}
 	}
 
@@ -59,6 +71,12 @@ namespace vi {
 	{
 		std::lock_guard<std::mutex> lock(_mutex);
 
+		for (size_t i = 0; i < _handles.size(); ++i) {
+			if (i != static_cast<size_t>(NamedThread::MAIN)) {
+				_handles[i].store(nullptr, std::memory_order_release);
+			}
+		}
+
 		for (const auto& thread : _threadsMap) {
 			thread.second->Stop();
 		}
@@ -80,4 +98,23 @@ namespace vi {
 
 		return nullptr;
 	}
+
+	rtc::Thread* ThreadProvider::thread(NamedThread id) const
+	{
+		const size_t index = static_cast<size_t>(id);
+		if (index >= _handles.size()) {
+			return nullptr;
+		}
+		return _handles[index].load(std::memory_order_acquire);
+	}
+
+	absl::optional<NamedThread> ThreadProvider::namedThread(const std::string& name)
+	{
+		for (size_t i = 0; i < static_cast<size_t>(NamedThread::COUNT); ++i) {
+			if (name == kThreadNames[i]) {
+				return static_cast<NamedThread>(i);
+			}
+		}
+		return absl::nullopt;
+	}
 }
\ No newline at end of file
@@ -11,11 +11,25 @@
 #include <atomic>
 #include <string>
 #include <list>
+#include <array>
+#include "absl/types/optional.h"
 #include "rtc_base/thread.h"
 #include "service/rtc_engine.h"
 
 namespace vi {
 
+	// Threads every component knows about, resolved to a handle without locking or hashing a name
+	enum class NamedThread : uint32_t {
+		MAIN = 0,
+		SIGNALING_SERVICE,
+		PLUGIN_CLIENT,
+		MESSAGE_TRANSPORT,
+		CAPTURE_SESSION,
+		TIMER_SERVICE,
+		STATS_COLLECTOR,
+		COUNT
+	};
+
 	class ThreadProvider
 	{
 	public:
@@ -29,8 +43,13 @@ namespace vi {
 
 		void create(const std::list<std::string>& threadNames);
 
+		// Takes the provider lock, meant for setup code; per event paths use the NamedThread overload
 		rtc::Thread* thread(const std::string& name);
 
+		rtc::Thread* thread(NamedThread id) const;
+
+		static absl::optional<NamedThread> namedThread(const std::string& name);
+
 	private:
 		ThreadProvider(const ThreadProvider&) = delete;
 
@@ -51,6 +70,8 @@ namespace vi {
 		std::atomic_bool _inited;
 
 		std::atomic_bool _destroy;
+
+		std::array<std::atomic<rtc::Thread*>, static_cast<size_t>(NamedThread::COUNT)> _handles{};
 	};
 }
 
@@ -0,0 +1,339 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "timer_service.h"
+#include <algorithm>
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+
+namespace vi {
+	TimerService::TimerService()
+	{
+		_buckets.fill(kNil);
+	}
+
+	TimerService::~TimerService()
+	{
+	}
+
+	void TimerService::init(rtc::Thread* thread)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_thread = thread;
+		_current = nowTick();
+	}
+
+	void TimerService::destroy()
+	{
+		std::vector<std::shared_ptr<std::function<void()>>> callbacks;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			for (int32_t i = 0; i < static_cast<int32_t>(_slots.size()); ++i) {
+				if (_slots[i].state != SlotState::FREE) {
+					callbacks.emplace_back(release(i));
+				}
+			}
+			_buckets.fill(kNil);
+			_pending = 0;
+			_wakeTick = UINT64_MAX;
+			++_wakeSequence;
+			_thread = nullptr;
+		}
+	}
+
+	TimerId TimerService::schedule(rtc::Thread* executor, std::function<void()> callback, int64_t delayMs)
+	{
+		return add(executor, std::move(callback), delayMs, false);
+	}
+
+	TimerId TimerService::scheduleRepeating(rtc::Thread* executor, std::function<void()> callback, int64_t periodMs)
+	{
+		return add(executor, std::move(callback), periodMs, true);
+	}
+
+	TimerId TimerService::add(rtc::Thread* executor, std::function<void()> callback, int64_t delayMs, bool repeating)
+	{
+		if (!executor || !callback) {
+			return 0;
+		}
+
+		// rounded up, a timer never fires before its delay
+		const int64_t ticks = std::max<int64_t>((delayMs + kTickMs - 1) / kTickMs, repeating ? 1 : 0);
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_thread) {
+			return 0;
+		}
+
+		const uint64_t now = nowTick();
+		if (_pending == 0 && now > _current) {
+			// nothing on the wheel, skip the ticks it slept through
+			_current = now;
+		}
+
+		const int32_t index = allocate();
+		Slot& slot = _slots[index];
+		slot.state = SlotState::PENDING;
+		slot.expires = std::max(now + ticks, _current);
+		slot.periodTicks = repeating ? ticks : 0;
+		slot.executor = executor;
+		slot.callback = std::make_shared<std::function<void()>>(std::move(callback));
+		link(index);
+
+		arm(nextWakeTick());
+
+		return makeId(index, slot.generation);
+	}
+
+	bool TimerService::cancel(TimerId id)
+	{
+		std::shared_ptr<std::function<void()>> callback;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			const int32_t index = static_cast<int32_t>(id & 0xffffffff);
+			if (id == 0 || index >= static_cast<int32_t>(_slots.size())) {
+				return false;
+			}
+			Slot& slot = _slots[index];
+			if (slot.generation != static_cast<uint32_t>(id >> 32) || slot.state == SlotState::FREE) {
+				return false;
+			}
+			if (slot.state == SlotState::PENDING) {
+				unlink(index);
+			}
+			callback = release(index);
+		}
+		return true;
+	}
+
+	size_t TimerService::size() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _pending;
+	}
+
+	int32_t TimerService::allocate()
+	{
+		if (_freeHead != kNil) {
+			const int32_t index = _freeHead;
+			_freeHead = _slots[index].next;
+			_slots[index].next = kNil;
+			return index;
+		}
+		_slots.emplace_back();
+		return static_cast<int32_t>(_slots.size() - 1);
+	}
+
+	std::shared_ptr<std::function<void()>> TimerService::release(int32_t index)
+	{
+		Slot& slot = _slots[index];
+		if (++slot.generation == 0) {
+			slot.generation = 1;
+		}
+		slot.state = SlotState::FREE;
+		slot.executor = nullptr;
+		slot.prev = kNil;
+		slot.bucket = kNil;
+		slot.next = _freeHead;
+		_freeHead = index;
+		return std::move(slot.callback);
+	}
+
+	void TimerService::link(int32_t index)
+	{
+		Slot& slot = _slots[index];
+
+		constexpr uint64_t kRootSpan = uint64_t(1) << kRootBits;
+		constexpr uint64_t kLevelMask = (uint64_t(1) << kLevelBits) - 1;
+
+		const uint64_t delta = slot.expires > _current ? slot.expires - _current : 0;
+		int32_t bucket = kNil;
+		if (delta < kRootSpan) {
+			bucket = static_cast<int32_t>(std::max(slot.expires, _current) & (kRootSpan - 1));
+		}
+		else {
+			for (size_t level = 1; level < kLevels; ++level) {
+				const size_t shift = kRootBits + level * kLevelBits;
+				// beyond the last level the timer waits in its farthest bucket and is cascaded again
+				const uint64_t expires = level == kLevels - 1 ? std::min(slot.expires, _current + (uint64_t(1) << shift) - 1) : slot.expires;
+				if (delta < (uint64_t(1) << shift) || level == kLevels - 1) {
+					const uint64_t offset = (expires >> (shift - kLevelBits)) & kLevelMask;
+					bucket = static_cast<int32_t>(kRootSpan + (level - 1) * (kLevelMask + 1) + offset);
+					break;
+				}
+			}
+		}
+
+		slot.bucket = bucket;
+		slot.prev = kNil;
+		slot.next = _buckets[bucket];
+		if (slot.next != kNil) {
+			_slots[slot.next].prev = index;
+		}
+		_buckets[bucket] = index;
+		++_pending;
+	}
+
+	void TimerService::unlink(int32_t index)
+	{
+		Slot& slot = _slots[index];
+		if (slot.prev != kNil) {
+			_slots[slot.prev].next = slot.next;
+		}
+		else {
+			_buckets[slot.bucket] = slot.next;
+		}
+		if (slot.next != kNil) {
+			_slots[slot.next].prev = slot.prev;
+		}
+		slot.prev = kNil;
+		slot.next = kNil;
+		slot.bucket = kNil;
+		--_pending;
+	}
+
+	void TimerService::cascade(int32_t bucket)
+	{
+		int32_t index = _buckets[bucket];
+		while (index != kNil) {
+			const int32_t next = _slots[index].next;
+			unlink(index);
+			link(index);
+			index = next;
+		}
+	}
+
+	void TimerService::fire(int32_t index, std::vector<std::pair<rtc::Thread*, TimerId>>& due)
+	{
+		Slot& slot = _slots[index];
+		unlink(index);
+		due.emplace_back(slot.executor, makeId(index, slot.generation));
+		if (slot.periodTicks > 0) {
+			slot.expires = _current + slot.periodTicks;
+			link(index);
+		}
+		else {
+			slot.state = SlotState::FIRING;
+		}
+	}
+
+	void TimerService::advance(std::vector<std::pair<rtc::Thread*, TimerId>>& due)
+	{
+		constexpr uint64_t kRootMask = (uint64_t(1) << kRootBits) - 1;
+		constexpr uint64_t kLevelMask = (uint64_t(1) << kLevelBits) - 1;
+
+		const uint64_t now = nowTick();
+		while (_current <= now && _pending > 0) {
+			const uint64_t root = _current & kRootMask;
+			if (root == 0) {
+				for (size_t level = 1; level < kLevels; ++level) {
+					const uint64_t offset = (_current >> (kRootBits + (level - 1) * kLevelBits)) & kLevelMask;
+					cascade(static_cast<int32_t>((kRootMask + 1) + (level - 1) * (kLevelMask + 1) + offset));
+					if (offset != 0) {
+						break;
+					}
+				}
+			}
+
+			int32_t index = _buckets[root];
+			while (index != kNil) {
+				const int32_t next = _slots[index].next;
+				fire(index, due);
+				index = next;
+			}
+			++_current;
+		}
+		if (_pending == 0 && _current <= now) {
+			_current = now + 1;
+		}
+	}
+
+	void TimerService::run(TimerId id)
+	{
+		std::shared_ptr<std::function<void()>> callback;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			const int32_t index = static_cast<int32_t>(id & 0xffffffff);
+			if (index >= static_cast<int32_t>(_slots.size())) {
+				return;
+			}
+			Slot& slot = _slots[index];
+			if (slot.generation != static_cast<uint32_t>(id >> 32) || slot.state == SlotState::FREE) {
+				return;
+			}
+			if (slot.state == SlotState::FIRING) {
+				callback = release(index);
+			}
+			else {
+				callback = slot.callback;
+			}
+		}
+		if (callback) {
+			(*callback)();
+		}
+	}
+
+	uint64_t TimerService::nextWakeTick() const
+	{
+		if (_pending == 0) {
+			return UINT64_MAX;
+		}
+		constexpr uint64_t kRootSpan = uint64_t(1) << kRootBits;
+		const uint64_t boundary = (_current | (kRootSpan - 1)) + 1;
+		for (uint64_t tick = _current; tick < boundary; ++tick) {
+			if (_buckets[tick & (kRootSpan - 1)] != kNil) {
+				return tick;
+			}
+		}
+		return boundary;
+	}
+
+	void TimerService::arm(uint64_t tick)
+	{
+		if (!_thread || tick == UINT64_MAX || tick >= _wakeTick) {
+			return;
+		}
+		_wakeTick = tick;
+		const uint64_t sequence = ++_wakeSequence;
+		const int64_t delayMs = std::max<int64_t>(static_cast<int64_t>(tick) * kTickMs - rtc::TimeMillis(), 0);
+		_thread->PostDelayedTask(RTC_FROM_HERE, [wself = weak_from_this(), sequence]() {
+			if (auto self = wself.lock()) {
+				self->onWake(sequence);
+			}
+		}, static_cast<int>(delayMs));
+	}
+
+	void TimerService::onWake(uint64_t sequence)
+	{
+		std::vector<std::pair<rtc::Thread*, TimerId>> due;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			advance(due);
+			if (sequence == _wakeSequence) {
+				_wakeTick = UINT64_MAX;
+			}
+			arm(nextWakeTick());
+		}
+
+		for (const auto& timer : due) {
+			timer.first->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), id = timer.second]() {
+				if (auto self = wself.lock()) {
+					self->run(id);
+				}
+			});
+		}
+	}
+
+	uint64_t TimerService::nowTick() const
+	{
+		return static_cast<uint64_t>(rtc::TimeMillis() / kTickMs);
+	}
+
+	TimerId TimerService::makeId(int32_t index, uint32_t generation)
+	{
+		return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(index);
+	}
+}
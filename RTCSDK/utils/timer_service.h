@@ -0,0 +1,147 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <memory>
+#include <functional>
+#include <vector>
+#include <array>
+#include <utility>
+#include <mutex>
+#include <stdint.h>
+
+namespace rtc {
+	class Thread;
+}
+
+namespace vi {
+	// Slot index in the low 32 bits, slot generation in the high ones; 0 is never handed out
+	using TimerId = uint64_t;
+
+	// Process wide timers driven by a single thread through a hierarchical timing wheel (Varghese & Lauck):
+	// 256 buckets of kTickMs, then three levels of 64 buckets each covering 64 times the previous level,
+	// timers of an upper level are cascaded down as the wheel turns. Scheduling and cancelling link/unlink
+	// one slot of a slab under a short lock; a cancelled or fired slot gets a new generation, so a stale
+	// TimerId can never cancel or run the timer that reuses its slot.
+	// The wheel thread never runs callbacks, they are posted to the executor given at schedule time and
+	// dropped there if the timer got cancelled in between. The thread sleeps until the next due bucket.
+	class TimerService : public std::enable_shared_from_this<TimerService> {
+	public:
+		static constexpr int64_t kTickMs = 10;
+
+		TimerService();
+
+		~TimerService();
+
+		// |thread| drives the wheel
+		void init(rtc::Thread* thread);
+
+		// Drops every timer, callbacks already posted do not run
+		void destroy();
+
+		// Runs |callback| once on |executor| after |delayMs|
+		TimerId schedule(rtc::Thread* executor, std::function<void()> callback, int64_t delayMs);
+
+		// Runs |callback| on |executor| every |periodMs| until cancelled
+		TimerId scheduleRepeating(rtc::Thread* executor, std::function<void()> callback, int64_t periodMs);
+
+		// False if |id| already fired (one shot) or was cancelled
+		bool cancel(TimerId id);
+
+		size_t size() const;
+
+	private:
+		static constexpr int32_t kNil = -1;
+
+		static constexpr size_t kRootBits = 8;
+
+		static constexpr size_t kLevelBits = 6;
+
+		static constexpr size_t kLevels = 4;
+
+		enum class SlotState : uint8_t {
+			FREE,
+			PENDING,
+			// posted to its executor, one shot timers keep the slot until the callback ran
+			FIRING
+		};
+
+		struct Slot {
+			uint32_t generation = 1;
+			SlotState state = SlotState::FREE;
+			uint64_t expires = 0;
+			int64_t periodTicks = 0;
+			int32_t prev = kNil;
+			int32_t next = kNil;
+			int32_t bucket = kNil;
+			rtc::Thread* executor = nullptr;
+			std::shared_ptr<std::function<void()>> callback;
+		};
+
+		TimerId add(rtc::Thread* executor, std::function<void()> callback, int64_t delayMs, bool repeating);
+
+		int32_t allocate();
+
+		// The callback is handed back to be destroyed outside the lock, its captures may reenter the service
+		std::shared_ptr<std::function<void()>> release(int32_t index);
+
+		void link(int32_t index);
+
+		void unlink(int32_t index);
+
+		// Moves the timers of an upper level bucket to the buckets matching what is left of their delay
+		void cascade(int32_t bucket);
+
+		// Turns the wheel up to the current time, collecting the timers to post to their executor
+		void advance(std::vector<std::pair<rtc::Thread*, TimerId>>& due);
+
+		void fire(int32_t index, std::vector<std::pair<rtc::Thread*, TimerId>>& due);
+
+		// Runs on the executor of |id|
+		void run(TimerId id);
+
+		// First tick worth waking up for: a non empty root bucket or the next cascade
+		uint64_t nextWakeTick() const;
+
+		void arm(uint64_t tick);
+
+		void onWake(uint64_t sequence);
+
+		uint64_t nowTick() const;
+
+		static TimerId makeId(int32_t index, uint32_t generation);
+
+		TimerService(const TimerService&) = delete;
+
+		TimerService& operator=(const TimerService&) = delete;
+
+	private:
+		mutable std::mutex _mutex;
+
+		rtc::Thread* _thread = nullptr;
+
+		std::vector<Slot> _slots;
+
+		int32_t _freeHead = kNil;
+
+		// root buckets first, then kLevels - 1 levels of 64 buckets
+		std::array<int32_t, (1 << kRootBits) + (kLevels - 1) * (1 << kLevelBits)> _buckets;
+
+		// next tick to process
+		uint64_t _current = 0;
+
+		size_t _pending = 0;
+
+		// tick of the planned wake up, UINT64_MAX when idle
+		uint64_t _wakeTick = UINT64_MAX;
+
+		// only the latest armed wake up plans the next one
+		uint64_t _wakeSequence = 0;
+	};
+}
+
+#define Timers uFactory->getTimerService()
@@ -0,0 +1,97 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "transaction_id.h"
+#include <atomic>
+#include <random>
+#include <cstring>
+
+namespace {
+	const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+	constexpr uint64_t kBase = 62;
+
+	int32_t digitOf(char c)
+	{
+		if (c >= 'A' && c <= 'Z') return c - 'A';
+		if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+		if (c >= '0' && c <= '9') return c - '0' + 52;
+		return -1;
+	}
+
+	struct Prefix {
+		Prefix() {
+			std::random_device rd;
+			uint64_t seed = (uint64_t(rd()) << 32) | rd();
+			for (size_t i = 0; i < vi::TransactionId::kPrefixLength; ++i) {
+				text[i] = kAlphabet[seed % kBase];
+				seed /= kBase;
+			}
+		}
+
+		char text[vi::TransactionId::kPrefixLength];
+	};
+
+	const Prefix& processPrefix()
+	{
+		static const Prefix prefix;
+		return prefix;
+	}
+
+	std::atomic<uint64_t> g_counter{ 0 };
+}
+
+namespace vi {
+	TransactionId TransactionId::next()
+	{
+		TransactionId id;
+		id.value = ++g_counter;
+
+		const Prefix& prefix = processPrefix();
+		std::memcpy(id.text, prefix.text, kPrefixLength);
+
+		// at most 11 base62 digits for a 64 bit counter
+		char digits[kMaxLength - kPrefixLength];
+		size_t count = 0;
+		uint64_t value = id.value;
+		do {
+			digits[count++] = kAlphabet[value % kBase];
+			value /= kBase;
+		} while (value > 0);
+
+		size_t length = kPrefixLength;
+		while (count > 0) {
+			id.text[length++] = digits[--count];
+		}
+		id.text[length] = '\0';
+		id.length = static_cast<uint8_t>(length);
+
+		return id;
+	}
+
+	uint64_t TransactionId::parse(const std::string& transaction)
+	{
+		if (transaction.size() <= kPrefixLength || transaction.size() > kMaxLength) {
+			return 0;
+		}
+		if (std::memcmp(transaction.data(), processPrefix().text, kPrefixLength) != 0) {
+			return 0;
+		}
+
+		uint64_t value = 0;
+		for (size_t i = kPrefixLength; i < transaction.size(); ++i) {
+			const int32_t digit = digitOf(transaction[i]);
+			if (digit < 0) {
+				return 0;
+			}
+			if (value > (UINT64_MAX - digit) / kBase) {
+				return 0;
+			}
+			value = value * kBase + digit;
+		}
+		return value;
+	}
+}
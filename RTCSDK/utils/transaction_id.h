@@ -0,0 +1,35 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+namespace vi {
+	// Transaction identifier of a Janus request: a random per-process prefix followed by a
+	// base62 counter, e.g. "Q7zk1" / "Q7zkGb". Ids never repeat within a process, and the
+	// text always fits the small string buffer, so producing one does not touch the heap.
+	struct TransactionId {
+		static constexpr size_t kPrefixLength = 4;
+
+		static constexpr size_t kMaxLength = 15;
+
+		uint64_t value = 0;
+
+		uint8_t length = 0;
+
+		char text[kMaxLength + 1] = { 0 };
+
+		std::string str() const { return std::string(text, length); }
+
+		static TransactionId next();
+
+		// The counter carried by |transaction|, 0 if it was not produced by this process
+		static uint64_t parse(const std::string& transaction);
+	};
+}
@@ -1,154 +1,166 @@
-
 #pragma once
 
 #include <type_traits>
-#include <list>
+#include <vector>
+#include <memory>
+#include <mutex>
 #include <algorithm>
-#include "absl/types/any.h"
 #include "absl/types/optional.h"
 #include "utils/thread_provider.h"
-#include "rtc_base/deprecated/recursive_critical_section.h"
+#include "logger/logger.h"
 
 namespace vi {
+    // Observers are kept in an immutable snapshot that is replaced as a whole on add/remove,
+    // so notifying only copies the pointer to the current snapshot under a short lock: the list is
+    // not copied and no lock is held while the observers run.
+    // The callback thread of an observer is resolved once, when it registers; an observer whose
+    // thread can not be resolved is not registered.
     template<typename Observer>
     class UniversalObservable {
     public:
         using observer_ptr = std::shared_ptr<Observer>;
+
         void addWeakObserver(const observer_ptr &observer, absl::optional<std::string> threadName) {
-            rtc::CritScope scope(&_criticalSection);
-            if (!hasObserverInternal(observer)) {
-                WeakObject wobj(observer, threadName);
-                _observers.emplace_back(wobj);
+            if (rtc::Thread* thread = resolveThread(threadName)) {
+                addEntry(Entry(std::weak_ptr<Observer>(observer), nullptr, thread));
             }
         }
-        
+
         void addObserver(const observer_ptr &observer, absl::optional<std::string> threadName) {
-            rtc::CritScope scope(&_criticalSection);
-            if (!hasObserverInternal(observer)) {
-                Object obj(observer, threadName);
-                _observers.emplace_back(obj);
+            if (rtc::Thread* thread = resolveThread(threadName)) {
+                addEntry(Entry(std::weak_ptr<Observer>(observer), observer, thread));
             }
         }
-        
+
         void removeObserver(const observer_ptr &observer) {
-            rtc::CritScope scope(&_criticalSection);
-            for (auto it = _observers.begin(); it != _observers.end(); ++it) {
-                auto var = absl::any(*it);
-                if (var.has_value()) {
-                    if (absl::any_cast<WeakObject>(&var)) {
-                        WeakObject wobj = absl::any_cast<WeakObject>(var);
-                        if (wobj.observer.lock() == observer) {
-                            _observers.erase(it);
-                            return;
-                        }
-                    } else if (absl::any_cast<Object>(&var)) {
-                        Object obj = absl::any_cast<Object>(var);
-                        if (obj.observer == observer) {
-                            _observers.erase(it);
-                            return;
-                        }
-                    }
+            std::lock_guard<std::mutex> lock(_writeMutex);
+            auto current = snapshot();
+            auto next = std::make_shared<Snapshot>();
+            next->reserve(current->size());
+            for (const auto& entry : *current) {
+                if (entry.key != observer.get() && !entry.expired()) {
+                    next->emplace_back(entry);
                 }
             }
+            publish(std::move(next));
         }
-        
+
         void clearObserver() {
-            rtc::CritScope scope(&_criticalSection);
-            _observers.clear();
+            std::lock_guard<std::mutex> lock(_writeMutex);
+            publish(std::make_shared<Snapshot>());
         }
-        
+
         size_t numOfObservers() {
-            rtc::CritScope scope(&_criticalSection);
-            return _observers.size();
+            return snapshot()->size();
         }
-        
+
         bool hasObserver(const observer_ptr &observer) {
-            rtc::CritScope scope(&_criticalSection);
-            return hasObserverInternal(observer);
+            return hasObserverInternal(*snapshot(), observer);
         }
-        
+
     protected:
-        bool hasObserverInternal(const observer_ptr &observer) {
-            for (auto it = _observers.begin(); it != _observers.end(); ++it) {
-				auto var = absl::any(*it);
-                if (var.has_value()) {
-                    if (absl::any_cast<WeakObject>(&var)) {
-                        WeakObject wobj = absl::any_cast<WeakObject>(var);
-                        if (wobj.observer.lock() == observer) {
-                            return true;
-                        }
-                    } else if (absl::any_cast<Object>(&var)) {
-                        Object obj = absl::any_cast<Object>(var);
-                        if (obj.observer == observer) {
-                            return true;
+        template<typename Notifier>
+        void notifyObservers(const Notifier& notifier) const {
+            const std::shared_ptr<const Snapshot> observers = snapshot();
+            for (const auto& entry : *observers) {
+                observer_ptr obs = entry.strong ? entry.strong : entry.weak.lock();
+                if (!obs) {
+                    continue;
+                }
+                if (entry.thread->IsCurrent()) {
+                    notifier(obs);
+                }
+                else {
+                    entry.thread->PostTask(RTC_FROM_HERE, [wobs = entry.weak, notifier]() {
+                        if (auto observer = wobs.lock()) {
+                            notifier(observer);
                         }
-                    }
+                    });
                 }
             }
-            
-            return false;
         }
-        
-    protected:
-        virtual void notifyObservers(std::function<void(const observer_ptr &)> notifier) const {
-            decltype(_observers) observers;
-            {
-                rtc::CritScope scope(&_criticalSection);
-                observers = _observers;
+
+    private:
+        struct Entry {
+            Entry(std::weak_ptr<Observer> w, observer_ptr s, rtc::Thread* t)
+            : weak(std::move(w))
+            , strong(std::move(s))
+            , thread(t) {
+                key = strong ? strong.get() : weak.lock().get();
+            }
+
+            bool expired() const {
+                return !strong && weak.expired();
+            }
+
+            std::weak_ptr<Observer> weak;
+
+            // only set for observers registered by addObserver, keeps them alive
+            observer_ptr strong;
+
+            rtc::Thread* thread = nullptr;
+
+            // identity of the observer, never dereferenced
+            const Observer* key = nullptr;
+        };
+
+        using Snapshot = std::vector<Entry>;
+
+        static rtc::Thread* resolveThread(const absl::optional<std::string>& threadName) {
+            rtc::Thread* thread = TMgr->thread(threadName.value_or(""));
+            if (!thread) {
+                ELOG("observer not registered, no thread named '{}'", threadName.value_or(""));
             }
-            
-            for (const auto &observer: observers) {
-                auto var = absl::any(observer);
-                if (var.has_value()) {
-                    std::shared_ptr<Observer> obs;
-                    absl::optional<std::string> threadName;
-                    
-                    if (absl::any_cast<WeakObject>(&var)) {
-                        WeakObject wobj = absl::any_cast<WeakObject>(var);
-                        obs = wobj.observer.lock();
-                        threadName = wobj.threadName;
-                    } else if (absl::any_cast<Object>(&var)) {
-                        Object obj = absl::any_cast<Object>(var);
-                        obs = obj.observer;
-                        threadName = obj.threadName;
-                    }
-                    
-                    if (obs) {
-						rtc::Thread* thread = TMgr->thread(threadName.value_or(""));
-						assert(thread);
-						if (thread->IsCurrent()) {
-                            notifier(obs);
-						}
-						else {
-                            //notifier(obs);
-							thread->PostTask(RTC_FROM_HERE, [wobs = std::weak_ptr<Observer>(obs), notifier]() {
-								if (auto observer = wobs.lock()) {
-                                    notifier(observer);
-								}
-							});
-						}
-                    }
+            return thread;
+        }
+
+        static bool hasObserverInternal(const Snapshot& observers, const observer_ptr &observer) {
+            return std::any_of(observers.begin(), observers.end(), [key = observer.get()](const Entry& entry) {
+                return entry.key == key && !entry.expired();
+            });
+        }
+
+        void addEntry(Entry&& entry) {
+            if (!entry.key) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(_writeMutex);
+            auto current = snapshot();
+            auto next = std::make_shared<Snapshot>();
+            next->reserve(current->size() + 1);
+            for (const auto& e : *current) {
+                if (e.key == entry.key && !e.expired()) {
+                    return;
+                }
+                if (!e.expired()) {
+                    next->emplace_back(e);
                 }
             }
+            next->emplace_back(std::move(entry));
+            publish(std::move(next));
         }
-        
-    private:
-        template<typename T = std::shared_ptr<Observer>>
-        class InnerObject {
-        public:
-            InnerObject(std::shared_ptr<Observer> o, absl::optional<std::string> name)
-            : observer(o)
-            , threadName(name) {
+
+        std::shared_ptr<const Snapshot> snapshot() const {
+            std::lock_guard<std::mutex> lock(_snapshotMutex);
+            return _snapshot;
+        }
+
+        void publish(std::shared_ptr<const Snapshot> next) {
+            {
+                std::lock_guard<std::mutex> lock(_snapshotMutex);
+                _snapshot.swap(next);
             }
-            
-            T observer;
-            absl::optional<std::string> threadName;
-        };
-        
-        using WeakObject = InnerObject<std::weak_ptr<Observer>>;
-        using Object = InnerObject<std::shared_ptr<Observer>>;
-        
-        rtc::RecursiveCriticalSection _criticalSection;
-        std::list<absl::any> _observers;
+            // the previous snapshot is released here, outside of the lock
+        }
+
+    private:
+        // serializes writers, a whole add/remove
+        std::mutex _writeMutex;
+
+        // only held to copy or swap |_snapshot|, a lock of this object rather than the process wide
+        // lock pool std::atomic_load() of a shared_ptr goes through
+        mutable std::mutex _snapshotMutex;
+
+        std::shared_ptr<const Snapshot> _snapshot = std::make_shared<const Snapshot>();
     };
 }
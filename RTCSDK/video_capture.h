@@ -92,10 +92,12 @@ namespace vi {
 	public:
 		~CapturerTrackSource() {}
 
+		// capture format, also what the simulcast presets are derived from
+		static constexpr size_t kWidth = 640;
+		static constexpr size_t kHeight = 480;
+		static constexpr size_t kFps = 30;
+
 		static rtc::scoped_refptr<CapturerTrackSource> Create() {
-			const size_t kWidth = 640;
-			const size_t kHeight = 480;
-			const size_t kFps = 30;
 			std::unique_ptr<VcmCapturer> capturer;
 			std::unique_ptr<webrtc::VideoCaptureModule::DeviceInfo> info(
 				webrtc::VideoCaptureFactory::CreateDeviceInfo());
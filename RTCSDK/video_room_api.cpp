@@ -9,6 +9,7 @@
 #include "logger/logger.h"
 #include "video_room_models.h"
 #include "plugin_client.h"
+#include "janus_message.h"
 
 namespace vi {
 
@@ -23,7 +24,7 @@ namespace vi {
 
 	}
 
-	void VideoRoomApi::curd(const std::string& request, std::function<void(std::shared_ptr<vr::RoomCurdResponse>)> callback)
+	void VideoRoomApi::curd(const JsonBody& request, std::function<void(std::shared_ptr<vr::RoomCurdResponse>)> callback)
 	{
 		auto pluginClient = _pluginClient.lock();
 		if (!pluginClient) {
@@ -31,15 +32,10 @@ namespace vi {
 			return;
 		}
 		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
-		auto lambda = [callback](bool success, const std::string& response) {
-			DLOG("response: {}", response.c_str());
-			if (response.empty()) {
-				return;
-			}
-
+		auto lambda = [callback](bool success, std::shared_ptr<JanusMessage> reply) {
 			std::string err;
 
-			std::shared_ptr<vr::RoomCurdResponse> jr = fromJsonString<vr::RoomCurdResponse>(response, err);
+			std::shared_ptr<vr::RoomCurdResponse> jr = reply->to<vr::RoomCurdResponse>(err);
 
 			if (!err.empty()) {
 				DLOG("parse JanusResponse failed");
@@ -50,53 +46,33 @@ namespace vi {
 				callback(jr);
 			}
 		};
-		std::shared_ptr<vi::EventCallback> cb = std::make_shared<vi::EventCallback>(lambda);
-		event->message = request;
-		event->callback = cb;
+		std::shared_ptr<vi::ReplyCallback> cb = std::make_shared<vi::ReplyCallback>(lambda);
+		event->body = request;
+		event->reply = cb;
 		pluginClient->sendMessage(event);
 	}
 
 	void VideoRoomApi::create(std::shared_ptr<vr::CreateRoomRequest> request, std::function<void(std::shared_ptr<vr::RoomCurdResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		curd(json, callback);
+		curd(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::destroy(std::shared_ptr<vr::DestroyRoomRequest> request, std::function<void(std::shared_ptr<vr::RoomCurdResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		curd(json, callback);
+		curd(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::edit(std::shared_ptr<vr::EditRoomRequest> request, std::function<void(std::shared_ptr<vr::RoomCurdResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		curd(json, callback);
+		curd(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::exists(std::shared_ptr<vr::ExistsRequest> request, std::function<void(std::shared_ptr<vr::RoomCurdResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		curd(json, callback);
+		curd(JsonBody::of(request), callback);
 	}
 
-	void VideoRoomApi::action(const std::string& request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
+	void VideoRoomApi::action(const JsonBody& request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
 		auto pluginClient = _pluginClient.lock();
 		if (!pluginClient) {
@@ -104,15 +80,10 @@ namespace vi {
 			return;
 		}
 		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
-		auto lambda = [callback](bool success, const std::string& response) {
-			DLOG("response: {}", response.c_str());
-			if (response.empty()) {
-				return;
-			}
-
+		auto lambda = [callback](bool success, std::shared_ptr<JanusMessage> reply) {
 			std::string err;
 
-			std::shared_ptr<JanusResponse> jr = fromJsonString<JanusResponse>(response, err);
+			std::shared_ptr<JanusResponse> jr = reply->to<JanusResponse>(err);
 
 			if (!err.empty()) {
 				DLOG("parse JanusResponse failed");
@@ -123,130 +94,70 @@ namespace vi {
 				callback(jr);
 			}
 		};
-		std::shared_ptr<vi::EventCallback> cb = std::make_shared<vi::EventCallback>(lambda);
-		event->message = request;
-		event->callback = cb;
+		std::shared_ptr<vi::ReplyCallback> cb = std::make_shared<vi::ReplyCallback>(lambda);
+		event->body = request;
+		event->reply = cb;
 		pluginClient->sendMessage(event);
 	}
 
 	void VideoRoomApi::join(std::shared_ptr<vr::PublisherJoinRequest> request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		action(json, callback);
+		action(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::join(std::shared_ptr<vr::SubscriberJoinRequest> request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		action(json, callback);
+		action(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::publisherConfigure(std::shared_ptr<vr::PublisherConfigureRequest> request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		action(json, callback);
+		action(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::subscriberConfigure(std::shared_ptr<vr::SubscriberConfigureRequest> request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		action(json, callback);
+		action(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::publish(std::shared_ptr<vr::PublishRequest> request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		action(json, callback);
+		action(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::unpublish(std::shared_ptr<vr::UnpublishRequest> request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		action(json, callback);
+		action(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::subscribe(std::shared_ptr<vr::SubscribeRequest> request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		action(json, callback);
+		action(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::unsubscribe(std::shared_ptr<vr::UnsubscribeRequest> request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		action(json, callback);
+		action(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::startPeerConnection(std::shared_ptr<vr::StartPeerConnectionRequest> request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		action(json, callback);
+		action(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::pausePeerConnection(std::shared_ptr<vr::PausePeerConnectionRequest> request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		action(json, callback);
+		action(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::switchPublisher(std::shared_ptr<vr::SwitchPublisherRequest> request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		action(json, callback);
+		action(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::leave(std::shared_ptr<vr::LeaveRequest> request, std::function<void(std::shared_ptr<JanusResponse>)> callback)
 	{
-		std::string json = request->toJsonStr();
-		if (json.empty()) {
-			DLOG("empty json string");
-			return;
-		}
-		action(json, callback);
+		action(JsonBody::of(request), callback);
 	}
 
 	void VideoRoomApi::allowed(std::shared_ptr<vr::AllowedRequest> request, std::function<void(std::shared_ptr<vr::AllowedResponse>)> callback)
@@ -257,15 +168,10 @@ namespace vi {
 			return;
 		}
 		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
-		auto lambda = [callback](bool success, const std::string& response) {
-			DLOG("response: {}", response.c_str());
-			if (response.empty()) {
-				return;
-			}
-
+		auto lambda = [callback](bool success, std::shared_ptr<JanusMessage> reply) {
 			std::string err;
 
-			std::shared_ptr<vr::AllowedResponse> jr = fromJsonString<vr::AllowedResponse>(response, err);
+			std::shared_ptr<vr::AllowedResponse> jr = reply->to<vr::AllowedResponse>(err);
 
 			if (!err.empty()) {
 				DLOG("parse AllowedResponse failed");
@@ -276,9 +182,9 @@ namespace vi {
 				callback(jr);
 			}
 		};
-		std::shared_ptr<vi::EventCallback> cb = std::make_shared<vi::EventCallback>(lambda);
-		event->message = request->toJsonStr();
-		event->callback = cb;
+		std::shared_ptr<vi::ReplyCallback> cb = std::make_shared<vi::ReplyCallback>(lambda);
+		event->body = JsonBody::of(request);
+		event->reply = cb;
 		pluginClient->sendMessage(event);
 	}
 
@@ -290,15 +196,10 @@ namespace vi {
 			return;
 		}
 		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
-		auto lambda = [callback](bool success, const std::string& response) {
-			DLOG("response: {}", response.c_str());
-			if (response.empty()) {
-				return;
-			}
-
+		auto lambda = [callback](bool success, std::shared_ptr<JanusMessage> reply) {
 			std::string err;
 
-			std::shared_ptr<vr::KickResponse> jr = fromJsonString<vr::KickResponse>(response, err);
+			std::shared_ptr<vr::KickResponse> jr = reply->to<vr::KickResponse>(err);
 
 			if (!err.empty()) {
 				DLOG("parse KickResponse failed");
@@ -309,9 +210,9 @@ namespace vi {
 				callback(jr);
 			}
 		};
-		std::shared_ptr<vi::EventCallback> cb = std::make_shared<vi::EventCallback>(lambda);
-		event->message = request->toJsonStr();
-		event->callback = cb;
+		std::shared_ptr<vi::ReplyCallback> cb = std::make_shared<vi::ReplyCallback>(lambda);
+		event->body = JsonBody::of(request);
+		event->reply = cb;
 		pluginClient->sendMessage(event);
 	}
 
@@ -323,15 +224,10 @@ namespace vi {
 			return;
 		}
 		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
-		auto lambda = [callback](bool success, const std::string& response) {
-			DLOG("response: {}", response.c_str());
-			if (response.empty()) {
-				return;
-			}
-
+		auto lambda = [callback](bool success, std::shared_ptr<JanusMessage> reply) {
 			std::string err;
 
-			std::shared_ptr<vr::ModerateResponse> jr = fromJsonString<vr::ModerateResponse>(response, err);
+			std::shared_ptr<vr::ModerateResponse> jr = reply->to<vr::ModerateResponse>(err);
 
 			if (!err.empty()) {
 				DLOG("parse ModerateResponse failed");
@@ -342,9 +238,9 @@ namespace vi {
 				callback(jr);
 			}
 		};
-		std::shared_ptr<vi::EventCallback> cb = std::make_shared<vi::EventCallback>(lambda);
-		event->message = request->toJsonStr();
-		event->callback = cb;
+		std::shared_ptr<vi::ReplyCallback> cb = std::make_shared<vi::ReplyCallback>(lambda);
+		event->body = JsonBody::of(request);
+		event->reply = cb;
 		pluginClient->sendMessage(event);
 	}
 
@@ -357,15 +253,10 @@ namespace vi {
 			return;
 		}
 		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
-		auto lambda = [callback](bool success, const std::string& response) {
-			DLOG("response: {}", response.c_str());
-			if (response.empty()) {
-				return;
-			}
-
+		auto lambda = [callback](bool success, std::shared_ptr<JanusMessage> reply) {
 			std::string err;
 
-			std::shared_ptr<vr::FetchRoomsListResponse> jr = fromJsonString<vr::FetchRoomsListResponse>(response, err);
+			std::shared_ptr<vr::FetchRoomsListResponse> jr = reply->to<vr::FetchRoomsListResponse>(err);
 
 			if (!err.empty()) {
 				DLOG("parse FetchRoomsListResponse failed");
@@ -376,9 +267,9 @@ namespace vi {
 				callback(jr);
 			}
 		};
-		std::shared_ptr<vi::EventCallback> cb = std::make_shared<vi::EventCallback>(lambda);
-		event->message = request->toJsonStr();
-		event->callback = cb;
+		std::shared_ptr<vi::ReplyCallback> cb = std::make_shared<vi::ReplyCallback>(lambda);
+		event->body = JsonBody::of(request);
+		event->reply = cb;
 		pluginClient->sendMessage(event);
 	}
 
@@ -390,15 +281,10 @@ namespace vi {
 			return;
 		}
 		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
-		auto lambda = [callback](bool success, const std::string& response) {
-			DLOG("response: {}", response.c_str());
-			if (response.empty()) {
-				return;
-			}
-
+		auto lambda = [callback](bool success, std::shared_ptr<JanusMessage> reply) {
 			std::string err;
 
-			std::shared_ptr<vr::FetchParticipantsResponse> jr = fromJsonString<vr::FetchParticipantsResponse>(response, err);
+			std::shared_ptr<vr::FetchParticipantsResponse> jr = reply->to<vr::FetchParticipantsResponse>(err);
 
 			if (!err.empty()) {
 				DLOG("parse FetchParticipantsResponse failed");
@@ -409,9 +295,47 @@ namespace vi {
 				callback(jr);
 			}
 		};
-		std::shared_ptr<vi::EventCallback> cb = std::make_shared<vi::EventCallback>(lambda);
-		event->message = request->toJsonStr();
-		event->callback = cb;
+		std::shared_ptr<vi::ReplyCallback> cb = std::make_shared<vi::ReplyCallback>(lambda);
+		event->body = JsonBody::of(request);
+		event->reply = cb;
+		pluginClient->sendMessage(event);
+	}
+
+	void VideoRoomApi::fetchRoomsListView(std::shared_ptr<vr::FetchRoomsListRequest> request, std::function<void(const vr::FetchRoomsListResponseView&)> callback)
+	{
+		fetchView<vr::FetchRoomsListResponseView>(JsonBody::of(request), callback);
+	}
+
+	void VideoRoomApi::fetchParticipantsView(std::shared_ptr<vr::FetchParticipantsRequest> request, std::function<void(const vr::FetchParticipantsResponseView&)> callback)
+	{
+		fetchView<vr::FetchParticipantsResponseView>(JsonBody::of(request), callback);
+	}
+
+	template<typename View>
+	void VideoRoomApi::fetchView(const JsonBody& request, std::function<void(const View&)> callback)
+	{
+		auto pluginClient = _pluginClient.lock();
+		if (!pluginClient) {
+			DLOG("invalid plugin client");
+			return;
+		}
+		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
+		auto lambda = [callback](bool success, std::shared_ptr<JanusMessage> reply) {
+			// the views point into the DOM of the reply, parsed once off the frame
+			View view;
+			std::string err;
+			if (!reply->decode(view, err)) {
+				DLOG("parse response failed: {}", err);
+				return;
+			}
+
+			if (callback) {
+				callback(view);
+			}
+		};
+		std::shared_ptr<vi::ReplyCallback> cb = std::make_shared<vi::ReplyCallback>(lambda);
+		event->body = request;
+		event->reply = cb;
 		pluginClient->sendMessage(event);
 	}
-}
\ No newline at end of file
+}
@@ -62,10 +62,17 @@ namespace vi {
 
 		void fetchParticipants(std::shared_ptr<vr::FetchParticipantsRequest> request, std::function<void(std::shared_ptr<vr::FetchParticipantsResponse>)> callback) override;
 
+		void fetchRoomsListView(std::shared_ptr<vr::FetchRoomsListRequest> request, std::function<void(const vr::FetchRoomsListResponseView&)> callback) override;
+
+		void fetchParticipantsView(std::shared_ptr<vr::FetchParticipantsRequest> request, std::function<void(const vr::FetchParticipantsResponseView&)> callback) override;
+
 	private:
-		void curd(const std::string& request, std::function<void(std::shared_ptr<vr::RoomCurdResponse>)> callback);
+		void curd(const JsonBody& request, std::function<void(std::shared_ptr<vr::RoomCurdResponse>)> callback);
+
+		void action(const JsonBody& request, std::function<void(std::shared_ptr<JanusResponse>)> callback);
 
-		void action(const std::string& request, std::function<void(std::shared_ptr<JanusResponse>)> callback);
+		template<typename View>
+		void fetchView(const JsonBody& request, std::function<void(const View&)> callback);
 
 	private:
 		std::weak_ptr<PluginClient> _pluginClient;
@@ -16,6 +16,7 @@
 #include "pc/media_stream_track_proxy.h"
 #include "media_controller.h"
 #include "participants_controller.h"
+#include "janus_message.h"
 
 namespace vi {
 	VideoRoomClient::VideoRoomClient(std::shared_ptr<SignalingClientInterface> sc, rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> pcf)
@@ -194,12 +195,12 @@ namespace vi {
 
 	void VideoRoomClient::onSlowLink(bool uplink, bool lost, const std::string& mid) {}
 
-	void VideoRoomClient::onMessage(const std::string& data, const std::string& jsepString)
+	void VideoRoomClient::onMessage(std::shared_ptr<JanusMessage> message, std::shared_ptr<Jsep> jsep)
 	{
 		DLOG(" ::: Got a message (publisher).");
 
 		std::string err;
-		std::shared_ptr<vr::VideoRoomEvent> vrEvent = fromJsonString<vr::VideoRoomEvent>(data, err);
+		std::shared_ptr<vr::VideoRoomEvent> vrEvent = message->to<vr::VideoRoomEvent>(err);
 		if (!err.empty()) {
 			DLOG("parse JanusResponse failed");
 			return;
@@ -223,7 +224,7 @@ namespace vi {
 
 		if (event.value_or("") == "joined") {
 			std::string err;
-			std::shared_ptr<vr::PublisherJoinEvent> pjEvent = fromJsonString<vr::PublisherJoinEvent>(data, err);
+			std::shared_ptr<vr::PublisherJoinEvent> pjEvent = message->to<vr::PublisherJoinEvent>(err);
 			if (!err.empty()) {
 				DLOG("parse JanusResponse failed");
 				return;
@@ -269,18 +270,17 @@ namespace vi {
 			}
 
 			if (pluginData->data->leaving) {
-				const auto& leaving = pluginData->data->leaving.value();
+				const auto& leaving = pluginData->data->leaving->id;
 
 				// Figure out the participant and detach it
 				removeParticipant(leaving);
 
-				//_subscriber->unsubscribeFrom(leaving);
+				_subscriber->unsubscribeFrom(leaving);
 			}
 			else if (pluginData->data->unpublished) {
-				const auto& unpublished = pluginData->data->unpublished.value();
+				const auto& unpublished = pluginData->data->unpublished->id;
 				DLOG("Publisher left: {}", unpublished);
 
-				// TODO: |unpublished| can be int or string
 				if (unpublished == 0) {
 					// That's us
 					this->hangup(true);
@@ -290,7 +290,7 @@ namespace vi {
 				// Figure out the participant and detach it
 				removeParticipant(unpublished);
 
-				//_subscriber->unsubscribeFrom(unpublished);
+				_subscriber->unsubscribeFrom(unpublished);
 			}
 			else if (pluginData->data->error) {
 				if (pluginData->data->error_code.value_or(0) == 426) {
@@ -299,13 +299,7 @@ namespace vi {
 			}
 		}
 
-		if (jsepString.empty()) {
-			return;
-		}
-		err.clear();
-		std::shared_ptr<Jsep> jsep = fromJsonString<Jsep>(jsepString, err);
-		if (!err.empty()) {
-			DLOG("parse JanusResponse failed");
+		if (!jsep) {
 			return;
 		}
 
@@ -363,6 +357,13 @@ namespace vi {
 
 	void VideoRoomClient::onDetached() {}
 
+	void VideoRoomClient::restartIce()
+	{
+		// a new offer, createOffer asks for fresh ICE credentials
+		const auto& stream = _pluginContext->localStream;
+		publishStream(stream && !stream->GetAudioTracks().empty());
+	}
+
 	void VideoRoomClient::publishStream(bool audioOn)
 	{
 		auto event = std::make_shared<PrepareWebrtcEvent>();
@@ -374,16 +375,16 @@ namespace vi {
 			if (success) {
 				vr::PublisherConfigureRequest request;
 				auto event = std::make_shared<vi::MessageEvent>();
-				auto lambda = [](bool success, const std::string& response) {
-					DLOG("publishStream: {}", response.c_str());
+				auto lambda = [](bool success, std::shared_ptr<JanusMessage> reply) {
+					DLOG("publishStream: {}", reply->envelope().janus.value_or(""));
 				};
-				auto callback = std::make_shared<vi::EventCallback>(lambda);
-				event->message = request.toJsonStr();
+				auto callback = std::make_shared<vi::ReplyCallback>(lambda);
+				event->body = JsonBody::of(std::move(request));
 				Jsep jp; 
 				jp.type = jsep.type;
 				jp.sdp = jsep.sdp;
-				event->jsep = jp.toJsonStr();
-				event->callback = callback;
+				event->jsep = JsonBody::of(std::move(jp));
+				event->reply = callback;
 				self->sendMessage(event);
 			}
 			else {
@@ -406,12 +407,12 @@ namespace vi {
 		vr::UnpublishRequest request;
 		if (auto sc = _pluginContext->signalingClient.lock()) {
 			auto event = std::make_shared<vi::MessageEvent>();
-			auto lambda = [](bool success, const std::string& response) {
-				DLOG("response: {}", response.c_str());
+			auto lambda = [](bool success, std::shared_ptr<JanusMessage> reply) {
+				DLOG("unpublishStream: {}", reply->envelope().janus.value_or(""));
 			};
-			auto callback = std::make_shared<vi::EventCallback>(lambda);
-			event->message = request.toJsonStr();
-			event->callback = callback;
+			auto callback = std::make_shared<vi::ReplyCallback>(lambda);
+			event->body = JsonBody::of(std::move(request));
+			event->reply = callback;
 			sendMessage(event);
 		}
 	}
@@ -429,9 +430,4 @@ namespace vi {
 			_participantsController->removeParticipant(id);
 		}
 	}
-
-	void VideoRoomClient::onStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report)
-	{
-		DLOG("RTC Stats Report: {}", report->ToJson());
-	}
 }
@@ -58,6 +58,8 @@ namespace vi {
 
 		std::shared_ptr<IVideoRoomApi> videoRoomApi() { return _videoRoomApi; }
 
+		std::shared_ptr<VideoRoomSubscriber> subscriber() { return _subscriber; }
+
 	protected:
 
 		// signaling events
@@ -70,7 +72,7 @@ namespace vi {
 
 		void onSlowLink(bool uplink, bool lost, const std::string& mid) override;
 
-		void onMessage(const std::string& data, const std::string& jsep) override;
+		void onMessage(std::shared_ptr<JanusMessage> message, std::shared_ptr<Jsep> jsep) override;
 
 		void onTimeout()override;
 
@@ -88,7 +90,7 @@ namespace vi {
 
 		void onLocalTrack(rtc::scoped_refptr<webrtc::MediaStreamTrackInterface> track, bool on) override;
 
-		void onStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report) override;
+		void restartIce() override;
 
 	protected:
 		void publishStream(bool audioOn);
@@ -9,6 +9,7 @@
 #include "message_models.h"
 #include "json/jsonable.hpp"
 #include "absl/types/optional.h"
+#include "absl/strings/string_view.h"
 
 namespace vi {
 	namespace vr {
@@ -64,8 +65,8 @@ namespace vi {
 			absl::optional<JoiningData> joining;
 			absl::optional<std::string> configured;
 			absl::optional<std::vector<Publisher>> publishers;
-			absl::optional<int64_t> unpublished;
-			absl::optional<int64_t> leaving;
+			absl::optional<TolerantId> unpublished;
+			absl::optional<TolerantId> leaving;
 			absl::optional<std::string> started;
 			absl::optional<std::string> paused;
 			absl::optional<std::string> switched;
@@ -472,6 +473,25 @@ namespace vi {
 			FIELDS_MAP("request", request, "streams", streams);
 		};
 
+		/*
+		 * Subscribing to and unsubscribing from streams in one go, Janus renegotiates
+		 * once for the whole change:
+		*/
+		//\verbatim
+		/*{
+		 *	"request" : "update",
+		 *	"subscribe" : [ <list of streams to subscribe to, as in the "subscribe" request; optional> ],
+		 *	"unsubscribe" : [ <list of streams to unsubscribe from, as in the "unsubscribe" request; optional> ]
+		 }*/
+		//\endverbatim
+		struct UpdateSubscriptionRequest {
+			absl::optional<std::string> request = "update";
+			absl::optional<std::vector<SubscribeRequest::Stream>> subscribe;
+			absl::optional<std::vector<UnsubscribeRequest::Stream>> unsubscribe;
+
+			FIELDS_MAP("request", request, "subscribe", subscribe, "unsubscribe", unsubscribe);
+		};
+
 		struct StartPeerConnectionRequest {
 			absl::optional<std::string> request = "start";
 			absl::optional<int64_t> room;
@@ -921,17 +941,18 @@ namespace vi {
 			FIELDS_MAP("request", request);
 		};
 
-		struct VideoRoomInfo {
+		template<typename String>
+		struct VideoRoomInfoT {
 			absl::optional<int64_t> room;
-			absl::optional<std::string> description;
+			absl::optional<String> description;
 			absl::optional<int64_t> max_publishers;
 			absl::optional<int64_t> bitrate;
 			absl::optional<bool> bitrate_cap;
 			absl::optional<int64_t> fir_freq;
-			absl::optional<std::string> audiocodec;
-			absl::optional<std::string> videocodec;
+			absl::optional<String> audiocodec;
+			absl::optional<String> videocodec;
 			absl::optional<bool> record;
-			absl::optional<std::string> record_dir;
+			absl::optional<String> record_dir;
 			absl::optional<bool> lock_record;
 			absl::optional<int64_t> num_participants;
 
@@ -949,32 +970,43 @@ namespace vi {
 				"num_participants", num_participants);
 		};
 
-		struct FetchRoomsListData {
-			absl::optional<std::string> videoroom;
-			absl::optional<std::vector<VideoRoomInfo>> list;
+		template<typename String>
+		struct FetchRoomsListDataT {
+			absl::optional<String> videoroom;
+			absl::optional<std::vector<VideoRoomInfoT<String>>> list;
 			absl::optional<int64_t> error_code;
-			absl::optional<std::string> error;
+			absl::optional<String> error;
 
 			FIELDS_MAP("videoroom", videoroom, "list", list, "error_code", error_code, "error", error);
 		};
 
-		struct FetchRoomsListPluginData {
-			absl::optional<std::string> plugin;
-			absl::optional<FetchRoomsListData> data;
+		template<typename String>
+		struct FetchRoomsListPluginDataT {
+			absl::optional<String> plugin;
+			absl::optional<FetchRoomsListDataT<String>> data;
 
 			FIELDS_MAP("plugin", plugin, "data", data);
 		};
 
-		struct FetchRoomsListResponse {
-			absl::optional<std::string> janus;
-			absl::optional<std::string> transaction;
+		template<typename String>
+		struct FetchRoomsListResponseT {
+			absl::optional<String> janus;
+			absl::optional<String> transaction;
 			absl::optional<int64_t> session_id;
 			absl::optional<int64_t> sender;
-			absl::optional<FetchRoomsListPluginData> plugindata;
+			absl::optional<FetchRoomsListPluginDataT<String>> plugindata;
 
 			FIELDS_MAP("janus", janus, "transaction", transaction, "session_id", session_id, "sender", sender, "plugindata", plugindata);
 		};
 
+		// FetchRoomsListResponseView is the view variant, its strings reference the JanusMessage it was decoded
+		// from and must not outlive the callback it is handed to
+		using VideoRoomInfo = VideoRoomInfoT<std::string>;
+		using FetchRoomsListData = FetchRoomsListDataT<std::string>;
+		using FetchRoomsListPluginData = FetchRoomsListPluginDataT<std::string>;
+		using FetchRoomsListResponse = FetchRoomsListResponseT<std::string>;
+		using FetchRoomsListResponseView = FetchRoomsListResponseT<absl::string_view>;
+
 		/*
 		* To get a list of the participants in a specific room, instead, you
 		* can make use of the \c listparticipants request, which has to be
@@ -993,42 +1025,54 @@ namespace vi {
 			FIELDS_MAP("request", request, "room", room);
 		};
 
-		struct ParticipantInfo {
+		template<typename String>
+		struct ParticipantInfoT {
 			absl::optional<int64_t> id;
-			absl::optional<std::string> display;
+			absl::optional<String> display;
 			absl::optional<bool> publisher;
 			absl::optional<bool> talking;
 
 			FIELDS_MAP("id", id, "display", display, "publisher", publisher, "talking", talking);
 		};
 
-		struct ParticipantData {
-			absl::optional<std::string> videoroom;
+		template<typename String>
+		struct ParticipantDataT {
+			absl::optional<String> videoroom;
 			absl::optional<int64_t> room;
-			absl::optional<std::vector<ParticipantInfo>> participants;
+			absl::optional<std::vector<ParticipantInfoT<String>>> participants;
 			absl::optional<int64_t> error_code;
-			absl::optional<std::string> error;
+			absl::optional<String> error;
 		
 			FIELDS_MAP("videoroom", videoroom, "room", room, "participants", participants, "error_code", error_code, "error", error);
 		};
 
-		struct ParticipantPluginData {
-			absl::optional<std::string> plugin;
-			absl::optional<ParticipantData> data;
+		template<typename String>
+		struct ParticipantPluginDataT {
+			absl::optional<String> plugin;
+			absl::optional<ParticipantDataT<String>> data;
 
 			FIELDS_MAP("plugin", plugin, "data", data);
 		};
 
-		struct FetchParticipantsResponse {
-			absl::optional<std::string> janus;
-			absl::optional<std::string> transaction;
+		template<typename String>
+		struct FetchParticipantsResponseT {
+			absl::optional<String> janus;
+			absl::optional<String> transaction;
 			absl::optional<int64_t> session_id;
 			absl::optional<int64_t> sender;
-			absl::optional<ParticipantPluginData> plugindata;
+			absl::optional<ParticipantPluginDataT<String>> plugindata;
 
 			FIELDS_MAP("janus", janus, "transaction", transaction, "session_id", session_id, "sender", sender, "plugindata", plugindata);
 		};
 
+		// FetchParticipantsResponseView is the view variant, its strings reference the JanusMessage it was decoded
+		// from and must not outlive the callback it is handed to
+		using ParticipantInfo = ParticipantInfoT<std::string>;
+		using ParticipantData = ParticipantDataT<std::string>;
+		using ParticipantPluginData = ParticipantPluginDataT<std::string>;
+		using FetchParticipantsResponse = FetchParticipantsResponseT<std::string>;
+		using FetchParticipantsResponseView = FetchParticipantsResponseT<absl::string_view>;
+
 		/*
 		 * If you're interested in publishing media within a room, you can do that
 		 * with a \c publish request. This request MUST be accompanied by a JSEP
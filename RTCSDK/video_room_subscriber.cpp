@@ -1,4 +1,5 @@
 #include "video_room_subscriber.h"
+#include <algorithm>
 #include "utils/string_utils.h"
 #include "logger/logger.h"
 #include "participant.h"
@@ -9,6 +10,17 @@
 #include "pc/media_stream_proxy.h"
 #include "pc/media_stream_track_proxy.h"
 #include "media_controller.h"
+#include "janus_message.h"
+#include "video_capture.h"
+#include "rtc_base/time_utils.h"
+
+namespace {
+	// publisher churn within this window goes out in one request
+	constexpr uint32_t kSubscriptionDebounceMs = 100;
+
+	// refused subscription changes are retried no less often than this
+	constexpr uint32_t kMaxSubscriptionRetryMs = 8000;
+}
 
 namespace vi {
 
@@ -24,7 +36,11 @@ namespace vi {
 	{
 		_pluginContext->plugin = plugin;
 		_pluginContext->opaqueId = opaqueId;
-		_attached = false;
+
+		// what publishers send until told otherwise
+		_layerSelector.setConfig(SimulcastLayerSelector::fromLadder(SimulcastLadder::standard(),
+			static_cast<int32_t>(CapturerTrackSource::kWidth),
+			static_cast<int32_t>(CapturerTrackSource::kHeight)), rtc::TimeMillis());
 	}
 
 	VideoRoomSubscriber::~VideoRoomSubscriber()
@@ -64,23 +80,153 @@ namespace vi {
 
 	void VideoRoomSubscriber::subscribeTo(const std::vector<vr::Publisher>& publishers)
 	{
-		if (_attached) {
-			subscribe(publishers);
+		_serviceThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), publishers]() {
+			auto self = wself.lock();
+			if (!self) {
+				return;
+			}
+			auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(self);
+			for (const auto& pub : publishers) {
+				vrs->_subscriptions.want(pub);
+			}
+			vrs->scheduleFlush(kSubscriptionDebounceMs);
+		});
+	}
+
+	void VideoRoomSubscriber::unsubscribeFrom(int64_t id)
+	{
+		_serviceThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), id]() {
+			auto self = wself.lock();
+			if (!self) {
+				return;
+			}
+			auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(self);
+			vrs->_subscriptions.drop(id);
+			vrs->scheduleFlush(kSubscriptionDebounceMs);
+		});
+	}
+
+	void VideoRoomSubscriber::scheduleFlush(uint32_t delayMs)
+	{
+		if (_flushScheduled || _renegotiating) {
+			return;
+		}
+
+		_flushScheduled = true;
+		_serviceThread->PostDelayedTask(RTC_FROM_HERE, [wself = weak_from_this()]() {
+			auto self = wself.lock();
+			if (!self) {
+				return;
+			}
+			auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(self);
+			vrs->_flushScheduled = false;
+			vrs->flushSubscriptions();
+		}, delayMs);
+	}
+
+	void VideoRoomSubscriber::flushSubscriptions()
+	{
+		if (!_handleAttached) {
+			if (!_attaching && _subscriptions.dirty()) {
+				_attaching = true;
+				this->attach();
+			}
+			return;
+		}
+
+		if (_renegotiating || !_subscriptions.dirty()) {
+			return;
+		}
+
+		// |_joined| is set once Janus acknowledges the join, until then every flush joins
+		_inflight = _subscriptions.take();
+		_renegotiating = true;
+
+		if (!_joined) {
+			join(_inflight->subscribe);
 		}
 		else {
-			this->attach();
-			_joinTask = [wself = weak_from_this(), publishers]() {
-				auto self = wself.lock();
-				if (!self) {
-					return;
-				}
-				auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(self);
-				vrs->join(publishers);
-			};
+			update(*_inflight);
+		}
+	}
+
+	void VideoRoomSubscriber::onRenegotiated()
+	{
+		_renegotiating = false;
+
+		if (_subscriptions.dirty()) {
+			scheduleFlush(kSubscriptionDebounceMs);
+		}
+	}
+
+	void VideoRoomSubscriber::onSubscriptionAcked(const std::string& transaction)
+	{
+		// already answered, or dropped with the handle
+		if (!_inflight || transaction.empty()) {
+			return;
+		}
+
+		_inflightTransaction = transaction;
+
+		// the error event and the ack take different threads here, the error may have come first
+		const bool refused = std::find(_earlyErrors.begin(), _earlyErrors.end(), transaction) != _earlyErrors.end();
+		_earlyErrors.clear();
+		if (refused) {
+			onSubscriptionRefused();
+		}
+	}
+
+	void VideoRoomSubscriber::onSubscriptionAccepted(bool joined)
+	{
+		clearInflight();
+		_retryDelayMs = 0;
+		if (joined) {
+			_joined = true;
 		}
 	}
 
-	void VideoRoomSubscriber::join(const std::vector<vr::Publisher>& publishers)
+	void VideoRoomSubscriber::onSubscriptionError(const std::string& transaction)
+	{
+		// errors of other requests (e.g. a layer configure) leave the subscription as it is
+		if (!_inflight || transaction.empty()) {
+			return;
+		}
+
+		if (_inflightTransaction.empty()) {
+			_earlyErrors.emplace_back(transaction);
+			return;
+		}
+
+		if (transaction == _inflightTransaction) {
+			onSubscriptionRefused();
+		}
+	}
+
+	void VideoRoomSubscriber::onSubscriptionRefused()
+	{
+		if (!_inflight) {
+			return;
+		}
+
+		_subscriptions.rollback(*_inflight);
+		clearInflight();
+		_renegotiating = false;
+		_retryDelayMs = std::min(std::max(_retryDelayMs * 2, kSubscriptionDebounceMs), kMaxSubscriptionRetryMs);
+
+		DLOG("subscription change refused, retrying in {} ms", _retryDelayMs);
+		if (_subscriptions.dirty()) {
+			scheduleFlush(_retryDelayMs);
+		}
+	}
+
+	void VideoRoomSubscriber::clearInflight()
+	{
+		_inflight.reset();
+		_inflightTransaction.clear();
+		_earlyErrors.clear();
+	}
+
+	void VideoRoomSubscriber::join(const std::vector<SubscriptionSet::StreamKey>& streams)
 	{
 		vr::SubscriberJoinRequest request;
 
@@ -89,125 +235,204 @@ namespace vi {
 		request.ptype = "subscriber";
 		request.private_id = _privateId;
 
-		for (const auto& pub : publishers) {
-			if (pub.streams) {
-				auto ss = std::vector<vr::SubscriberJoinRequest::Stream>();
-				for (const auto& str : pub.streams.value()) {
-					vr::SubscriberJoinRequest::Stream stream;
-					stream.feed = pub.id;
-					stream.mid = str.mid;
-					ss.emplace_back(stream);
-				}
-				if (!ss.empty()) {
-					request.streams = ss;
-				}
-			}
+		auto ss = std::vector<vr::SubscriberJoinRequest::Stream>();
+		for (const auto& key : streams) {
+			vr::SubscriberJoinRequest::Stream stream;
+			stream.feed = key.feed;
+			stream.mid = key.mid;
+			ss.emplace_back(stream);
 		}
+		request.streams = ss;
+
+		DLOG("join with {} streams", streams.size());
 
 		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
-		auto lambda = [](bool success, const std::string& response) {
-			DLOG("response: {}", response.c_str());
-			if (response.empty()) {
+		auto lambda = [wself = weak_from_this()](bool success, std::shared_ptr<JanusMessage> reply) {
+			if (success) {
+				// only an ack, "attached" or "updated" follows in onMessage(), or an error event with this transaction
+				if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+					vrs->_serviceThread->PostTask(RTC_FROM_HERE, [wself, transaction = reply->envelope().transaction.value_or("")]() {
+						if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+							vrs->onSubscriptionAcked(transaction);
+						}
+					});
+				}
 				return;
 			}
-
-			std::string err;
-			std::shared_ptr<JanusResponse> rar = fromJsonString<JanusResponse>(response, err);
-			if (!err.empty()) {
-				DLOG("parse JanusResponse failed");
-				return;
+			DLOG("join failed: {}", reply->envelope().janus.value_or(""));
+			if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+				vrs->_serviceThread->PostTask(RTC_FROM_HERE, [wself]() {
+					if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+						vrs->onSubscriptionRefused();
+					}
+				});
 			}
 		};
-		std::shared_ptr<vi::EventCallback> cb = std::make_shared<vi::EventCallback>(lambda);
-		event->message = request.toJsonStr();
-		DLOG("request.toJsonStr(): {}", request.toJsonStr());
-		event->callback = cb;
+		std::shared_ptr<vi::ReplyCallback> cb = std::make_shared<vi::ReplyCallback>(lambda);
+		event->body = JsonBody::of(std::move(request));
+		event->reply = cb;
 		sendMessage(event);
 	}
 
-	void VideoRoomSubscriber::subscribe(const std::vector<vr::Publisher>& publishers)
+	void VideoRoomSubscriber::update(const SubscriptionSet::Diff& diff)
 	{
-		vr::SubscribeRequest request;
-
-		request.request = "subscribe";
+		vr::UpdateSubscriptionRequest request;
+
+		if (!diff.subscribe.empty()) {
+			auto ss = std::vector<vr::SubscribeRequest::Stream>();
+			for (const auto& key : diff.subscribe) {
+				vr::SubscribeRequest::Stream stream;
+				stream.feed = key.feed;
+				stream.mid = key.mid;
+				ss.emplace_back(stream);
+			}
+			request.subscribe = ss;
+		}
 
-		for (const auto& pub : publishers) {
-			if (pub.streams) {
-				auto ss = std::vector<vr::SubscribeRequest::Stream>();
-				for (const auto& str : pub.streams.value()) {
-					vr::SubscribeRequest::Stream stream;
-					stream.feed = pub.id;
-					stream.mid = str.mid;
-					ss.emplace_back(stream);
-				}
-				if (!ss.empty()) {
-					request.streams = ss;
-				}
+		if (!diff.unsubscribe.empty()) {
+			auto ss = std::vector<vr::UnsubscribeRequest::Stream>();
+			for (const auto& key : diff.unsubscribe) {
+				vr::UnsubscribeRequest::Stream stream;
+				stream.feed = key.feed;
+				stream.mid = key.mid;
+				ss.emplace_back(stream);
 			}
+			request.unsubscribe = ss;
 		}
 
+		DLOG("update subscription, subscribe: {}, unsubscribe: {}", diff.subscribe.size(), diff.unsubscribe.size());
+
 		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
-		auto lambda = [](bool success, const std::string& response) {
-			DLOG("response: {}", response.c_str());
-			if (response.empty()) {
+		auto lambda = [wself = weak_from_this()](bool success, std::shared_ptr<JanusMessage> reply) {
+			if (success) {
+				// only an ack, "attached" or "updated" follows in onMessage(), or an error event with this transaction
+				if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+					vrs->_serviceThread->PostTask(RTC_FROM_HERE, [wself, transaction = reply->envelope().transaction.value_or("")]() {
+						if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+							vrs->onSubscriptionAcked(transaction);
+						}
+					});
+				}
 				return;
 			}
-
-			std::string err;
-			std::shared_ptr<JanusResponse> rar = fromJsonString<JanusResponse>(response, err);
-			if (!err.empty()) {
-				DLOG("parse JanusResponse failed");
-				return;
+			DLOG("update failed: {}", reply->envelope().janus.value_or(""));
+			if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+				vrs->_serviceThread->PostTask(RTC_FROM_HERE, [wself]() {
+					if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+						vrs->onSubscriptionRefused();
+					}
+				});
 			}
 		};
-		std::shared_ptr<vi::EventCallback> cb = std::make_shared<vi::EventCallback>(lambda);
-		event->message = request.toJsonStr();
-		event->callback = cb;
+		std::shared_ptr<vi::ReplyCallback> cb = std::make_shared<vi::ReplyCallback>(lambda);
+		event->body = JsonBody::of(std::move(request));
+		event->reply = cb;
 		sendMessage(event);
 	}
 
-	void VideoRoomSubscriber::unsubscribeFrom(int64_t id)
+	void VideoRoomSubscriber::setRenderedSize(const std::string& mid, int32_t width, int32_t height, bool visible)
 	{
-		vr::UnsubscribeRequest request;
+		_layerSelector.update(mid, width, height, visible, rtc::TimeMillis());
+		evaluateLayers();
+	}
 
-		request.request = "subscribe";
+	void VideoRoomSubscriber::setVisible(const std::string& mid, bool visible)
+	{
+		_layerSelector.setVisible(mid, visible, rtc::TimeMillis());
+		evaluateLayers();
+	}
 
-		vr::UnsubscribeRequest::Stream stream;
-		stream.feed = id;
-		auto ss = std::vector<vr::UnsubscribeRequest::Stream>();
-		ss.emplace_back(stream);
-		request.streams = ss;
+	void VideoRoomSubscriber::setPublisherLadder(const SimulcastLadder& ladder, int32_t width, int32_t height)
+	{
+		_layerSelector.setConfig(SimulcastLayerSelector::fromLadder(ladder, width, height), rtc::TimeMillis());
+		evaluateLayers();
+	}
 
-		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
-		auto lambda = [](bool success, const std::string& response) {
-			DLOG("response: {}", response.c_str());
-			if (response.empty()) {
+	void VideoRoomSubscriber::evaluateLayers()
+	{
+		const int64_t now = rtc::TimeMillis();
+		for (const auto& change : _layerSelector.poll(now)) {
+			configureLayer(change.first, change.second);
+		}
+
+		absl::optional<int64_t> deadline = _layerSelector.nextDeadline();
+		if (!deadline || _layerCheckScheduled) {
+			return;
+		}
+
+		_layerCheckScheduled = true;
+		_serviceThread->PostDelayedTask(RTC_FROM_HERE, [wself = weak_from_this()]() {
+			auto self = wself.lock();
+			if (!self) {
 				return;
 			}
+			auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(self);
+			vrs->_layerCheckScheduled = false;
+			vrs->evaluateLayers();
+		}, static_cast<uint32_t>(std::max<int64_t>(*deadline - now, 0)));
+	}
 
-			std::string err;
-			std::shared_ptr<JanusResponse> rar = fromJsonString<JanusResponse>(response, err);
-			if (!err.empty()) {
-				DLOG("parse JanusResponse failed");
-				return;
+	void VideoRoomSubscriber::configureLayer(const std::string& mid, const SimulcastLayer& layer)
+	{
+		vr::SubscriberConfigureRequest request;
+		request.mid = mid;
+		request.send = layer.send;
+		if (layer.send) {
+			request.substream = layer.substream;
+			request.temporal = layer.temporal;
+		}
+		request.restart = absl::nullopt;
+
+		DLOG("configure mid: {}, send: {}, substream: {}, temporal: {}", mid, layer.send, layer.substream, layer.temporal);
+
+		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
+		auto lambda = [mid](bool success, std::shared_ptr<JanusMessage> reply) {
+			if (!success) {
+				DLOG("configure mid {} failed: {}", mid, reply->envelope().janus.value_or(""));
 			}
 		};
-		std::shared_ptr<vi::EventCallback> cb = std::make_shared<vi::EventCallback>(lambda);
-		event->message = request.toJsonStr();
-		event->callback = cb;
+		std::shared_ptr<vi::ReplyCallback> cb = std::make_shared<vi::ReplyCallback>(lambda);
+		event->body = JsonBody::of(std::move(request));
+		event->reply = cb;
+		sendMessage(event);
+	}
+
+	void VideoRoomSubscriber::restartIce()
+	{
+		// Janus sends a new offer with fresh ICE credentials, answered in onMessage
+		vr::SubscriberConfigureRequest request;
+		// without a mid "send" would apply to every stream
+		request.send = absl::nullopt;
+		request.restart = true;
+
+		std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
+		auto lambda = [](bool success, std::shared_ptr<JanusMessage> reply) {
+			if (!success) {
+				DLOG("ice restart failed: {}", reply->envelope().janus.value_or(""));
+			}
+		};
+		event->body = JsonBody::of(std::move(request));
+		event->reply = std::make_shared<vi::ReplyCallback>(lambda);
 		sendMessage(event);
 	}
 
 	void VideoRoomSubscriber::onAttached(bool success)
 	{
-		if (success) {
-			if (_joinTask) {
-				_joinTask();
+		_serviceThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), success]() {
+			auto self = wself.lock();
+			if (!self) {
+				return;
 			}
-		}
-		else {
-			DLOG("  -- Error attaching plugin...");
-		}
+			auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(self);
+			vrs->_attaching = false;
+			vrs->_handleAttached = success;
+			if (success) {
+				vrs->flushSubscriptions();
+			}
+			else {
+				DLOG("  -- Error attaching plugin...");
+			}
+		});
 	}
 
 	void VideoRoomSubscriber::onHangup() 
@@ -229,12 +454,12 @@ namespace vi {
 		DLOG("Janus reports problems {} packets on mid {} ({} lost packets)", (uplink ? "sending" : "receiving"), mid, lost);
 	}
 
-	void VideoRoomSubscriber::onMessage(const std::string& data, const std::string& jsepString)
+	void VideoRoomSubscriber::onMessage(std::shared_ptr<JanusMessage> message, std::shared_ptr<Jsep> jsep)
 	{
 		DLOG(" ::: Got a message (subscriber) :::");
 
 		std::string err;
-		std::shared_ptr<vr::VideoRoomEvent> vrEvent = fromJsonString<vr::VideoRoomEvent>(data, err);
+		std::shared_ptr<vr::VideoRoomEvent> vrEvent = message->to<vr::VideoRoomEvent>(err);
 		if (!err.empty()) {
 			DLOG("parse JanusResponse failed");
 			return;
@@ -257,9 +482,8 @@ namespace vi {
 		const auto& event = pluginData->data->videoroom;
 
 		if (event.value_or("") == "attached") {
-			_attached = true;
 			std::string err;
-			std::shared_ptr<vr::AttachedEvent> aEvent = fromJsonString<vr::AttachedEvent>(data, err);
+			std::shared_ptr<vr::AttachedEvent> aEvent = message->to<vr::AttachedEvent>(err);
 			if (!err.empty()) {
 				DLOG("parse JanusResponse failed");
 				return;
@@ -274,16 +498,30 @@ namespace vi {
 
 			if (pluginData->data->error) {
 				DLOG("error event: {}", pluginData->data->error.value_or(""));
+				// undone only when it answers the in-flight "join" or "update", not e.g. a layer configure
+				_serviceThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), transaction = message->envelope().transaction.value_or("")]() {
+					if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+						vrs->onSubscriptionError(transaction);
+					}
+				});
 			}
 		}
 
-		if (jsepString.empty()) {
-			return;
+		const bool accepted = event.value_or("") == "attached" || event.value_or("") == "updated";
+		const bool offered = jsep && jsep->type && jsep->sdp && !jsep->type.value().empty() && !jsep->sdp.value().empty();
+		if (accepted) {
+			_serviceThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this(), joined = event.value_or("") == "attached", offered]() {
+				if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+					vrs->onSubscriptionAccepted(joined);
+					if (!offered) {
+						// nothing to negotiate, the next change can go out
+						vrs->onRenegotiated();
+					}
+				}
+			});
 		}
-		err.clear();
-		std::shared_ptr<Jsep> jsep = fromJsonString<Jsep>(jsepString, err);
-		if (!err.empty()) {
-			DLOG("parse JanusResponse failed");
+
+		if (!jsep) {
 			return;
 		}
 
@@ -303,21 +541,34 @@ namespace vi {
 					request.room = roomId;
 
 					std::shared_ptr<MessageEvent> event = std::make_shared<vi::MessageEvent>();
-					auto lambda = [](bool success, const std::string& response) {
-						DLOG("response: {}", response.c_str());
+					auto lambda = [wself](bool success, std::shared_ptr<JanusMessage> reply) {
+						// our answer is in, Janus takes further updates from now on
+						if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+							vrs->_serviceThread->PostTask(RTC_FROM_HERE, [wself]() {
+								if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+									vrs->onRenegotiated();
+								}
+							});
+						}
 					};
 
-					std::shared_ptr<vi::EventCallback> callback = std::make_shared<vi::EventCallback>(lambda);
-					event->message = request.toJsonStr();
+					std::shared_ptr<vi::ReplyCallback> callback = std::make_shared<vi::ReplyCallback>(lambda);
+					event->body = JsonBody::of(std::move(request));
 					Jsep jsep;
 					jsep.type = jsepConfig.type;
 					jsep.sdp = jsepConfig.sdp;
-					event->jsep = jsep.toJsonStr();
-					event->callback = callback;
+					event->jsep = JsonBody::of(std::move(jsep));
+					event->reply = callback;
 					self->sendMessage(event);
 				}
 				else {
 					DLOG("WebRTC error: {}", reason.c_str());
+					auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(self);
+					vrs->_serviceThread->PostTask(RTC_FROM_HERE, [wself]() {
+						if (auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(wself.lock())) {
+							vrs->onRenegotiated();
+						}
+					});
 				}
 			});
 			MediaConfig media;
@@ -344,20 +595,54 @@ namespace vi {
 
 	void VideoRoomSubscriber::onCleanup() 
 	{
+		_layerSelector.clear();
+
+		// Janus dropped the subscription, the next flush joins again with everything still wanted
+		_serviceThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this()]() {
+			auto self = wself.lock();
+			if (!self) {
+				return;
+			}
+			auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(self);
+			vrs->_subscriptions.reset();
+			vrs->clearInflight();
+			vrs->_joined = false;
+			vrs->_renegotiating = false;
+			if (vrs->_subscriptions.dirty()) {
+				vrs->scheduleFlush(kSubscriptionDebounceMs);
+			}
+		});
+
 		PluginClient::onCleanup();
 	}
 
-	void VideoRoomSubscriber::onDetached() {}
+	void VideoRoomSubscriber::onDetached()
+	{
+		_serviceThread->PostTask(RTC_FROM_HERE, [wself = weak_from_this()]() {
+			auto self = wself.lock();
+			if (!self) {
+				return;
+			}
+			auto vrs = std::dynamic_pointer_cast<VideoRoomSubscriber>(self);
+			vrs->_handleAttached = false;
+			vrs->_joined = false;
+			vrs->_renegotiating = false;
+			vrs->clearInflight();
+			vrs->_subscriptions.reset();
+		});
+	}
 
 	void VideoRoomSubscriber::onRemoteTrack(rtc::scoped_refptr<webrtc::MediaStreamTrackInterface> track, const std::string& mid, bool on)
 	{
+		if (!on) {
+			_layerSelector.remove(mid);
+		}
+		else if (track && track->kind() == webrtc::MediaStreamTrackInterface::kVideoKind) {
+			_layerSelector.add(mid);
+		}
+
 		if (auto mc = _mediaController.lock()) {
 			mc->onRemoteTrack(track, mid, on);
 		}
 	}
-
-	void VideoRoomSubscriber::onStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report)
-	{
-		DLOG("RTC Stats Report: {}", report->ToJson());
-	}
 }
\ No newline at end of file
@@ -4,14 +4,14 @@
 #include "plugin_client.h"
 #include "utils/universal_observable.hpp"
 #include "video_room_models.h"
+#include "simulcast_layer_selector.h"
+#include "subscription_set.h"
 
 namespace vi {
 	class IVideoRoomEventHandler;
 	class IVideoRoomApi;
 	class MediaController;
 
-	using DelayedTask = std::function<void()>;
-
 	class VideoRoomSubscriber : public PluginClient, public UniversalObservable<IVideoRoomEventHandler>
 	{
 	public:
@@ -36,10 +36,21 @@ namespace vi {
 
 		void setPrivateId(int64_t id);
 
+		// Publisher churn is coalesced, see flushSubscriptions()
 		void subscribeTo(const std::vector<vr::Publisher>& publishers);
 
 		void unsubscribeFrom(int64_t id);
 
+		// Size in device pixels the remote video |mid| is rendered at, picks its simulcast layer
+		void setRenderedSize(const std::string& mid, int32_t width, int32_t height, bool visible);
+
+		// Pauses the remote video |mid| while it is hidden and resumes it once shown again
+		void setVisible(const std::string& mid, bool visible);
+
+		// The ladder the publishers of the room send from a |width|x|height| capture, the layers are picked by its
+		// heights. Publishers run this SDK, so it is the ladder set on the local publisher.
+		void setPublisherLadder(const SimulcastLadder& ladder, int32_t width, int32_t height);
+
 	protected:
 
 		// signaling event
@@ -52,7 +63,7 @@ namespace vi {
 
 		void onSlowLink(bool uplink, bool lost, const std::string& mid) override;
 
-		void onMessage(const std::string& data, const std::string& jsep) override;
+		void onMessage(std::shared_ptr<JanusMessage> message, std::shared_ptr<Jsep> jsep) override;
 
 		void onTimeout()override;
 
@@ -70,24 +81,74 @@ namespace vi {
 
 		void onRemoteTrack(rtc::scoped_refptr<webrtc::MediaStreamTrackInterface> track, const std::string& mid, bool on) override;
 
-		void onStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report) override;
+		void restartIce() override;
 
 	private:
-		void join(const std::vector<vr::Publisher>& publishers);
+		void join(const std::vector<SubscriptionSet::StreamKey>& streams);
+
+		void update(const SubscriptionSet::Diff& diff);
+
+		void scheduleFlush(uint32_t delayMs);
+
+		// Sends whatever changed in the wanted streams as one "join" or "update", one at a time:
+		// changes arriving while Janus renegotiates wait for it and go out together afterwards
+		void flushSubscriptions();
+
+		void onRenegotiated();
+
+		// Janus acked the in-flight "join" or "update" with |transaction|, its answer follows as an event
+		void onSubscriptionAcked(const std::string& transaction);
+
+		// Janus took the in-flight "join" or "update"
+		void onSubscriptionAccepted(bool joined);
+
+		// an error event of the request sent with |transaction|, a refusal only when that is the in-flight one
+		void onSubscriptionError(const std::string& transaction);
+
+		// Janus or the transport refused the in-flight request: its streams are wanted again and
+		// go out with the next flush, later and later while refusals keep coming
+		void onSubscriptionRefused();
 
-		void subscribe(const std::vector<vr::Publisher>& publishers);
+		void clearInflight();
+
+		void evaluateLayers();
+
+		void configureLayer(const std::string& mid, const SimulcastLayer& layer);
 
 	private:
 		int64_t _roomId;
 
 		std::weak_ptr<IVideoRoomApi> _videoRoomApi;
 
-		std::atomic_bool _attached;
+		// subscription state, service thread only
+		SubscriptionSet _subscriptions;
+
+		bool _attaching = false;
+
+		bool _handleAttached = false;
+
+		bool _joined = false;
+
+		bool _renegotiating = false;
 
-		std::vector<vr::Publisher> _publishers;
+		bool _flushScheduled = false;
 
-		DelayedTask _joinTask;
+		// the diff of the "join" or "update" Janus has not answered yet
+		absl::optional<SubscriptionSet::Diff> _inflight;
+
+		// the transaction of the in-flight request, empty until its ack is in
+		std::string _inflightTransaction;
+
+		// error events that came in before the ack of the in-flight request, by transaction
+		std::vector<std::string> _earlyErrors;
+
+		uint32_t _retryDelayMs = 0;
 
 		std::weak_ptr<MediaController> _mediaController;
+
+		// service thread only
+		SimulcastLayerSelector _layerSelector;
+
+		bool _layerCheckScheduled = false;
 	};
 }
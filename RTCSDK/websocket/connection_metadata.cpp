@@ -25,10 +25,11 @@ namespace vi {
 		, _uri(uri)
 		, _server("N/A")
 		, _listener(listener)
+		, _outputPool(websocketpp::lib::make_shared<PooledClientConfig::con_msg_manager_type>())
 	{}
 
 	void ConnectionMetadata::onOpen(client* c, websocketpp::connection_hdl hdl) {
-		_status = "Open";
+		setStatus("Open");
 
 		client::connection_ptr con = c->get_con_from_hdl(hdl);
 		_server = con->get_response_header("Server");
@@ -38,7 +39,7 @@ namespace vi {
 	}
 
 	void ConnectionMetadata::onFail(client* c, websocketpp::connection_hdl hdl) {
-		_status = "Failed";
+		setStatus("Failed");
 
 		client::connection_ptr con = c->get_con_from_hdl(hdl);
 		_server = con->get_response_header("Server");
@@ -50,7 +51,7 @@ namespace vi {
 	}
 
 	void ConnectionMetadata::onClose(client* c, websocketpp::connection_hdl hdl) {
-		_status = "Closed";
+		setStatus("Closed");
 		client::connection_ptr con = c->get_con_from_hdl(hdl);
 		std::stringstream s;
 		s << "close code: " << con->get_remote_close_code() << " (" << websocketpp::close::status::get_string(con->get_remote_close_code()) << "), close reason: " << con->get_remote_close_reason();
@@ -74,7 +75,8 @@ namespace vi {
 		if (auto listener = _listener.lock()) {
 			if (msg->get_opcode() == websocketpp::frame::opcode::text) {
 				//DLOG("> received text message: {}", msg->get_payload());
-				listener->onTextMessage(msg->get_payload());
+				// the payload buffer moves on with the text, the pooled message gets a fresh one
+				listener->onTextMessage(std::move(msg->get_raw_payload()));
 			} else if (msg->get_opcode() == websocketpp::frame::opcode::binary) {
 				//DLOG("> received binary message {}", websocketpp::utility::to_hex(msg->get_payload()));
 				std::vector<uint8_t> data(msg->get_payload().begin(), msg->get_payload().end());
@@ -113,10 +115,20 @@ namespace vi {
 		return _id;
 	}
 
+	void ConnectionMetadata::setStatus(const std::string& status) {
+		std::lock_guard<std::mutex> lock(_statusMutex);
+		_status = status;
+	}
+
 	std::string ConnectionMetadata::getStatus() const {
+		std::lock_guard<std::mutex> lock(_statusMutex);
 		return _status;
 	}
 
+	client::message_ptr ConnectionMetadata::acquireMessage(websocketpp::frame::opcode::value op) {
+		return _outputPool->get_message(op, 0);
+	}
+
 	std::ostream & operator<< (std::ostream& out, ConnectionMetadata const& data) {
 		out << "> URI: " << data._uri << "\n"
 			<< "> Status: " << data._status << "\n"
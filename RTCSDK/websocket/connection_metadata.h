@@ -7,12 +7,14 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <websocketpp/config/asio_no_tls_client.hpp>
 #include <websocketpp/client.hpp>
 #include "websocket/i_connection_listener.h"
+#include "websocket/pooled_message_manager.hpp"
 
 
-typedef websocketpp::client<websocketpp::config::asio_client> client;
+typedef websocketpp::client<vi::PooledClientConfig> client;
 
 namespace vi {
 
@@ -44,15 +46,23 @@ namespace vi {
 
 		std::string getStatus() const;
 
+		// An empty outgoing message from this connection's freelist
+		client::message_ptr acquireMessage(websocketpp::frame::opcode::value op);
+
 		friend std::ostream & operator<< (std::ostream& out, ConnectionMetadata const& data);
 	private:
+		void setStatus(const std::string& status);
+
 		int _id;
 		websocketpp::connection_hdl _hdl;
+		// written on the connection's strand, read from any thread
+		mutable std::mutex _statusMutex;
 		std::string _status;
 		std::string _uri;
 		std::string _server;
 		std::string _errorReason;
 		std::weak_ptr<IConnectionListener> _listener;
+		PooledClientConfig::con_msg_manager_type::ptr _outputPool;
 	};
 
 }
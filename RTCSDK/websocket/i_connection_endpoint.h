@@ -0,0 +1,38 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <stdint.h>
+
+namespace vi {
+	class IConnectionListener;
+
+	// A message oriented connection to Janus, events of a connection are delivered to its IConnectionListener
+	class IConnectionEndpoint {
+	public:
+		virtual ~IConnectionEndpoint() {}
+
+		// -1 if the connection could not be set up, otherwise onOpen() or onFail() follows
+		virtual int connect(std::string const& uri, std::shared_ptr<IConnectionListener> listener, const std::string& subprotocol = "", long pongTimeoutMs = 0) = 0;
+
+		virtual void close(int id, uint16_t code, const std::string& reason) = 0;
+
+		virtual void sendText(int id, const std::string& data) = 0;
+
+		// |writer| fills the payload in place, in a buffer of the endpoint
+		virtual void sendText(int id, const std::function<void(std::string&)>& writer) = 0;
+
+		virtual void sendBinary(int id, const std::vector<uint8_t>& data) = 0;
+
+		// Liveness check, endpoints that see a dead peer on their own do nothing
+		virtual void sendPing(int id, const std::string& data) = 0;
+	};
+}
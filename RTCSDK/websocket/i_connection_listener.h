@@ -22,7 +22,8 @@ namespace vi {
 
 		virtual bool onValidate() = 0;
 
-		virtual void onTextMessage(const std::string& text) = 0;
+		// |text| is handed over, the listener may keep its buffer
+		virtual void onTextMessage(std::string&& text) = 0;
 
 		virtual void onBinaryMessage(const std::vector<uint8_t>& data) = 0;
 
@@ -0,0 +1,95 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <websocketpp/config/asio_no_tls_client.hpp>
+#include <websocketpp/message_buffer/message.hpp>
+#include <websocketpp/message_buffer/alloc.hpp>
+#include <websocketpp/common/memory.hpp>
+#include <websocketpp/frame.hpp>
+
+namespace vi {
+	// websocketpp connection message manager backed by a per-connection freelist.
+	// A message is handed out again once the freelist holds its only reference, its payload keeps
+	// the capacity of earlier frames, so steady state sends do not touch the heap.
+	// Received text payloads are moved out to the listener (see ConnectionMetadata::onMessage),
+	// each incoming frame is read into a buffer of its own which is not recycled
+	template <typename message>
+	class PooledMessageManager : public websocketpp::lib::enable_shared_from_this<PooledMessageManager<message>> {
+	public:
+		typedef PooledMessageManager<message> type;
+		typedef websocketpp::lib::shared_ptr<PooledMessageManager> ptr;
+		typedef websocketpp::lib::weak_ptr<PooledMessageManager> weak_ptr;
+		typedef typename message::ptr message_ptr;
+
+		static constexpr size_t kMaxMessages = 32;
+
+		// payloads grown beyond this (e.g. an sdp) are released instead of being kept around
+		static constexpr size_t kMaxRetainedCapacity = 64 * 1024;
+
+		message_ptr get_message() {
+			return acquire(websocketpp::frame::opcode::text, 0);
+		}
+
+		message_ptr get_message(websocketpp::frame::opcode::value op, size_t size) {
+			return acquire(op, size);
+		}
+
+		bool recycle(message*) {
+			return false;
+		}
+
+	private:
+		message_ptr acquire(websocketpp::frame::opcode::value op, size_t size) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			for (const auto& msg : _messages) {
+				if (msg.use_count() == 1) {
+					// pairs with the release done by the last owner dropping its reference
+					std::atomic_thread_fence(std::memory_order_acquire);
+					reset(*msg, op, size);
+					return msg;
+				}
+			}
+
+			message_ptr msg = websocketpp::lib::make_shared<message>(type::shared_from_this(), op, size);
+			if (_messages.size() < kMaxMessages) {
+				_messages.emplace_back(msg);
+			}
+			return msg;
+		}
+
+		static void reset(message& msg, websocketpp::frame::opcode::value op, size_t size) {
+			std::string& payload = msg.get_raw_payload();
+			if (payload.capacity() > kMaxRetainedCapacity) {
+				std::string().swap(payload);
+			}
+			payload.clear();
+			payload.reserve(size);
+			msg.set_opcode(op);
+			msg.set_header(std::string());
+			msg.set_prepared(false);
+			msg.set_compressed(false);
+			msg.set_fin(true);
+			msg.set_terminal(false);
+		}
+
+	private:
+		std::mutex _mutex;
+
+		std::vector<message_ptr> _messages;
+	};
+
+	struct PooledClientConfig : public websocketpp::config::asio_client {
+		typedef PooledClientConfig type;
+		typedef websocketpp::message_buffer::message<PooledMessageManager> message_type;
+		typedef PooledMessageManager<message_type> con_msg_manager_type;
+		typedef websocketpp::message_buffer::alloc::endpoint_msg_manager<con_msg_manager_type> endpoint_msg_manager_type;
+	};
+}
@@ -0,0 +1,252 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "unix_socket_endpoint.h"
+#include <cstring>
+#include "websocket/i_connection_listener.h"
+#include "logger/logger.h"
+
+namespace {
+	// a packet is read whole or truncated, the largest the kernel lets a local socket carry by default
+	constexpr size_t kMaxPacketSize = 256 * 1024;
+
+	// going away, as a websocket close code
+	constexpr int kCloseGoingAway = 1001;
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+	// local::seq_packet_protocol only comes with recent asio: the generic protocol opens the same
+	// AF_UNIX/SOCK_SEQPACKET socket from the sockaddr_un of a local endpoint
+	asio::generic::seq_packet_protocol::endpoint localEndpoint(const std::string& path)
+	{
+		return asio::generic::seq_packet_protocol::endpoint(asio::local::stream_protocol::endpoint(path));
+	}
+#endif
+}
+
+namespace vi {
+	struct UnixSocketEndpoint::Connection {
+		explicit Connection(asio::io_service& context)
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+			: socket(context)
+#endif
+		{
+		}
+
+		int id = -1;
+
+		std::string path;
+
+		std::weak_ptr<IConnectionListener> listener;
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+		asio::generic::seq_packet_protocol::socket socket;
+#endif
+
+		std::vector<char> buffer;
+
+		asio::socket_base::message_flags flags = 0;
+
+		// the listener got onClose() or onFail(), nothing follows
+		bool closed = false;
+	};
+
+	UnixSocketEndpoint::UnixSocketEndpoint()
+		: _work(std::make_unique<asio::io_service::work>(_context))
+	{
+		_thread = std::thread([this]() {
+			_context.run();
+		});
+	}
+
+	UnixSocketEndpoint::~UnixSocketEndpoint()
+	{
+		std::map<int, std::shared_ptr<Connection>> connections;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			connections.swap(_connections);
+		}
+		_context.post([connections]() {
+			for (const auto& pair : connections) {
+				// going away with the endpoint, the listeners are not told
+				pair.second->closed = true;
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+				asio::error_code ec;
+				pair.second->socket.close(ec);
+#endif
+			}
+		});
+
+		_work.reset();
+		if (_thread.joinable()) {
+			_thread.join();
+		}
+	}
+
+	bool UnixSocketEndpoint::accepts(const std::string& uri)
+	{
+		return uri.compare(0, strlen(kScheme), kScheme) == 0;
+	}
+
+	int UnixSocketEndpoint::connect(std::string const& uri, std::shared_ptr<IConnectionListener> listener, const std::string& subprotocol, long pongTimeoutMs)
+	{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+		if (!accepts(uri) || uri.size() == strlen(kScheme)) {
+			ELOG("> Invalid unix socket uri: {}", uri);
+			return -1;
+		}
+
+		auto conn = std::make_shared<Connection>(_context);
+		conn->path = uri.substr(strlen(kScheme));
+		conn->listener = listener;
+		conn->buffer.resize(kMaxPacketSize);
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			conn->id = _nextId++;
+			_connections[conn->id] = conn;
+		}
+
+		_context.post([this, conn]() {
+			conn->socket.async_connect(localEndpoint(conn->path), [this, conn](const asio::error_code& ec) {
+				if (ec) {
+					ELOG("> Connect to {} failed: {}", conn->path, ec.message());
+					shutdown(conn, ec.value(), ec.message(), true);
+					return;
+				}
+				if (auto listener = conn->listener.lock()) {
+					listener->onOpen();
+				}
+				receive(conn);
+			});
+		});
+
+		return conn->id;
+#else
+		ELOG("> Unix domain sockets are not supported on this platform: {}", uri);
+		return -1;
+#endif
+	}
+
+	void UnixSocketEndpoint::close(int id, uint16_t code, const std::string& reason)
+	{
+		if (auto conn = connection(id)) {
+			_context.post([this, conn, code, reason]() {
+				shutdown(conn, code, reason, false);
+			});
+		}
+	}
+
+	void UnixSocketEndpoint::sendText(int id, const std::string& data)
+	{
+		send(id, std::make_shared<std::string>(data));
+	}
+
+	void UnixSocketEndpoint::sendText(int id, const std::function<void(std::string&)>& writer)
+	{
+		auto packet = std::make_shared<std::string>();
+		writer(*packet);
+		DLOG("sendText: {}", packet->c_str());
+		send(id, std::move(packet));
+	}
+
+	void UnixSocketEndpoint::sendBinary(int id, const std::vector<uint8_t>& data)
+	{
+		send(id, std::make_shared<std::string>(data.begin(), data.end()));
+	}
+
+	void UnixSocketEndpoint::sendPing(int id, const std::string& data)
+	{
+		// the peer is on this host, its socket being closed is seen by the pending read
+	}
+
+	std::shared_ptr<UnixSocketEndpoint::Connection> UnixSocketEndpoint::connection(int id)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _connections.find(id);
+		if (it == _connections.end()) {
+			ELOG("> No connection found with id: {}", id);
+			return nullptr;
+		}
+		return it->second;
+	}
+
+	void UnixSocketEndpoint::send(int id, std::shared_ptr<std::string> packet)
+	{
+		auto conn = connection(id);
+		if (!conn) {
+			return;
+		}
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+		// one packet per message, the kernel keeps them apart and in order
+		_context.post([conn, packet]() {
+			if (conn->closed) {
+				return;
+			}
+			conn->socket.async_send(asio::buffer(*packet), 0, [conn, packet](const asio::error_code& ec, size_t) {
+				if (ec && ec != asio::error::operation_aborted) {
+					ELOG("> Error sending message: {}", ec.message());
+				}
+			});
+		});
+#endif
+	}
+
+	void UnixSocketEndpoint::receive(std::shared_ptr<Connection> conn)
+	{
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+		conn->socket.async_receive(asio::buffer(conn->buffer), conn->flags, [this, conn](const asio::error_code& ec, size_t size) {
+			if (conn->closed) {
+				return;
+			}
+			if (ec || size == 0) {
+				// an orderly shutdown of the peer reads as an empty packet or eof
+				const bool eof = !ec || ec == asio::error::eof;
+				shutdown(conn, eof ? kCloseGoingAway : ec.value(), eof ? "peer closed" : ec.message(), false);
+				return;
+			}
+#if defined(MSG_TRUNC)
+			if (conn->flags & MSG_TRUNC) {
+				ELOG("> Dropped a packet larger than {} bytes", conn->buffer.size());
+				receive(conn);
+				return;
+			}
+#endif
+			if (auto listener = conn->listener.lock()) {
+				listener->onTextMessage(std::string(conn->buffer.data(), size));
+			}
+			receive(conn);
+		});
+#endif
+	}
+
+	void UnixSocketEndpoint::shutdown(std::shared_ptr<Connection> conn, int code, const std::string& reason, bool failed)
+	{
+		if (conn->closed) {
+			return;
+		}
+		conn->closed = true;
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+		asio::error_code ec;
+		conn->socket.shutdown(asio::socket_base::shutdown_both, ec);
+		conn->socket.close(ec);
+#endif
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_connections.erase(conn->id);
+		}
+
+		if (auto listener = conn->listener.lock()) {
+			if (failed) {
+				listener->onFail(code, reason);
+			}
+			else {
+				listener->onClose(code, reason);
+			}
+		}
+	}
+}
@@ -0,0 +1,72 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <asio.hpp>
+#include "i_connection_endpoint.h"
+
+namespace vi {
+	// Connections to a Janus on the same host through janus.transport.pfunix: one SOCK_SEQPACKET
+	// packet per json message, no http upgrade, framing or masking. uri: unix:///run/janus.sock
+	// Socket operations run on the thread of the endpoint, sends from other threads are posted to it.
+	class UnixSocketEndpoint : public IConnectionEndpoint {
+	public:
+		static constexpr const char* kScheme = "unix://";
+
+		UnixSocketEndpoint();
+
+		~UnixSocketEndpoint() override;
+
+		static bool accepts(const std::string& uri);
+
+		// |subprotocol| and |pongTimeoutMs| do not apply, a dead peer shows up as a failed read
+		int connect(std::string const& uri, std::shared_ptr<IConnectionListener> listener, const std::string& subprotocol = "", long pongTimeoutMs = 0) override;
+
+		void close(int id, uint16_t code, const std::string& reason) override;
+
+		void sendText(int id, const std::string& data) override;
+
+		void sendText(int id, const std::function<void(std::string&)>& writer) override;
+
+		void sendBinary(int id, const std::vector<uint8_t>& data) override;
+
+		void sendPing(int id, const std::string& data) override;
+
+	private:
+		struct Connection;
+
+		std::shared_ptr<Connection> connection(int id);
+
+		void send(int id, std::shared_ptr<std::string> packet);
+
+		void receive(std::shared_ptr<Connection> conn);
+
+		// Closes the socket once and tells the listener
+		void shutdown(std::shared_ptr<Connection> conn, int code, const std::string& reason, bool failed);
+
+		UnixSocketEndpoint(const UnixSocketEndpoint&) = delete;
+
+		UnixSocketEndpoint& operator=(const UnixSocketEndpoint&) = delete;
+
+	private:
+		asio::io_service _context;
+
+		std::unique_ptr<asio::io_service::work> _work;
+
+		std::thread _thread;
+
+		std::mutex _mutex;
+
+		std::map<int, std::shared_ptr<Connection>> _connections;
+
+		int _nextId = 0;
+	};
+}
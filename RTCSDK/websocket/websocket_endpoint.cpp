@@ -5,47 +5,73 @@
  **/
 
 #include "websocket_endpoint.h"
+#include <algorithm>
 #include "websocket/i_connection_listener.h"
 #include "logger/logger.h"
 //typedef websocketpp::client<websocketpp::config::asio_tls_client> client;
 //typedef websocketpp::lib::shared_ptr<websocketpp::lib::asio::ssl::context> context_ptr;
 
 namespace vi {
-	WebsocketEndpoint::WebsocketEndpoint()
-		: _nextId(0) {
+	WebsocketEndpoint::WebsocketEndpoint(size_t ioThreads) {
 		_endpoint.clear_access_channels(websocketpp::log::alevel::all);
 		_endpoint.clear_error_channels(websocketpp::log::elevel::all);
 
 		_endpoint.init_asio();
 		_endpoint.start_perpetual();
 
-		_thread = websocketpp::lib::make_shared<websocketpp::lib::thread>(&client::run, &_endpoint);
+		const size_t threads = std::max<size_t>(ioThreads, 1);
+		_threads.reserve(threads);
+		for (size_t i = 0; i < threads; ++i) {
+			_threads.emplace_back(&client::run, &_endpoint);
+		}
 	}
 
 	WebsocketEndpoint::~WebsocketEndpoint() {
 		_endpoint.stop_perpetual();
 
-		for (ConnectionList::const_iterator it = _connectionList.begin(); it != _connectionList.end(); ++it) {
-			if (it->second->getStatus() != "Open") {
-				// Only close open connections
-				continue;
+		for (auto& shard : _shards) {
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			for (const auto& pair : shard.connections) {
+				if (pair.second->getStatus() != "Open") {
+					// Only close open connections
+					continue;
+				}
+
+				DLOG("> Closing connection {}", pair.second->getId());
+
+				websocketpp::lib::error_code ec;
+				_endpoint.close(pair.second->getHdl(), websocketpp::close::status::going_away, "", ec);
+				if (ec) {
+					DLOG("> Error closing connection {}: {}", pair.second->getId(), ec.message());
+				}
 			}
+		}
 
-			DLOG("> Closing connection {}", it->second->getId());
-
-			websocketpp::lib::error_code ec;
-			_endpoint.close(it->second->getHdl(), websocketpp::close::status::going_away, "", ec);
-			if (ec) {
-				DLOG("> Error closing connection {}: {}", it->second->getId(), ec.message());
+		for (auto& thread : _threads) {
+			if (thread.joinable()) {
+				thread.join();
 			}
 		}
+	}
 
-		if (_thread->joinable()) {
-			_thread->join();
-		}
+	WebsocketEndpoint::Shard& WebsocketEndpoint::shardOf(int id) const {
+		return _shards[static_cast<size_t>(id) % kShards];
+	}
+
+	ConnectionMetadata::ptr WebsocketEndpoint::find(int id) const {
+		Shard& shard = shardOf(id);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		auto it = shard.connections.find(id);
+		return it != shard.connections.end() ? it->second : ConnectionMetadata::ptr();
+	}
+
+	void WebsocketEndpoint::remove(int id) {
+		Shard& shard = shardOf(id);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		shard.connections.erase(id);
 	}
 
-	int WebsocketEndpoint::connect(std::string const& uri, std::shared_ptr<IConnectionListener> listener, const std::string& subprotocol) {
+	int WebsocketEndpoint::connect(std::string const& uri, std::shared_ptr<IConnectionListener> listener, const std::string& subprotocol, long pongTimeoutMs) {
 		websocketpp::lib::error_code ec;
 
 		client::connection_ptr con = _endpoint.get_connection(uri, ec); 
@@ -63,9 +89,18 @@ namespace vi {
 			}
 		}
 
+		if (pongTimeoutMs > 0) {
+			con->set_pong_timeout(pongTimeoutMs);
+			con->set_close_handshake_timeout(pongTimeoutMs);
+		}
+
 		int newId = _nextId++;
 		ConnectionMetadata::ptr metadataPtr = websocketpp::lib::make_shared<ConnectionMetadata>(newId, con->get_handle(), uri, listener);
-		_connectionList[newId] = metadataPtr;
+		{
+			Shard& shard = shardOf(newId);
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			shard.connections[newId] = metadataPtr;
+		}
 
 		con->set_open_handler(websocketpp::lib::bind(
 			&ConnectionMetadata::onOpen,
@@ -73,18 +108,15 @@ namespace vi {
 			&_endpoint,
 			websocketpp::lib::placeholders::_1
 		));
-		con->set_fail_handler(websocketpp::lib::bind(
-			&ConnectionMetadata::onFail,
-			metadataPtr,
-			&_endpoint,
-			websocketpp::lib::placeholders::_1
-		));
-		con->set_close_handler(websocketpp::lib::bind(
-			&ConnectionMetadata::onClose,
-			metadataPtr,
-			&_endpoint,
-			websocketpp::lib::placeholders::_1
-		));
+		// nothing follows a failure or a close, the entry and its message pool go with them
+		con->set_fail_handler([this, metadataPtr](websocketpp::connection_hdl hdl) {
+			metadataPtr->onFail(&_endpoint, hdl);
+			remove(metadataPtr->getId());
+		});
+		con->set_close_handler([this, metadataPtr](websocketpp::connection_hdl hdl) {
+			metadataPtr->onClose(&_endpoint, hdl);
+			remove(metadataPtr->getId());
+		});
 		con->set_message_handler(websocketpp::lib::bind(
 			&ConnectionMetadata::onMessage,
 			metadataPtr,
@@ -125,47 +157,63 @@ namespace vi {
 	void WebsocketEndpoint::close(int id, websocketpp::close::status::value code, const std::string& reason) {
 		websocketpp::lib::error_code ec;
 
-		ConnectionList::iterator metadataIt = _connectionList.find(id);
-		if (metadataIt == _connectionList.end()) {
+		ConnectionMetadata::ptr metadata = find(id);
+		if (!metadata) {
 			ELOG("> No connection found with id: {}", id);
 			return;
 		}
 
-		_endpoint.close(metadataIt->second->getHdl(), code, reason, ec);
+		_endpoint.close(metadata->getHdl(), code, reason, ec);
 		if (ec) {
 			ELOG("> Error initiating close: {}", ec.message());
 		}
 	}
 
 	void WebsocketEndpoint::sendText(int id, const std::string& data) {
-		websocketpp::lib::error_code ec;
-
-		ConnectionList::iterator metadataIt = _connectionList.find(id);
-		if (metadataIt == _connectionList.end()) {
-			ELOG("> No connection found with id: {}", id);
-			return;
+		if (client::message_ptr msg = acquireMessage(id, websocketpp::frame::opcode::text)) {
+			msg->get_raw_payload().assign(data);
+			send(id, msg);
 		}
+	}
 
-		_endpoint.send(metadataIt->second->getHdl(), data, websocketpp::frame::opcode::text, ec);
-		if (ec) {
-			ELOG("> Error sending text message: {}", ec.message());
-			return;
+	void WebsocketEndpoint::sendText(int id, const std::function<void(std::string&)>& writer) {
+		if (client::message_ptr msg = acquireMessage(id, websocketpp::frame::opcode::text)) {
+			writer(msg->get_raw_payload());
+			DLOG("sendText: {}", msg->get_payload().c_str());
+			send(id, msg);
 		}
 	}
 
 	void WebsocketEndpoint::sendBinary(int id, const std::vector<uint8_t>& data)
 	{
+		if (client::message_ptr msg = acquireMessage(id, websocketpp::frame::opcode::binary)) {
+			msg->get_raw_payload().assign(data.begin(), data.end());
+			send(id, msg);
+		}
+	}
+
+	client::message_ptr WebsocketEndpoint::acquireMessage(int id, websocketpp::frame::opcode::value op) {
+		ConnectionMetadata::ptr metadata = find(id);
+		if (!metadata) {
+			ELOG("> No connection found with id: {}", id);
+			return client::message_ptr();
+		}
+
+		return metadata->acquireMessage(op);
+	}
+
+	void WebsocketEndpoint::send(int id, client::message_ptr msg) {
 		websocketpp::lib::error_code ec;
 
-		ConnectionList::iterator metadataIt = _connectionList.find(id);
-		if (metadataIt == _connectionList.end()) {
+		ConnectionMetadata::ptr metadata = find(id);
+		if (!metadata) {
 			ELOG("> No connection found with id: {}", id);
 			return;
 		}
 
-		_endpoint.send(metadataIt->second->getHdl(), data.data(), data.size(), websocketpp::frame::opcode::binary, ec);
+		_endpoint.send(metadata->getHdl(), msg, ec);
 		if (ec) {
-			ELOG("> Error sending binary message: {}", ec.message());
+			ELOG("> Error sending message: {}", ec.message());
 			return;
 		}
 	}
@@ -173,13 +221,13 @@ namespace vi {
 	void WebsocketEndpoint::sendPing(int id, const std::string& data) {
 		websocketpp::lib::error_code ec;
 
-		ConnectionList::iterator metadataIt = _connectionList.find(id);
-		if (metadataIt == _connectionList.end()) {
+		ConnectionMetadata::ptr metadata = find(id);
+		if (!metadata) {
 			ELOG("> No connection found with id: {}", id);
 			return;
 		}
 
-		_endpoint.send(metadataIt->second->getHdl(), data, websocketpp::frame::opcode::ping, ec);
+		_endpoint.ping(metadata->getHdl(), data, ec);
 		if (ec) {
 			ELOG("> Error sending ping message: {}", ec.message());
 			return;
@@ -189,13 +237,13 @@ namespace vi {
 	void WebsocketEndpoint::sendPong(int id, const std::string& data) {
 		websocketpp::lib::error_code ec;
 
-		ConnectionList::iterator metadataIt = _connectionList.find(id);
-		if (metadataIt == _connectionList.end()) {
+		ConnectionMetadata::ptr metadata = find(id);
+		if (!metadata) {
 			ELOG("> No connection found with id: {}", id);
 			return;
 		}
 
-		_endpoint.send(metadataIt->second->getHdl(), data, websocketpp::frame::opcode::pong, ec);
+		_endpoint.send(metadata->getHdl(), data, websocketpp::frame::opcode::pong, ec);
 		if (ec) {
 			ELOG("> Error sending pong message: {}", ec.message());
 			return;
@@ -203,12 +251,15 @@ namespace vi {
 	}
 
 	ConnectionMetadata::ptr WebsocketEndpoint::getMetadata(int id) const {
-		ConnectionList::const_iterator metadataIt = _connectionList.find(id);
-		if (metadataIt == _connectionList.end()) {
-			return ConnectionMetadata::ptr();
-		}
-		else {
-			return metadataIt->second;
+		return find(id);
+	}
+
+	size_t WebsocketEndpoint::connections() const {
+		size_t count = 0;
+		for (const auto& shard : _shards) {
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			count += shard.connections.size();
 		}
+		return count;
 	}
 }
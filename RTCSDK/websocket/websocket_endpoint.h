@@ -7,6 +7,7 @@
 #pragma once
 
 #include "connection_metadata.h"
+#include "i_connection_endpoint.h"
 #include <websocketpp/config/asio_no_tls_client.hpp>
 //#include <websocketpp/config/asio_client.hpp>
 #include <websocketpp/client.hpp>
@@ -14,36 +15,72 @@
 #include <websocketpp/common/memory.hpp>
 #include <string>
 #include <vector>
+#include <array>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
 
 namespace vi {
-	class WebsocketEndpoint {
+	// Every method may be called from any thread. The asio loop runs on a pool of |ioThreads| threads,
+	// websocketpp runs the handlers and writes of a connection on that connection's strand, so one
+	// connection is never served by two threads at once while several connections spread over the pool.
+	class WebsocketEndpoint : public IConnectionEndpoint {
 	public:
-		WebsocketEndpoint();
+		explicit WebsocketEndpoint(size_t ioThreads = 1);
 
-		~WebsocketEndpoint();
+		~WebsocketEndpoint() override;
 
-		int connect(std::string const& uri, std::shared_ptr<IConnectionListener> listener, const std::string& subprotocol = "");
+		// |pongTimeoutMs| bounds the wait for the pong of sendPing() and for the closing handshake, 0 keeps the library defaults
+		int connect(std::string const& uri, std::shared_ptr<IConnectionListener> listener, const std::string& subprotocol = "", long pongTimeoutMs = 0) override;
 
-		void close(int id, websocketpp::close::status::value code, const std::string& reason);
+		void close(int id, websocketpp::close::status::value code, const std::string& reason) override;
 
-		void sendText(int id, const std::string& data);
+		void sendText(int id, const std::string& data) override;
 
-		void sendBinary(int id, const std::vector<uint8_t>& data);
+		// Writes straight into a message of the connection's freelist
+		void sendText(int id, const std::function<void(std::string&)>& writer) override;
 
-		void sendPing(int id, const std::string& data);
+		// An empty message from the connection's buffer freelist, fill its raw payload and hand it to send()
+		client::message_ptr acquireMessage(int id, websocketpp::frame::opcode::value op);
+
+		void send(int id, client::message_ptr msg);
+
+		void sendBinary(int id, const std::vector<uint8_t>& data) override;
+
+		// Arms the pong timer of the connection, onPongTimeout() is raised if no pong comes back in time
+		void sendPing(int id, const std::string& data) override;
 
 		void sendPong(int id, const std::string& data);
 
 		ConnectionMetadata::ptr getMetadata(int id) const;
 
+		// Connections neither closed nor failed yet
+		size_t connections() const;
+
 	private:
-		typedef std::map<int, ConnectionMetadata::ptr> ConnectionList;
+		static constexpr size_t kShards = 16;
+
+		// the connection table is sharded by id, lookups of different connections do not contend
+		struct Shard {
+			mutable std::mutex mutex;
+
+			std::unordered_map<int, ConnectionMetadata::ptr> connections;
+		};
+
+		Shard& shardOf(int id) const;
+
+		ConnectionMetadata::ptr find(int id) const;
+
+		void remove(int id);
 
 		client _endpoint;
-		websocketpp::lib::shared_ptr<websocketpp::lib::thread> _thread;
 
-		ConnectionList _connectionList;
-		int _nextId;
+		std::vector<std::thread> _threads;
+
+		mutable std::array<Shard, kShards> _shards;
+
+		std::atomic<int> _nextId{ 0 };
 	};
 }
 
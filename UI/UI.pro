@@ -37,6 +37,9 @@ FORMS += \
 
 HEADERS += \
     create_room_dialog.h \
+    frame_clock.h \
+    frame_mailbox.h \
+    gallery_compositor.h \
     gallery_view.h \
     gl_defines.h \
     gl_video_renderer.h \
@@ -44,11 +47,18 @@ HEADERS += \
     i420_texture_cache.h \
     janus_connection_dialog.h \
     join_room_dialog.h \
+    nv12_texture_cache.h \
     participant_item_view.h \
     participants_list_view.h \
-    ui.h
+    pbo_upload_ring.h \
+    ui.h \
+    upload_meter.h \
+    video_tile.h
 SOURCES += \
     create_room_dialog.cpp \
+    frame_clock.cpp \
+    frame_mailbox.cpp \
+    gallery_compositor.cpp \
     gallery_view.cpp \
     gl_video_renderer.cpp \
     gl_video_shader.cpp \
@@ -56,9 +66,13 @@ SOURCES += \
     janus_connection_dialog.cpp \
     join_room_dialog.cpp \
     main_qt.cpp \
+    nv12_texture_cache.cpp \
     participant_item_view.cpp \
     participants_list_view.cpp \
-    ui.cpp
+    pbo_upload_ring.cpp \
+    ui.cpp \
+    upload_meter.cpp \
+    video_tile.cpp
 
 RESOURCES += \
     ui.qrc
@@ -0,0 +1,55 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "frame_clock.h"
+#include <QTimer>
+#include <QScreen>
+#include <QGuiApplication>
+
+FrameClock* FrameClock::instance()
+{
+	static FrameClock* clock = new FrameClock(qApp);
+	return clock;
+}
+
+FrameClock::FrameClock(QObject* parent)
+	: QObject(parent)
+	, _armed(false)
+{
+	_timer = new QTimer(this);
+	_timer->setSingleShot(true);
+	_timer->setTimerType(Qt::PreciseTimer);
+	connect(_timer, SIGNAL(timeout()), this, SLOT(onTimeout()));
+}
+
+void FrameClock::requestFrame()
+{
+	if (!_armed.exchange(true, std::memory_order_acq_rel)) {
+		QMetaObject::invokeMethod(this, "arm", Qt::QueuedConnection);
+	}
+}
+
+void FrameClock::arm()
+{
+	if (!_timer->isActive()) {
+		_timer->start(refreshInterval());
+	}
+}
+
+void FrameClock::onTimeout()
+{
+	// frames posted from now on need another tick
+	_armed.store(false, std::memory_order_release);
+
+	emit tick();
+}
+
+int FrameClock::refreshInterval() const
+{
+	const QScreen* screen = QGuiApplication::primaryScreen();
+	const qreal rate = screen ? screen->refreshRate() : 0;
+	return rate >= 1 ? static_cast<int>(1000 / rate) : 16;
+}
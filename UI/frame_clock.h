@@ -0,0 +1,46 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <QObject>
+#include <atomic>
+
+class QTimer;
+
+// One clock for every video tile. It only runs while some renderer has a frame waiting: a renderer
+// calls requestFrame() from its decoder thread, the first request after a tick arms a single shot
+// timer on the GUI thread, and tick() fires once per display refresh interval at most. Renderers
+// without a new frame ignore the tick, so frozen or muted streams cost nothing.
+class FrameClock : public QObject
+{
+	Q_OBJECT
+
+public:
+	// Must be called on the GUI thread first, the clock lives there
+	static FrameClock* instance();
+
+	// Thread safe, coalesces any number of requests into the next tick
+	void requestFrame();
+
+signals:
+	void tick();
+
+private slots:
+	void arm();
+
+	void onTimeout();
+
+private:
+	explicit FrameClock(QObject* parent);
+
+	int refreshInterval() const;
+
+private:
+	QTimer* _timer;
+
+	std::atomic_bool _armed;
+};
@@ -0,0 +1,82 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "frame_mailbox.h"
+
+FrameMailbox::FrameMailbox()
+	: _middle(1)
+	, _dropped(0)
+	, _presented(0)
+{
+
+}
+
+void FrameMailbox::post(const webrtc::VideoFrame& frame)
+{
+	_slots[_back] = frame;
+
+	uint32_t previous = _middle.load(std::memory_order_relaxed);
+	uint32_t next;
+	do {
+		// a dropped frame poisons every frame up to the next take, its update_rect is lost
+		next = _back | kFresh | ((previous & kFresh) ? kDropped : 0);
+	} while (!_middle.compare_exchange_weak(previous, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+	_back = previous & kIndexMask;
+
+	if (previous & kFresh) {
+		// superseded before the consumer saw it, give its buffer back to the decoder now
+		_slots[_back].reset();
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+bool FrameMailbox::take()
+{
+	if (!(_middle.load(std::memory_order_relaxed) & kFresh)) {
+		return false;
+	}
+
+	// only the consumer clears kFresh, so a newer frame is guaranteed and the shown one can go now
+	_slots[_front].reset();
+
+	const uint32_t previous = _middle.exchange(_front, std::memory_order_acq_rel);
+	_front = previous & kIndexMask;
+	_contiguous = (previous & kDropped) == 0;
+	_presented.fetch_add(1, std::memory_order_relaxed);
+
+	return true;
+}
+
+bool FrameMailbox::contiguous() const
+{
+	return _contiguous;
+}
+
+bool FrameMailbox::pending() const
+{
+	return (_middle.load(std::memory_order_acquire) & kFresh) != 0;
+}
+
+const absl::optional<webrtc::VideoFrame>& FrameMailbox::front() const
+{
+	return _slots[_front];
+}
+
+void FrameMailbox::clear()
+{
+	_slots[_front].reset();
+	_contiguous = false;
+}
+
+uint64_t FrameMailbox::droppedFrames() const
+{
+	return _dropped.load(std::memory_order_relaxed);
+}
+
+uint64_t FrameMailbox::presentedFrames() const
+{
+	return _presented.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,76 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include "absl/types/optional.h"
+#include "api/video/video_frame.h"
+
+// Latest-frame-wins hand-off between the decoder thread (post) and the GL thread (take/front).
+// Three slots rotate through an atomic index: the producer fills its back slot and swaps it into the
+// middle, the consumer swaps the middle into its front slot when it holds a newer frame. A frame the
+// consumer never got to is released right away and counted as dropped; neither side blocks or allocates,
+// copying a webrtc::VideoFrame only takes a reference on its buffer.
+class FrameMailbox
+{
+public:
+	FrameMailbox();
+
+	// producer side
+	void post(const webrtc::VideoFrame& frame);
+
+	// consumer side, moves the newest frame to front(), false if nothing new arrived since the last call
+	bool take();
+
+	// consumer side, false if frames were dropped between the last two successful take(),
+	// an update_rect of front() is only meaningful relative to the previous frame when this is true
+	bool contiguous() const;
+
+	// consumer side, true if take() would return a newer frame
+	bool pending() const;
+
+	// consumer side, the frame returned by the last successful take()
+	const absl::optional<webrtc::VideoFrame>& front() const;
+
+	// consumer side, releases the frame being displayed
+	void clear();
+
+	uint64_t droppedFrames() const;
+
+	uint64_t presentedFrames() const;
+
+private:
+	FrameMailbox(const FrameMailbox&) = delete;
+
+	FrameMailbox& operator=(const FrameMailbox&) = delete;
+
+private:
+	static constexpr uint32_t kFresh = 0x4;
+
+	// set along with kFresh when the fresh frame replaced another fresh frame
+	static constexpr uint32_t kDropped = 0x8;
+
+	static constexpr uint32_t kIndexMask = 0x3;
+
+	absl::optional<webrtc::VideoFrame> _slots[3];
+
+	// owned by the producer
+	uint32_t _back = 0;
+
+	// slot index shared by both sides, kFresh is set while it holds a frame the consumer has not taken yet
+	std::atomic<uint32_t> _middle;
+
+	// owned by the consumer
+	uint32_t _front = 2;
+
+	bool _contiguous = false;
+
+	std::atomic<uint64_t> _dropped;
+
+	std::atomic<uint64_t> _presented;
+};
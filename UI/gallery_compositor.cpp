@@ -0,0 +1,173 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "gallery_compositor.h"
+#include <cmath>
+#include <algorithm>
+#include "frame_clock.h"
+#include "gl_video_shader.h"
+#include "video_tile.h"
+
+GalleryCompositor::GalleryCompositor(QWidget* parent)
+	: QOpenGLWidget(parent)
+{
+	QSurfaceFormat format;
+	format.setVersion(3, 2);
+	format.setProfile(QSurfaceFormat::CoreProfile);
+	this->setFormat(format);
+
+	setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+
+	connect(FrameClock::instance(), SIGNAL(tick()), this, SLOT(onRendering()));
+}
+
+GalleryCompositor::~GalleryCompositor()
+{
+	cleanup();
+}
+
+void GalleryCompositor::setTiles(const std::vector<std::shared_ptr<VideoTile>>& tiles)
+{
+	std::vector<std::shared_ptr<VideoTile>> removed;
+	for (const auto& tile : _tiles) {
+		if (std::find(tiles.begin(), tiles.end(), tile) == tiles.end()) {
+			removed.emplace_back(tile);
+		}
+	}
+
+	if (!removed.empty() && context()) {
+		makeCurrent();
+		for (const auto& tile : removed) {
+			tile->releaseTextures();
+		}
+		doneCurrent();
+	}
+
+	_tiles = tiles;
+
+	reportTileSizes();
+
+	update();
+}
+
+void GalleryCompositor::initializeGL()
+{
+	connect(context(), &QOpenGLContext::aboutToBeDestroyed, this, &GalleryCompositor::cleanup);
+
+	initializeOpenGLFunctions();
+
+	glewInit();
+
+	_videoShader = std::make_shared<GLVideoShader>();
+
+	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+void GalleryCompositor::resizeGL(int w, int h)
+{
+	reportTileSizes();
+}
+
+void GalleryCompositor::paintGL()
+{
+	const int canvasW = static_cast<int>(width() * devicePixelRatio());
+	const int canvasH = static_cast<int>(height() * devicePixelRatio());
+
+	glViewport(0, 0, canvasW, canvasH);
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	if (_tiles.empty()) {
+		return;
+	}
+
+	const int count = static_cast<int>(_tiles.size());
+	const int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+	const int rows = (count + columns - 1) / columns;
+	const QSize cell = cellSize();
+
+	for (int i = 0; i < count; ++i) {
+		const int r = i / columns;
+		const int c = i % columns;
+		// GL counts rows from the bottom
+		_tiles[i]->paint(_videoShader.get(), c * cell.width(), (rows - 1 - r) * cell.height(), cell.width(), cell.height());
+	}
+}
+
+void GalleryCompositor::showEvent(QShowEvent* event)
+{
+	QOpenGLWidget::showEvent(event);
+
+	reportTileSizes();
+}
+
+void GalleryCompositor::hideEvent(QHideEvent* event)
+{
+	QOpenGLWidget::hideEvent(event);
+
+	reportTileSizes();
+}
+
+QSize GalleryCompositor::cellSize() const
+{
+	if (_tiles.empty()) {
+		return QSize();
+	}
+
+	const int count = static_cast<int>(_tiles.size());
+	const int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+	const int rows = (count + columns - 1) / columns;
+
+	const int canvasW = static_cast<int>(width() * devicePixelRatio());
+	const int canvasH = static_cast<int>(height() * devicePixelRatio());
+
+	return QSize(canvasW / columns, canvasH / rows);
+}
+
+void GalleryCompositor::reportTileSizes()
+{
+	const QSize cell = cellSize();
+	// a minimized window keeps its widgets "visible" but gets spontaneous hide events
+	const bool visible = isVisible() && !window()->isMinimized() && !cell.isEmpty();
+
+	std::map<int64_t, ReportedSize> reported;
+	for (const auto& tile : _tiles) {
+		ReportedSize& current = reported[tile->id()];
+		current.size = cell;
+		current.visible = visible;
+
+		auto it = _reportedSizes.find(tile->id());
+		if (it == _reportedSizes.end() || it->second.size != cell || it->second.visible != visible) {
+			emit tileSizeChanged(tile->id(), cell.width(), cell.height(), visible);
+		}
+	}
+	_reportedSizes.swap(reported);
+}
+
+void GalleryCompositor::onRendering()
+{
+	const bool pending = std::any_of(_tiles.begin(), _tiles.end(), [](const auto& tile) {
+		return tile->pending();
+	});
+	if (pending) {
+		QWidget::update();
+	}
+}
+
+void GalleryCompositor::cleanup()
+{
+	if (!context()) {
+		return;
+	}
+
+	makeCurrent();
+
+	for (const auto& tile : _tiles) {
+		tile->releaseTextures();
+	}
+	_videoShader = nullptr;
+
+	doneCurrent();
+}
@@ -0,0 +1,73 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <map>
+#include "gl_defines.h"
+#include <QOpenGLWidget>
+#include <QOpenGLFunctions>
+
+class GLVideoShader;
+class VideoTile;
+
+// Draws every tile of the gallery in one GL context and one pass: the tiles share the shader program and
+// vertex array, each one is a viewport of the grid. Repaints only when at least one tile got a new frame.
+class GalleryCompositor
+	: public QOpenGLWidget
+	, public QOpenGLFunctions
+{
+	Q_OBJECT
+
+public:
+	GalleryCompositor(QWidget* parent);
+
+	~GalleryCompositor();
+
+	// Tiles in display order, row by row
+	void setTiles(const std::vector<std::shared_ptr<VideoTile>>& tiles);
+
+signals:
+	// Cell size of a tile in device pixels, emitted when the layout or the visibility changes.
+	// Tiles are not visible while the compositor is hidden or its window minimized
+	void tileSizeChanged(qint64 id, int width, int height, bool visible);
+
+protected:
+	void initializeGL() override;
+
+	void resizeGL(int w, int h) override;
+
+	void paintGL() override;
+
+	void showEvent(QShowEvent* event) override;
+
+	void hideEvent(QHideEvent* event) override;
+
+private slots:
+	void cleanup();
+
+	void onRendering();
+
+private:
+	QSize cellSize() const;
+
+	void reportTileSizes();
+
+private:
+	std::shared_ptr<GLVideoShader> _videoShader;
+
+	std::vector<std::shared_ptr<VideoTile>> _tiles;
+
+	struct ReportedSize {
+		QSize size;
+		bool visible = false;
+	};
+
+	// last reported size per tile id
+	std::map<int64_t, ReportedSize> _reportedSizes;
+};
@@ -7,7 +7,7 @@
 #include "gallery_view.h"
 #include "ui_gallery_view.h"
 #include <QGridLayout>
-#include "gl_video_renderer.h"
+#include "gallery_compositor.h"
 
 GalleryView::GalleryView(QWidget *parent) :
     QFrame(parent),
@@ -31,7 +31,13 @@ void GalleryView::init()
 
     this->setLayout(_gridLayout);
 
-    _gridLayout->setAlignment(Qt::AlignCenter);
+    _gridLayout->setContentsMargins(0, 0, 0, 0);
+
+    _compositor = new GalleryCompositor(this);
+
+    _gridLayout->addWidget(_compositor, 0, 0);
+
+    connect(_compositor, &GalleryCompositor::tileSizeChanged, this, &GalleryView::tileSizeChanged);
 }
 
 void GalleryView::insertView(std::shared_ptr<ContentView> view)
@@ -57,13 +63,13 @@ void GalleryView::removeView(int64_t id)
     }
 }
 
-QWidget* GalleryView::getView(int64_t id)
+std::shared_ptr<VideoTile> GalleryView::getTile(int64_t id)
 {
     auto it = std::find_if(_views.begin(), _views.end(), [id](const auto& e) {
        return id == e->id();
     });
     if (it != _views.end()) {
-        return (*it)->view();
+        return (*it)->tile();
     }
     return nullptr;
 }
@@ -95,33 +101,14 @@ void GalleryView::permute(Strategy strategy)
 
 void GalleryView::permuteViews()
 {
-    QLayoutItem* child = nullptr;
-    while ((child = _gridLayout->takeAt(0)) != nullptr) {
-        _gridLayout->removeWidget(child->widget());
-        if (child->widget()) {
-            child->widget()->setParent(nullptr);
-        }
-        delete child;
-    }
-
-    if (_views.empty()) {
-        return;
-    }
-
     permute();
 
-    uint32_t size = static_cast<uint32_t>(_views.size());
-    int column = static_cast<int>(std::ceil(std::sqrtf(size)));
-    int row =  static_cast<int>(std::ceil(double(size)/double(column)));
-
-    for (int r = 0; r < row; ++r) {
-        for (int c = 0; c < column; ++c) {
-            uint32_t index = static_cast<uint32_t>(r * column + c);
-            if (index < size) {
-                _views[index]->view()->setParent(this);
-                _gridLayout->addWidget(_views[index]->view(), r, c);
-            }
-        }
+    std::vector<std::shared_ptr<VideoTile>> tiles;
+    tiles.reserve(_views.size());
+    for (const auto& view : _views) {
+        tiles.emplace_back(view->tile());
     }
 
+    // the compositor lays the tiles out row by row, in this order
+    _compositor->setTiles(tiles);
 }
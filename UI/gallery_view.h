@@ -11,13 +11,14 @@
 #include <vector>
 #include <algorithm>
 #include "api/media_stream_interface.h"
-#include "gl_video_renderer.h"
+#include "video_tile.h"
 
 namespace Ui {
 class GalleryView;
 }
 
 class QGridLayout;
+class GalleryCompositor;
 
 namespace webrtc {
 	class VideoTrackInterface;
@@ -29,30 +30,30 @@ public:
 	virtual bool init() = 0;
 	virtual void cleanup() = 0;
 	virtual int64_t id() = 0;
-	virtual QWidget* view() = 0;
+	virtual std::shared_ptr<VideoTile> tile() = 0;
 };
 
 class ContentView : public IContentView {
 
 public:
-	ContentView(int64_t id, rtc::scoped_refptr<webrtc::VideoTrackInterface> track, GLVideoRenderer* renderer)
+	ContentView(int64_t id, rtc::scoped_refptr<webrtc::VideoTrackInterface> track, std::shared_ptr<VideoTile> tile)
 	: _id(id)
 	, _track(track)
-	, _renderer(renderer) {
+	, _tile(tile) {
 
 	}
 	bool init() override {
-		if (_renderer && _track) {
+		if (_tile && _track) {
 			rtc::VideoSinkWants wants;
-			_track->AddOrUpdateSink(_renderer, wants);
+			_track->AddOrUpdateSink(_tile.get(), wants);
 			return true;
 		}
 		return false;
 	}
 
 	void cleanup() override {
-		if (_renderer && _track) {
-			_track->RemoveSink(_renderer);
+		if (_tile && _track) {
+			_track->RemoveSink(_tile.get());
 		}
 	}
 
@@ -60,8 +61,8 @@ public:
 		return _id;
 	}
 
-	QWidget* view() override {
-		return static_cast<QWidget*>(_renderer);
+	std::shared_ptr<VideoTile> tile() override {
+		return _tile;
 	}
 
 private:
@@ -69,7 +70,7 @@ private:
 
 	rtc::scoped_refptr<webrtc::VideoTrackInterface> _track;
 
-	GLVideoRenderer* _renderer = nullptr;
+	std::shared_ptr<VideoTile> _tile;
 };
 
 class PermuteStrategy {
@@ -108,10 +109,14 @@ public:
 
     void removeView(int64_t id);
 
-    QWidget* getView(int64_t id);
+    std::shared_ptr<VideoTile> getTile(int64_t id);
 
     void removeAll();
 
+signals:
+    // Forwarded from the compositor, see GalleryCompositor::tileSizeChanged
+    void tileSizeChanged(qint64 id, int width, int height, bool visible);
+
 protected:
     void init();
 
@@ -126,6 +131,9 @@ private:
 
     QGridLayout* _gridLayout;
 
+    // draws all tiles in one GL context
+    GalleryCompositor* _compositor;
+
     std::vector<std::shared_ptr<IContentView>> _views;
 };
 
@@ -7,9 +7,12 @@
 #include "gl_video_renderer.h"
 #include <thread>
 #include <array>
-#include <QTimer>
+#include "frame_clock.h"
 #include "gl_video_shader.h"
 #include "i420_texture_cache.h"
+#include "nv12_texture_cache.h"
+#include "pbo_upload_ring.h"
+#include "rtc_base/time_utils.h"
 #include "logger/logger.h"
 #include "absl/types/optional.h"
 #include "api/video/video_rotation.h"
@@ -26,9 +29,7 @@ GLVideoRenderer::GLVideoRenderer(QWidget *parent)
 	format.setProfile(QSurfaceFormat::CoreProfile);
 	this->setFormat(format);
 
-	_renderingTimer = new QTimer(this);
-	connect(_renderingTimer, SIGNAL(timeout()), this, SLOT(onRendering()));
-	_renderingTimer->start(30);
+	connect(FrameClock::instance(), SIGNAL(tick()), this, SLOT(onRendering()));
 }
 
 GLVideoRenderer::~GLVideoRenderer()
@@ -58,6 +59,9 @@ void GLVideoRenderer::initializeGL()
 	_i420TextureCache = std::make_shared<I420TextureCache>();
 	_i420TextureCache->init();
 
+	_nv12TextureCache = std::make_shared<NV12TextureCache>();
+	_nv12TextureCache->init();
+
 	_videoShader = std::make_shared<GLVideoShader>();
 
 	// Set up the rendering context, load shaders and other resources, etc.:
@@ -78,9 +82,13 @@ void GLVideoRenderer::resizeGL(int w, int h)
 
 void GLVideoRenderer::paintGL()
 {
-	if (_cacheFrame) {
+	_mailbox.take();
+
+	const absl::optional<webrtc::VideoFrame>& frame = _mailbox.front();
 
-		float imageRatio = (float)_cacheFrame->width() / (float)_cacheFrame->height();
+	if (frame) {
+
+		float imageRatio = (float)frame->width() / (float)frame->height();
 		float canvasRatio = (float)width() / (float)height();
 
 		int32_t viewportX = 0;
@@ -107,54 +115,88 @@ void GLVideoRenderer::paintGL()
 
 	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
-	std::shared_ptr<webrtc::VideoFrame> frame;
+	if (frame) {
+		const bool nv12 = frame->video_frame_buffer()->type() == webrtc::VideoFrameBuffer::Type::kNV12;
 
-	if (_frameQ.try_dequeue(frame)) {
-		_cacheFrame = frame;
-	}
-	else {
-		//DLOG("try dequeue failed.");
-	}
+		// an update rect is relative to the previous frame, which then has to be in the same cache
+		const bool incremental = _mailbox.contiguous() && nv12 == _nv12Frames;
+		_nv12Frames = nv12;
+
+		// a repaint without a new frame finds the frame in the cache already and uploads nothing
+		const int64_t start = rtc::TimeMicros();
+		I420TextureCache::Upload upload = I420TextureCache::Upload::SKIPPED;
+		if (nv12) {
+			if (_nv12TextureCache->uploadFrameToTextures(*frame, incremental)) {
+				upload = I420TextureCache::Upload::CLIENT_MEMORY;
+			}
+		}
+		else {
+			PboUploadRing* ring = _uploadStager.ring(frame->width(), frame->height());
+			upload = _i420TextureCache->uploadFrameToTextures(*frame, incremental, ring);
+		}
+		if (upload != I420TextureCache::Upload::SKIPPED) {
+			_uploadMeter.record(rtc::TimeMicros() - start, upload == I420TextureCache::Upload::PIXEL_BUFFER);
+		}
 
-	if (_cacheFrame) {
-		_i420TextureCache->uploadFrameToTextures(*_cacheFrame);
-		_videoShader->applyShadingForFrame(_cacheFrame->width(),
-			_cacheFrame->height(),
-			_cacheFrame->rotation(),
-			_i420TextureCache->yTexture(),
-			_i420TextureCache->uTexture(),
-			_i420TextureCache->vTexture());
+		if (nv12) {
+			_videoShader->applyShadingForFrame(frame->width(),
+				frame->height(),
+				frame->rotation(),
+				_nv12TextureCache->yTexture(),
+				_nv12TextureCache->uvTexture());
+		}
+		else {
+			_videoShader->applyShadingForFrame(frame->width(),
+				frame->height(),
+				frame->rotation(),
+				_i420TextureCache->yTexture(),
+				_i420TextureCache->uTexture(),
+				_i420TextureCache->vTexture());
+		}
 	}
 }
 
 void GLVideoRenderer::OnFrame(const webrtc::VideoFrame& frame)
 {
-	auto videeoFrame = std::make_shared<webrtc::VideoFrame>(frame);
+	// copy the planes into a pixel buffer here, on the delivery thread, so paintGL only issues the transfer
+	_uploadStager.stage(frame);
 
-	if (_frameQ.size_approx() >= 300) {
-		for (int i = 0; i < 100; ++i) {
-			std::shared_ptr<webrtc::VideoFrame> dropFrame;
-			if (_frameQ.try_dequeue(dropFrame)) {
-				DLOG("drop frame .");
-			}
-		}
-	}
-	_frameQ.enqueue(videeoFrame);
-	//static int counter = 0;
-	//DLOG("--> frame: {}, ts: {}", ++counter, _frame->timestamp_us());
+	_mailbox.post(frame);
+
+	FrameClock::instance()->requestFrame();
+}
+
+uint64_t GLVideoRenderer::droppedFrames() const
+{
+	return _mailbox.droppedFrames();
+}
+
+uint64_t GLVideoRenderer::presentedFrames() const
+{
+	return _mailbox.presentedFrames();
+}
+
+UploadStats GLVideoRenderer::uploadStats() const
+{
+	return _uploadMeter.stats();
 }
 
 void GLVideoRenderer::onRendering()
 {
-	QWidget::update();
+	if (_mailbox.pending()) {
+		QWidget::update();
+	}
 }
 
 void GLVideoRenderer::cleanup()
 {
 	makeCurrent();
 
+	_uploadStager.release();
 	_i420TextureCache = nullptr;
+	_nv12TextureCache = nullptr;
 	_videoShader = nullptr;
+	_mailbox.clear();
 	
 	doneCurrent();
 }
\ No newline at end of file
@@ -10,15 +10,18 @@
 #include "gl_defines.h"
 #include "api/video/video_sink_interface.h"
 #include "api/video/video_frame.h"
-#include <QTimer>
 #include <mutex>
+#include <atomic>
+#include <vector>
 #include <QOpenGLWidget>
 #include <QOpenGLFunctions>
-#include "blockingconcurrentqueue.h"
+#include "frame_mailbox.h"
+#include "pbo_upload_ring.h"
+#include "upload_meter.h"
 
 class GLVideoShader;
 class I420TextureCache;
-class QTimer;
+class NV12TextureCache;
 
 class GLVideoRenderer 
 	: public QOpenGLWidget
@@ -35,6 +38,13 @@ public:
 
 	void init();
 
+	// frames replaced by a newer one before they could be painted
+	uint64_t droppedFrames() const;
+
+	uint64_t presentedFrames() const;
+
+	UploadStats uploadStats() const;
+
 protected:
 	void initializeGL() override;
 
@@ -54,9 +64,14 @@ private:
 
 	std::shared_ptr<I420TextureCache> _i420TextureCache;
 
-	std::shared_ptr<webrtc::VideoFrame> _cacheFrame;
+	std::shared_ptr<NV12TextureCache> _nv12TextureCache;
+
+	// whether the last painted frame went through the NV12 cache
+	bool _nv12Frames = false;
+
+	FrameMailbox _mailbox;
 
-	QTimer* _renderingTimer;
+	PboUploadStager _uploadStager;
 
-	moodycamel::BlockingConcurrentQueue<std::shared_ptr<webrtc::VideoFrame>> _frameQ;
+	UploadMeter _uploadMeter;
 };
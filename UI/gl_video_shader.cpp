@@ -60,7 +60,7 @@ FRAGMENT_SHADER_OUT
 "    mediump float y;\n"
 "    mediump vec2 uv;\n"
 "    y = " FRAGMENT_SHADER_TEXTURE "(s_textureY, v_texcoord).r;\n"
-"    uv = " FRAGMENT_SHADER_TEXTURE "(s_textureUV, v_texcoord).ra -\n"
+"    uv = " FRAGMENT_SHADER_TEXTURE "(s_textureUV, v_texcoord).rg -\n"
 "        vec2(0.5, 0.5);\n"
 "    " FRAGMENT_SHADER_COLOR " = vec4(y + 1.403 * uv.y,\n"
 "                                     y - 0.344 * uv.x - 0.714 * uv.y,\n"
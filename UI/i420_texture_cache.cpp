@@ -5,7 +5,9 @@
  **/
 
 #include "i420_texture_cache.h"
+#include <algorithm>
 #include "gl_defines.h"
+#include "pbo_upload_ring.h"
 
 I420TextureCache::I420TextureCache()
 {
@@ -21,6 +23,10 @@ void I420TextureCache::init()
 {
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
+	// Desktop GL always has GL_UNPACK_ROW_LENGTH, immutable storage needs GL 4.2 or the ARB extension
+	_hasUnpackRowLength = true;
+	_hasTextureStorage = GLEW_VERSION_4_2 || GLEW_ARB_texture_storage;
+
 	setupTextures();
 }
 
@@ -52,23 +58,57 @@ void I420TextureCache::setupTextures()
 	}
 }
 
-void I420TextureCache::uploadPlane(const uint8_t* plane, GLuint texture, size_t width, size_t height, int32_t stride) 
+void I420TextureCache::ensureStorage(GLint set, int width, int height)
+{
+	if (_setWidth[set] == width && _setHeight[set] == height) {
+		return;
+	}
+
+	GLuint* textures = &_textures[set * kNumTexturesPerSet];
+	if (_hasTextureStorage && _setWidth[set] != 0) {
+		// immutable storage can not be resized, start over with fresh texture objects
+		glDeleteTextures(kNumTexturesPerSet, textures);
+		glGenTextures(kNumTexturesPerSet, textures);
+	}
+
+	const int chromaWidth = (width + 1) / 2;
+	const int chromaHeight = (height + 1) / 2;
+	for (GLsizei i = 0; i < kNumTexturesPerSet; i++) {
+		const GLsizei w = i == 0 ? width : chromaWidth;
+		const GLsizei h = i == 0 ? height : chromaHeight;
+		glBindTexture(GL_TEXTURE_2D, textures[i]);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		if (_hasTextureStorage) {
+			glTexStorage2D(GL_TEXTURE_2D, 1, GL_R8, w, h);
+		}
+		else {
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, w, h, 0, RTC_PIXEL_FORMAT, GL_UNSIGNED_BYTE, nullptr);
+		}
+	}
+
+	_setWidth[set] = width;
+	_setHeight[set] = height;
+}
+
+void I420TextureCache::uploadPlane(const uint8_t* plane, GLuint texture, int x, int y, int width, int height, int32_t stride) 
 {
 	glBindTexture(GL_TEXTURE_2D, texture);
 
-	const uint8_t *uploadPlane = plane;
+	const uint8_t *uploadPlane = plane + static_cast<size_t>(y) * stride + x;
 
-	glPixelStorei(GL_UNPACK_ROW_LENGTH, stride);
-	if ((size_t)stride != width) {
+	if (stride != width) {
 		if (_hasUnpackRowLength) {
 			// GLES3 allows us to specify stride.
 			glPixelStorei(GL_UNPACK_ROW_LENGTH, stride);
-			glTexImage2D(GL_TEXTURE_2D,
+			glTexSubImage2D(GL_TEXTURE_2D,
 				0,
-				RTC_PIXEL_FORMAT,
+				x,
+				y,
 				static_cast<GLsizei>(width),
 				static_cast<GLsizei>(height),
-				0,
 				RTC_PIXEL_FORMAT,
 				GL_UNSIGNED_BYTE,
 				uploadPlane);
@@ -78,46 +118,99 @@ void I420TextureCache::uploadPlane(const uint8_t* plane, GLuint texture, size_t
 		else {
 			// Make an unpadded copy and upload that instead. Quick profiling showed
 			// that this is faster than uploading row by row using glTexSubImage2D.
+			_planeBuffer.resize(static_cast<size_t>(width) * height);
 			uint8_t *unpaddedPlane = _planeBuffer.data();
-			for (size_t y = 0; y < height; ++y) {
-				memcpy(unpaddedPlane + y * width, plane + y * stride, width);
+			for (int row = 0; row < height; ++row) {
+				memcpy(unpaddedPlane + static_cast<size_t>(row) * width, uploadPlane + static_cast<size_t>(row) * stride, width);
 			}
 			uploadPlane = unpaddedPlane;
 		}
 	}
-	glTexImage2D(GL_TEXTURE_2D,
+	glTexSubImage2D(GL_TEXTURE_2D,
 		0,
-		RTC_PIXEL_FORMAT,
+		x,
+		y,
 		static_cast<GLsizei>(width),
 		static_cast<GLsizei>(height),
-		0,
 		RTC_PIXEL_FORMAT,
 		GL_UNSIGNED_BYTE,
 		uploadPlane);
 }
 
-void I420TextureCache::uploadFrameToTextures(const webrtc::VideoFrame& frame) 
+bool I420TextureCache::isSameFrame(const webrtc::VideoFrame& frame) const
 {
-	_currentTextureSet = (_currentTextureSet + 1) % kNumTextureSets;
+	// the buffer pointer alone is not enough, decoders recycle their buffers through a pool
+	return _lastBuffer == frame.video_frame_buffer().get() &&
+		_lastTimestampUs == frame.timestamp_us() &&
+		_lastId == frame.id();
+}
 
+I420TextureCache::Upload I420TextureCache::uploadFrameToTextures(const webrtc::VideoFrame& frame, bool incremental, PboUploadRing* ring)
+{
 	rtc::scoped_refptr<webrtc::VideoFrameBuffer> vfb = frame.video_frame_buffer();
 	if (!vfb) {
-		return;
+		return Upload::SKIPPED;
 	}
 
-	rtc::scoped_refptr<webrtc::I420BufferInterface> buffer = vfb->ToI420();
+	if (ring) {
+		ring->reclaim();
+	}
+
+	if (isSameFrame(frame)) {
+		return Upload::SKIPPED;
+	}
+
+	const bool sameSize = _setWidth[_currentTextureSet] == frame.width() && _setHeight[_currentTextureSet] == frame.height();
+	const bool partial = incremental && sameSize && _lastBuffer && frame.has_update_rect();
 
-	const int chromaWidth = buffer->ChromaWidth();
-	const int chromaHeight = buffer->ChromaHeight();
-	if (buffer->StrideY() != frame.width() ||
-		buffer->StrideU() != chromaWidth ||
-		buffer->StrideV() != chromaWidth) {
-		_planeBuffer.resize(buffer->width() * buffer->height());
+	webrtc::VideoFrame::UpdateRect rect{ 0, 0, frame.width(), frame.height() };
+	if (partial) {
+		// the current set holds the previous frame, patch it in place
+		rect = frame.update_rect();
 	}
+	else {
+		_currentTextureSet = (_currentTextureSet + 1) % kNumTextureSets;
+		ensureStorage(_currentTextureSet, frame.width(), frame.height());
+	}
+
+	_lastBuffer = vfb.get();
+	_lastTimestampUs = frame.timestamp_us();
+	_lastId = frame.id();
+
+	// chroma planes are subsampled by two, widen the rect to whole chroma samples
+	const int chromaWidth = (frame.width() + 1) / 2;
+	const int chromaHeight = (frame.height() + 1) / 2;
+	const int cx = rect.offset_x / 2;
+	const int cy = rect.offset_y / 2;
+	const int cw = std::min((rect.offset_x + rect.width + 1) / 2, chromaWidth) - cx;
+	const int ch = std::min((rect.offset_y + rect.height + 1) / 2, chromaHeight) - cy;
+
+	// staged planes are tightly packed, the offsets act as pointers into the bound unpack buffer
+	absl::optional<PboUploadRing::Staged> staged = ring && _hasUnpackRowLength ? ring->claim(frame) : absl::nullopt;
+	if (staged) {
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, staged->pbo);
+		if (!rect.IsEmpty()) {
+			const uint8_t* base = nullptr;
+			uploadPlane(base + staged->yOffset, yTexture(), rect.offset_x, rect.offset_y, rect.width, rect.height, frame.width());
+			uploadPlane(base + staged->uOffset, uTexture(), cx, cy, cw, ch, chromaWidth);
+			uploadPlane(base + staged->vOffset, vTexture(), cx, cy, cw, ch, chromaWidth);
+		}
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		ring->fence(staged->slot);
+		return Upload::PIXEL_BUFFER;
+	}
+
+	if (rect.IsEmpty()) {
+		return Upload::SKIPPED;
+	}
+
+	rtc::scoped_refptr<webrtc::I420BufferInterface> buffer = vfb->ToI420();
 
-	uploadPlane(buffer->DataY(), yTexture(), buffer->width(), buffer->height(),  buffer->StrideY());
+	uploadPlane(buffer->DataY(), yTexture(), rect.offset_x, rect.offset_y, rect.width, rect.height, buffer->StrideY());
 
-	uploadPlane(buffer->DataU(), uTexture(), buffer->ChromaWidth(), buffer->ChromaHeight(), buffer->StrideU());
+	uploadPlane(buffer->DataU(), uTexture(), cx, cy, cw, ch, buffer->StrideU());
 
-	uploadPlane(buffer->DataV(), vTexture(), buffer->ChromaWidth(), buffer->ChromaHeight(), buffer->StrideV());
-}
\ No newline at end of file
+	uploadPlane(buffer->DataV(), vTexture(), cx, cy, cw, ch, buffer->StrideV());
+
+	return Upload::CLIENT_MEMORY;
+}
@@ -20,6 +20,8 @@ static const GLsizei kNumTextureSets = 2;
 static const GLsizei kNumTexturesPerSet = 3;
 static const GLsizei kNumTextures = kNumTexturesPerSet * kNumTextureSets;
 
+class PboUploadRing;
+
 class I420TextureCache 
 	: public std::enable_shared_from_this<I420TextureCache>
 {
@@ -31,7 +33,16 @@ public:
 public:
 	void init(); 
 
-	void uploadFrameToTextures(const webrtc::VideoFrame& frame);
+	enum class Upload {
+		SKIPPED,
+		CLIENT_MEMORY,
+		PIXEL_BUFFER
+	};
+
+	// Uploads |frame| unless it is the frame uploaded last time. |incremental| tells that |frame| directly
+	// follows the last uploaded one, so only its update_rect() has to be uploaded, in place.
+	// The planes are transferred from |ring| when the delivery thread staged the frame there
+	Upload uploadFrameToTextures(const webrtc::VideoFrame& frame, bool incremental = false, PboUploadRing* ring = nullptr);
 
 	GLuint yTexture();
 
@@ -42,16 +53,30 @@ public:
 protected:
 	void setupTextures();
 
-	void uploadPlane(const uint8_t* plane, GLuint texture, size_t width, size_t height, int32_t stride);
+	// (Re)allocates immutable storage for |set| when the resolution changes
+	void ensureStorage(GLint set, int width, int height);
+
+	void uploadPlane(const uint8_t* plane, GLuint texture, int x, int y, int width, int height, int32_t stride);
+
+	bool isSameFrame(const webrtc::VideoFrame& frame) const;
 
 private:
-	bool _hasUnpackRowLength;
+	bool _hasUnpackRowLength = false;
+	bool _hasTextureStorage = false;
 	GLint _currentTextureSet = 0;
 
 	// Handles for OpenGL constructs.
 	GLuint _textures[kNumTextures];
 
+	// Luma size each texture set is allocated for, 0 until allocated
+	int _setWidth[kNumTextureSets] = {};
+	int _setHeight[kNumTextureSets] = {};
+
+	// Identity of the frame in the current texture set
+	const webrtc::VideoFrameBuffer* _lastBuffer = nullptr;
+	int64_t _lastTimestampUs = 0;
+	uint16_t _lastId = 0;
+
 	// Used to create a non-padded plane for GPU upload when we receive padded frames.
 	std::vector<uint8_t> _planeBuffer;
 };
-
@@ -0,0 +1,165 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "nv12_texture_cache.h"
+#include <algorithm>
+#include "gl_defines.h"
+
+NV12TextureCache::NV12TextureCache()
+{
+
+}
+
+NV12TextureCache::~NV12TextureCache()
+{
+	glDeleteTextures(kNumNV12Textures, _textures);
+}
+
+void NV12TextureCache::init()
+{
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	_hasTextureStorage = GLEW_VERSION_4_2 || GLEW_ARB_texture_storage;
+
+	setupTextures();
+}
+
+GLuint NV12TextureCache::yTexture()
+{
+	return _textures[_currentTextureSet * kNumNV12TexturesPerSet];
+}
+
+GLuint NV12TextureCache::uvTexture()
+{
+	return _textures[_currentTextureSet * kNumNV12TexturesPerSet + 1];
+}
+
+void NV12TextureCache::setupTextures()
+{
+	glGenTextures(kNumNV12Textures, _textures);
+	// Set parameters for each of the textures we created.
+	for (GLsizei i = 0; i < kNumNV12Textures; i++) {
+		glBindTexture(GL_TEXTURE_2D, _textures[i]);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	}
+}
+
+void NV12TextureCache::ensureStorage(GLint set, int width, int height)
+{
+	if (_setWidth[set] == width && _setHeight[set] == height) {
+		return;
+	}
+
+	GLuint* textures = &_textures[set * kNumNV12TexturesPerSet];
+	if (_hasTextureStorage && _setWidth[set] != 0) {
+		// immutable storage can not be resized, start over with fresh texture objects
+		glDeleteTextures(kNumNV12TexturesPerSet, textures);
+		glGenTextures(kNumNV12TexturesPerSet, textures);
+	}
+
+	const GLsizei sizes[kNumNV12TexturesPerSet][2] = { { width, height }, { (width + 1) / 2, (height + 1) / 2 } };
+	const GLenum internalFormats[kNumNV12TexturesPerSet] = { GL_R8, GL_RG8 };
+	const GLenum formats[kNumNV12TexturesPerSet] = { GL_RED, GL_RG };
+	for (GLsizei i = 0; i < kNumNV12TexturesPerSet; i++) {
+		glBindTexture(GL_TEXTURE_2D, textures[i]);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		if (_hasTextureStorage) {
+			glTexStorage2D(GL_TEXTURE_2D, 1, internalFormats[i], sizes[i][0], sizes[i][1]);
+		}
+		else {
+			glTexImage2D(GL_TEXTURE_2D, 0, internalFormats[i], sizes[i][0], sizes[i][1], 0, formats[i], GL_UNSIGNED_BYTE, nullptr);
+		}
+	}
+
+	_setWidth[set] = width;
+	_setHeight[set] = height;
+}
+
+void NV12TextureCache::uploadPlane(const uint8_t* plane, GLuint texture, GLenum format, int bytesPerPixel, int x, int y, int width, int height, int32_t stride)
+{
+	glBindTexture(GL_TEXTURE_2D, texture);
+
+	const uint8_t* uploadPlane = plane + static_cast<size_t>(y) * stride + static_cast<size_t>(x) * bytesPerPixel;
+
+	// GL_UNPACK_ROW_LENGTH counts pixels, not bytes
+	const int32_t rowLength = stride / bytesPerPixel;
+	if (rowLength != width) {
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength);
+	}
+	glTexSubImage2D(GL_TEXTURE_2D,
+		0,
+		x,
+		y,
+		static_cast<GLsizei>(width),
+		static_cast<GLsizei>(height),
+		format,
+		GL_UNSIGNED_BYTE,
+		uploadPlane);
+	if (rowLength != width) {
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	}
+}
+
+bool NV12TextureCache::isSameFrame(const webrtc::VideoFrame& frame) const
+{
+	// the buffer pointer alone is not enough, decoders recycle their buffers through a pool
+	return _lastBuffer == frame.video_frame_buffer().get() &&
+		_lastTimestampUs == frame.timestamp_us() &&
+		_lastId == frame.id();
+}
+
+bool NV12TextureCache::uploadFrameToTextures(const webrtc::VideoFrame& frame, bool incremental)
+{
+	rtc::scoped_refptr<webrtc::VideoFrameBuffer> vfb = frame.video_frame_buffer();
+	if (!vfb || vfb->type() != webrtc::VideoFrameBuffer::Type::kNV12) {
+		return false;
+	}
+
+	if (isSameFrame(frame)) {
+		return false;
+	}
+
+	const bool sameSize = _setWidth[_currentTextureSet] == frame.width() && _setHeight[_currentTextureSet] == frame.height();
+	const bool partial = incremental && sameSize && _lastBuffer && frame.has_update_rect();
+
+	webrtc::VideoFrame::UpdateRect rect{ 0, 0, frame.width(), frame.height() };
+	if (partial) {
+		// the current set holds the previous frame, patch it in place
+		rect = frame.update_rect();
+	}
+	else {
+		_currentTextureSet = (_currentTextureSet + 1) % kNumNV12TextureSets;
+		ensureStorage(_currentTextureSet, frame.width(), frame.height());
+	}
+
+	_lastBuffer = vfb.get();
+	_lastTimestampUs = frame.timestamp_us();
+	_lastId = frame.id();
+
+	if (rect.IsEmpty()) {
+		return false;
+	}
+
+	const webrtc::NV12BufferInterface* buffer = vfb->GetNV12();
+
+	uploadPlane(buffer->DataY(), yTexture(), GL_RED, 1, rect.offset_x, rect.offset_y, rect.width, rect.height, buffer->StrideY());
+
+	// one UV pair per 2x2 luma block, widen the rect to whole chroma samples
+	const int cx = rect.offset_x / 2;
+	const int cy = rect.offset_y / 2;
+	const int cw = std::min((rect.offset_x + rect.width + 1) / 2, buffer->ChromaWidth()) - cx;
+	const int ch = std::min((rect.offset_y + rect.height + 1) / 2, buffer->ChromaHeight()) - cy;
+
+	uploadPlane(buffer->DataUV(), uvTexture(), GL_RG, 2, cx, cy, cw, ch, buffer->StrideUV());
+
+	return true;
+}
@@ -0,0 +1,67 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include "gl_defines.h"
+#include <memory>
+#include <vector>
+#include "api/video/nv12_buffer.h"
+#include "api/video/video_frame.h"
+#include <stdint.h>
+
+// Same double buffering as I420TextureCache, with one R8 texture for the Y plane and one RG8 texture
+// for the interleaved UV plane, so NV12 buffers from decoders and capturers are uploaded as they are.
+static const GLsizei kNumNV12TextureSets = 2;
+static const GLsizei kNumNV12TexturesPerSet = 2;
+static const GLsizei kNumNV12Textures = kNumNV12TexturesPerSet * kNumNV12TextureSets;
+
+class NV12TextureCache
+	: public std::enable_shared_from_this<NV12TextureCache>
+{
+public:
+	NV12TextureCache();
+
+	~NV12TextureCache();
+
+public:
+	void init();
+
+	// Uploads |frame|, which must carry a kNV12 buffer, unless it is the frame uploaded last time.
+	// |incremental| tells that |frame| directly follows the last uploaded one, so only its update_rect()
+	// has to be uploaded, in place. Returns false if nothing was uploaded
+	bool uploadFrameToTextures(const webrtc::VideoFrame& frame, bool incremental = false);
+
+	GLuint yTexture();
+
+	GLuint uvTexture();
+
+protected:
+	void setupTextures();
+
+	// (Re)allocates immutable storage for |set| when the resolution changes
+	void ensureStorage(GLint set, int width, int height);
+
+	void uploadPlane(const uint8_t* plane, GLuint texture, GLenum format, int bytesPerPixel, int x, int y, int width, int height, int32_t stride);
+
+	bool isSameFrame(const webrtc::VideoFrame& frame) const;
+
+private:
+	bool _hasTextureStorage = false;
+	GLint _currentTextureSet = 0;
+
+	// Handles for OpenGL constructs.
+	GLuint _textures[kNumNV12Textures];
+
+	// Luma size each texture set is allocated for, 0 until allocated
+	int _setWidth[kNumNV12TextureSets] = {};
+	int _setHeight[kNumNV12TextureSets] = {};
+
+	// Identity of the frame in the current texture set
+	const webrtc::VideoFrameBuffer* _lastBuffer = nullptr;
+	int64_t _lastTimestampUs = 0;
+	uint16_t _lastId = 0;
+};
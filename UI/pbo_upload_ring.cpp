@@ -0,0 +1,243 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "pbo_upload_ring.h"
+#include <thread>
+#include "libyuv/convert.h"
+
+bool PboUploadRing::isSupported()
+{
+	return GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+}
+
+size_t PboUploadRing::bytesFor(int width, int height)
+{
+	const size_t chroma = static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+	return static_cast<size_t>(width) * height + chroma * 2;
+}
+
+PboUploadRing::PboUploadRing(size_t slotBytes)
+	: _slotBytes(slotBytes)
+{
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	for (auto& slot : _slots) {
+		glGenBuffers(1, &slot.pbo);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+		glBufferStorage(GL_PIXEL_UNPACK_BUFFER, _slotBytes, nullptr, flags);
+		slot.memory = static_cast<uint8_t*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, _slotBytes, flags));
+		if (!slot.memory) {
+			slot.state.store(DEAD, std::memory_order_relaxed);
+		}
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+PboUploadRing::~PboUploadRing()
+{
+	for (auto& slot : _slots) {
+		if (slot.fence) {
+			glDeleteSync(slot.fence);
+		}
+		if (slot.memory) {
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		}
+		glDeleteBuffers(1, &slot.pbo);
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+bool PboUploadRing::stage(const webrtc::VideoFrame& frame, const webrtc::I420BufferInterface& buffer)
+{
+	if (bytesFor(buffer.width(), buffer.height()) > _slotBytes) {
+		return false;
+	}
+
+	// a free slot first, otherwise one holding a frame that has not been claimed yet, it is older than this one
+	Slot* target = nullptr;
+	for (uint32_t wanted : { FREE, READY }) {
+		for (auto& slot : _slots) {
+			uint32_t expected = wanted;
+			if (slot.state.compare_exchange_strong(expected, WRITING, std::memory_order_acquire, std::memory_order_relaxed)) {
+				target = &slot;
+				break;
+			}
+		}
+		if (target) {
+			break;
+		}
+	}
+	if (!target) {
+		return false;
+	}
+
+	const int width = buffer.width();
+	const int height = buffer.height();
+	const int chromaWidth = (width + 1) / 2;
+	const size_t ySize = static_cast<size_t>(width) * height;
+	const size_t chromaSize = static_cast<size_t>(chromaWidth) * ((height + 1) / 2);
+	uint8_t* y = target->memory;
+	uint8_t* u = y + ySize;
+	uint8_t* v = u + chromaSize;
+	libyuv::I420Copy(buffer.DataY(), buffer.StrideY(),
+		buffer.DataU(), buffer.StrideU(),
+		buffer.DataV(), buffer.StrideV(),
+		y, width,
+		u, chromaWidth,
+		v, chromaWidth,
+		width, height);
+
+	target->buffer = frame.video_frame_buffer().get();
+	target->timestampUs = frame.timestamp_us();
+	target->id = frame.id();
+	target->width = width;
+	target->height = height;
+	target->state.store(READY, std::memory_order_release);
+
+	return true;
+}
+
+absl::optional<PboUploadRing::Staged> PboUploadRing::claim(const webrtc::VideoFrame& frame)
+{
+	for (int i = 0; i < kNumSlots; ++i) {
+		Slot& slot = _slots[i];
+		uint32_t expected = READY;
+		if (!slot.state.compare_exchange_strong(expected, IN_FLIGHT, std::memory_order_acquire, std::memory_order_relaxed)) {
+			continue;
+		}
+		if (slot.buffer != frame.video_frame_buffer().get() || slot.timestampUs != frame.timestamp_us() || slot.id != frame.id() ||
+			slot.width != frame.width() || slot.height != frame.height()) {
+			// staged for another frame, most likely a newer one still in the mailbox
+			slot.state.store(READY, std::memory_order_release);
+			continue;
+		}
+
+		Staged staged;
+		staged.pbo = slot.pbo;
+		staged.slot = i;
+		staged.yOffset = 0;
+		staged.uOffset = static_cast<size_t>(slot.width) * slot.height;
+		staged.vOffset = staged.uOffset + static_cast<size_t>((slot.width + 1) / 2) * ((slot.height + 1) / 2);
+		return staged;
+	}
+	return absl::nullopt;
+}
+
+void PboUploadRing::fence(int slot)
+{
+	if (slot < 0 || slot >= kNumSlots) {
+		return;
+	}
+	_slots[slot].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void PboUploadRing::reclaim()
+{
+	for (auto& slot : _slots) {
+		if (slot.state.load(std::memory_order_relaxed) != IN_FLIGHT || !slot.fence) {
+			continue;
+		}
+		const GLenum result = glClientWaitSync(slot.fence, 0, 0);
+		if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+			glDeleteSync(slot.fence);
+			slot.fence = nullptr;
+			slot.state.store(FREE, std::memory_order_release);
+		}
+	}
+}
+
+void PboUploadRing::shutdown()
+{
+	for (auto& slot : _slots) {
+		uint32_t state = slot.state.load(std::memory_order_relaxed);
+		while (state != DEAD) {
+			if (state == WRITING) {
+				std::this_thread::yield();
+				state = slot.state.load(std::memory_order_relaxed);
+				continue;
+			}
+			slot.state.compare_exchange_weak(state, DEAD, std::memory_order_acquire, std::memory_order_relaxed);
+		}
+	}
+}
+
+void PboUploadStager::stage(const webrtc::VideoFrame& frame)
+{
+	if (auto ring = currentRing()) {
+		auto vfb = frame.video_frame_buffer();
+		if (vfb && vfb->type() != webrtc::VideoFrameBuffer::Type::kNV12) {
+			if (auto buffer = vfb->ToI420()) {
+				ring->stage(frame, *buffer);
+			}
+		}
+	}
+}
+
+PboUploadRing* PboUploadStager::ring(int width, int height)
+{
+	if (!_checked) {
+		_checked = true;
+		_supported = PboUploadRing::isSupported();
+	}
+	if (!_supported) {
+		return nullptr;
+	}
+
+	if (!_retiredRings.empty()) {
+		destroyRetiredRings(false);
+	}
+
+	const size_t bytes = PboUploadRing::bytesFor(width, height);
+	if (!_ring || _ring->slotBytes() < bytes) {
+		retire();
+		swapRing(std::make_shared<PboUploadRing>(bytes));
+	}
+	return _ring.get();
+}
+
+void PboUploadStager::release()
+{
+	retire();
+	destroyRetiredRings(true);
+}
+
+std::shared_ptr<PboUploadRing> PboUploadStager::currentRing() const
+{
+	std::lock_guard<std::mutex> lock(_ringMutex);
+	return _ring;
+}
+
+std::shared_ptr<PboUploadRing> PboUploadStager::swapRing(std::shared_ptr<PboUploadRing> next)
+{
+	std::lock_guard<std::mutex> lock(_ringMutex);
+	_ring.swap(next);
+	return next;
+}
+
+void PboUploadStager::retire()
+{
+	if (auto ring = swapRing(nullptr)) {
+		ring->shutdown();
+		_retiredRings.emplace_back(std::move(ring));
+	}
+	destroyRetiredRings(false);
+}
+
+void PboUploadStager::destroyRetiredRings(bool wait)
+{
+	for (auto it = _retiredRings.begin(); it != _retiredRings.end();) {
+		// after shutdown() the delivery thread only holds a ring for the instant stage() takes to fail
+		while (wait && it->use_count() > 1) {
+			std::this_thread::yield();
+		}
+		if (it->use_count() == 1) {
+			it = _retiredRings.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
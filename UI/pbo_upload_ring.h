@@ -0,0 +1,142 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include "gl_defines.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+#include "absl/types/optional.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame.h"
+
+// Persistently mapped pixel unpack buffers the frame delivery thread copies I420 planes into, so the GUI
+// thread only issues PBO -> texture transfers. Each slot holds one tightly packed frame (Y, then U, then V)
+// and moves FREE -> WRITING (delivery thread) -> READY -> IN_FLIGHT (GL thread) -> FREE once the fence of
+// its transfer has signaled. A READY slot whose frame was superseded is simply reused by the next stage().
+// Created, fenced, reclaimed and destroyed with the GL context current; needs GL 4.4 or ARB_buffer_storage.
+class PboUploadRing
+{
+public:
+	static constexpr int kNumSlots = 4;
+
+	struct Staged {
+		GLuint pbo = 0;
+		int slot = -1;
+		size_t yOffset = 0;
+		size_t uOffset = 0;
+		size_t vOffset = 0;
+	};
+
+	static bool isSupported();
+
+	static size_t bytesFor(int width, int height);
+
+	explicit PboUploadRing(size_t slotBytes);
+
+	~PboUploadRing();
+
+	size_t slotBytes() const { return _slotBytes; }
+
+	// Delivery thread, copies |buffer| into a free slot tagged with the identity of |frame|
+	bool stage(const webrtc::VideoFrame& frame, const webrtc::I420BufferInterface& buffer);
+
+	// GL thread, the slot staged for |frame| if it is still there
+	absl::optional<Staged> claim(const webrtc::VideoFrame& frame);
+
+	// GL thread, once the transfers out of |slot| are issued
+	void fence(int slot);
+
+	// GL thread, hands back the slots whose transfers have completed
+	void reclaim();
+
+	// GL thread, waits for the delivery thread to leave the ring, no stage() succeeds afterwards
+	void shutdown();
+
+private:
+	enum State : uint32_t {
+		FREE = 0,
+		WRITING,
+		READY,
+		IN_FLIGHT,
+		DEAD
+	};
+
+	struct Slot {
+		std::atomic<uint32_t> state{ FREE };
+		GLuint pbo = 0;
+		uint8_t* memory = nullptr;
+		GLsync fence = nullptr;
+
+		// identity of the staged frame, written in WRITING and read after READY
+		const webrtc::VideoFrameBuffer* buffer = nullptr;
+		int64_t timestampUs = 0;
+		uint16_t id = 0;
+		int width = 0;
+		int height = 0;
+	};
+
+	PboUploadRing(const PboUploadRing&) = delete;
+
+	PboUploadRing& operator=(const PboUploadRing&) = delete;
+
+private:
+	const size_t _slotBytes;
+
+	Slot _slots[kNumSlots];
+};
+
+// The ring a frame sink stages into. The delivery thread only ever sees the current ring, the GL thread
+// replaces it when frames outgrow it and destroys replaced rings once the delivery thread has let go of them.
+class PboUploadStager
+{
+public:
+	PboUploadStager() = default;
+
+	// Delivery thread, copies I420 frames into the current ring, if any. NV12 buffers are uploaded as they
+	// are, staging them would mean converting them here
+	void stage(const webrtc::VideoFrame& frame);
+
+	// GL thread, a ring with room for |width| x |height| frames, nullptr without pixel buffer support.
+	// Frames of a new size are staged once the delivery thread sees the new ring
+	PboUploadRing* ring(int width, int height);
+
+	// GL thread with the context current, nothing is staged afterwards until ring() is called again
+	void release();
+
+private:
+	// Delivery thread, a reference to the current ring taken under |_ringMutex|
+	std::shared_ptr<PboUploadRing> currentRing() const;
+
+	// GL thread, makes |next| the current ring and returns the one it replaced
+	std::shared_ptr<PboUploadRing> swapRing(std::shared_ptr<PboUploadRing> next);
+
+	void retire();
+
+	void destroyRetiredRings(bool wait);
+
+	PboUploadStager(const PboUploadStager&) = delete;
+
+	PboUploadStager& operator=(const PboUploadStager&) = delete;
+
+private:
+	// checked with the context current, on the first ring()
+	bool _checked = false;
+
+	bool _supported = false;
+
+	// only held to copy or swap |_ring|, once per frame on the delivery thread and once per ring on the GL thread
+	mutable std::mutex _ringMutex;
+
+	// replaced by the GL thread only, which reads it without the lock
+	std::shared_ptr<PboUploadRing> _ring;
+
+	// rings replaced while the delivery thread may still hold them, their GL objects go away on the GL thread
+	std::vector<std::shared_ptr<PboUploadRing>> _retiredRings;
+};
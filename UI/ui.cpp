@@ -79,6 +79,7 @@ void UI::init()
 
 	_galleryView = new GalleryView(this);
 	setCentralWidget(_galleryView);
+	connect(_galleryView, &GalleryView::tileSizeChanged, this, &UI::onTileSizeChanged);
 
 
     QWidget* dockContentView = new QWidget(this);
@@ -216,6 +217,13 @@ void UI::onRemoveParticipant(std::shared_ptr<vi::Participant> participant)
 	}
 }
 
+void UI::onTileSizeChanged(qint64 id, int width, int height, bool visible)
+{
+	if (_vrc) {
+		_vrc->mediaContrller()->setRemoteVideoSize(id, width, height, visible);
+	}
+}
+
 void UI::onCreateVideoTrack(uint64_t pid, rtc::scoped_refptr<webrtc::VideoTrackInterface> track)
 {
 	if (!track) {
@@ -223,11 +231,9 @@ void UI::onCreateVideoTrack(uint64_t pid, rtc::scoped_refptr<webrtc::VideoTrackI
 	}
 	if (track->kind() == webrtc::MediaStreamTrackInterface::kVideoKind) {
         //if (_vrc->getId() != pid) {
-			GLVideoRenderer* renderer = new GLVideoRenderer(_galleryView);
-            renderer->init();
-            renderer->show();
+			auto tile = std::make_shared<VideoTile>(pid);
 
-            std::shared_ptr<ContentView> view = std::make_shared<ContentView>(pid, track, renderer);
+            std::shared_ptr<ContentView> view = std::make_shared<ContentView>(pid, track, tile);
             view->init();
 
             _galleryView->insertView(view);
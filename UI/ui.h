@@ -78,6 +78,10 @@ private slots:
 
 	void onRemoveParticipant(std::shared_ptr<vi::Participant> participant);
 
+	// GalleryView
+
+	void onTileSizeChanged(qint64 id, int width, int height, bool visible);
+
 private slots:
 
 	void closeEvent(QCloseEvent* event);
@@ -0,0 +1,32 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "upload_meter.h"
+
+void UploadMeter::record(int64_t elapsedUs, bool pixelBuffer)
+{
+	_uploads.fetch_add(1, std::memory_order_relaxed);
+	if (pixelBuffer) {
+		_pixelBufferUploads.fetch_add(1, std::memory_order_relaxed);
+	}
+	_totalUs.fetch_add(elapsedUs, std::memory_order_relaxed);
+	_lastUs.store(elapsedUs, std::memory_order_relaxed);
+	// single writer, a plain compare is enough
+	if (elapsedUs > _maxUs.load(std::memory_order_relaxed)) {
+		_maxUs.store(elapsedUs, std::memory_order_relaxed);
+	}
+}
+
+UploadStats UploadMeter::stats() const
+{
+	UploadStats stats;
+	stats.uploads = _uploads.load(std::memory_order_relaxed);
+	stats.pixelBufferUploads = _pixelBufferUploads.load(std::memory_order_relaxed);
+	stats.lastUs = _lastUs.load(std::memory_order_relaxed);
+	stats.maxUs = _maxUs.load(std::memory_order_relaxed);
+	stats.averageUs = stats.uploads > 0 ? _totalUs.load(std::memory_order_relaxed) / static_cast<int64_t>(stats.uploads) : 0;
+	return stats;
+}
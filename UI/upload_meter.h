@@ -0,0 +1,45 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+// Texture upload cost of one video sink, measured on the GUI thread around the GL upload calls
+struct UploadStats {
+	uint64_t uploads = 0;
+
+	// uploads transferred from a pixel buffer staged by the frame delivery thread
+	uint64_t pixelBufferUploads = 0;
+
+	int64_t lastUs = 0;
+
+	int64_t maxUs = 0;
+
+	int64_t averageUs = 0;
+};
+
+// Written by the GL thread, read from any thread
+class UploadMeter
+{
+public:
+	// an upload that transferred something, |pixelBuffer| if it came from a staged pixel buffer
+	void record(int64_t elapsedUs, bool pixelBuffer);
+
+	UploadStats stats() const;
+
+private:
+	std::atomic<uint64_t> _uploads{ 0 };
+
+	std::atomic<uint64_t> _pixelBufferUploads{ 0 };
+
+	std::atomic<int64_t> _totalUs{ 0 };
+
+	std::atomic<int64_t> _lastUs{ 0 };
+
+	std::atomic<int64_t> _maxUs{ 0 };
+};
@@ -0,0 +1,136 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#include "video_tile.h"
+#include "gl_defines.h"
+#include "frame_clock.h"
+#include "gl_video_shader.h"
+#include "i420_texture_cache.h"
+#include "nv12_texture_cache.h"
+#include "rtc_base/time_utils.h"
+
+VideoTile::VideoTile(int64_t id)
+	: _id(id)
+{
+
+}
+
+VideoTile::~VideoTile()
+{
+
+}
+
+int64_t VideoTile::id() const
+{
+	return _id;
+}
+
+bool VideoTile::pending() const
+{
+	return _mailbox.pending();
+}
+
+void VideoTile::OnFrame(const webrtc::VideoFrame& frame)
+{
+	// copy the planes into a pixel buffer here, on the delivery thread, so paint only issues the transfer
+	_uploadStager.stage(frame);
+
+	_mailbox.post(frame);
+
+	FrameClock::instance()->requestFrame();
+}
+
+void VideoTile::paint(GLVideoShader* shader, int x, int y, int width, int height)
+{
+	_mailbox.take();
+
+	const absl::optional<webrtc::VideoFrame>& frame = _mailbox.front();
+	if (!frame || !shader || width <= 0 || height <= 0) {
+		return;
+	}
+
+	if (!_i420TextureCache) {
+		_i420TextureCache = std::make_shared<I420TextureCache>();
+		_i420TextureCache->init();
+
+		_nv12TextureCache = std::make_shared<NV12TextureCache>();
+		_nv12TextureCache->init();
+	}
+
+	float imageRatio = (float)frame->width() / (float)frame->height();
+	float cellRatio = (float)width / (float)height;
+
+	int32_t viewportW = width;
+	int32_t viewportH = height;
+	if (cellRatio >= imageRatio) {
+		viewportW = viewportH * imageRatio;
+	}
+	else {
+		viewportH = viewportW / imageRatio;
+	}
+	glViewport(x + (width - viewportW) / 2, y + (height - viewportH) / 2, viewportW, viewportH);
+
+	const bool nv12 = frame->video_frame_buffer()->type() == webrtc::VideoFrameBuffer::Type::kNV12;
+
+	// an update rect is relative to the previous frame, which then has to be in the same cache
+	const bool incremental = _mailbox.contiguous() && nv12 == _nv12Frames;
+	_nv12Frames = nv12;
+
+	// a repaint without a new frame finds the frame in the cache already and uploads nothing
+	const int64_t start = rtc::TimeMicros();
+	I420TextureCache::Upload upload = I420TextureCache::Upload::SKIPPED;
+	if (nv12) {
+		if (_nv12TextureCache->uploadFrameToTextures(*frame, incremental)) {
+			upload = I420TextureCache::Upload::CLIENT_MEMORY;
+		}
+	}
+	else {
+		PboUploadRing* ring = _uploadStager.ring(frame->width(), frame->height());
+		upload = _i420TextureCache->uploadFrameToTextures(*frame, incremental, ring);
+	}
+	if (upload != I420TextureCache::Upload::SKIPPED) {
+		_uploadMeter.record(rtc::TimeMicros() - start, upload == I420TextureCache::Upload::PIXEL_BUFFER);
+	}
+
+	if (nv12) {
+		shader->applyShadingForFrame(frame->width(),
+			frame->height(),
+			frame->rotation(),
+			_nv12TextureCache->yTexture(),
+			_nv12TextureCache->uvTexture());
+	}
+	else {
+		shader->applyShadingForFrame(frame->width(),
+			frame->height(),
+			frame->rotation(),
+			_i420TextureCache->yTexture(),
+			_i420TextureCache->uTexture(),
+			_i420TextureCache->vTexture());
+	}
+}
+
+void VideoTile::releaseTextures()
+{
+	_uploadStager.release();
+	_i420TextureCache = nullptr;
+	_nv12TextureCache = nullptr;
+	_mailbox.clear();
+}
+
+uint64_t VideoTile::droppedFrames() const
+{
+	return _mailbox.droppedFrames();
+}
+
+uint64_t VideoTile::presentedFrames() const
+{
+	return _mailbox.presentedFrames();
+}
+
+UploadStats VideoTile::uploadStats() const
+{
+	return _uploadMeter.stats();
+}
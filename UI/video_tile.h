@@ -0,0 +1,70 @@
+/**
+ * This file is part of janus_client project.
+ * Author:    Jackie Ou
+ * Created:   2026-10-17
+ **/
+
+#pragma once
+
+#include <memory>
+#include <stdint.h>
+#include "api/video/video_sink_interface.h"
+#include "api/video/video_frame.h"
+#include "frame_mailbox.h"
+#include "pbo_upload_ring.h"
+#include "upload_meter.h"
+
+class GLVideoShader;
+class I420TextureCache;
+class NV12TextureCache;
+
+// One participant of the gallery. The delivery thread drops frames into the mailbox and stages their
+// planes in pixel buffers, the textures live in the GalleryCompositor context and are only touched from its paintGL.
+class VideoTile : public rtc::VideoSinkInterface<webrtc::VideoFrame>
+{
+public:
+	explicit VideoTile(int64_t id);
+
+	~VideoTile() override;
+
+	int64_t id() const;
+
+	// true if a frame arrived since the last paint
+	bool pending() const;
+
+	// GL thread, draws the newest frame aspect-fit into the cell (device pixels, GL origin bottom left)
+	void paint(GLVideoShader* shader, int x, int y, int width, int height);
+
+	// GL thread, must be called with the compositor context current before the tile goes away
+	void releaseTextures();
+
+	uint64_t droppedFrames() const;
+
+	uint64_t presentedFrames() const;
+
+	UploadStats uploadStats() const;
+
+protected:
+	void OnFrame(const webrtc::VideoFrame& frame) override;
+
+private:
+	VideoTile(const VideoTile&) = delete;
+
+	VideoTile& operator=(const VideoTile&) = delete;
+
+private:
+	const int64_t _id;
+
+	FrameMailbox _mailbox;
+
+	PboUploadStager _uploadStager;
+
+	UploadMeter _uploadMeter;
+
+	std::shared_ptr<I420TextureCache> _i420TextureCache;
+
+	std::shared_ptr<NV12TextureCache> _nv12TextureCache;
+
+	// whether the last painted frame went through the NV12 cache
+	bool _nv12Frames = false;
+};